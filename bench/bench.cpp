@@ -0,0 +1,350 @@
+/** \file bench.cpp
+ *  \brief Rendering benchmark suite of the Sista library.
+ *
+ *  Runs reproducible workloads (fixed seeds and sizes) and prints one JSON document with
+ *  the time per operation, the bytes per frame and the heap allocations per frame of each.
+ *  Frames are written to a counting in-memory sink, or to `/dev/null` with `--dev-null`.
+ *
+ *  Usage: `sista-bench [--filter SUBSTRING] [--min-time SECONDS] [--dev-null]`
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <functional>
+#include "../include/sista/sista.hpp"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+static std::size_t allocations = 0; // Heap allocations since the start of the program
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+/** \class CountingSink
+ *  \brief Buffers the frames, counts their bytes and optionally writes them to a file descriptor.
+*/
+class CountingSink : public std::streambuf {
+private:
+    char buffer[1 << 16];
+    std::size_t bytes = 0;
+    int descriptor;
+
+    void drain() {
+        std::size_t length = pptr() - pbase();
+        bytes += length;
+#if !defined(_WIN32)
+        for (std::size_t written = 0; descriptor >= 0 && written < length;) {
+            ssize_t n = write(descriptor, pbase() + written, length - written);
+            if (n <= 0)
+                break;
+            written += n;
+        }
+#endif
+        setp(buffer, buffer + sizeof(buffer));
+    }
+
+protected:
+    int_type overflow(int_type character) override {
+        drain();
+        if (!traits_type::eq_int_type(character, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+    int sync() override {
+        drain();
+        return 0;
+    }
+
+public:
+    explicit CountingSink(int descriptor_) : descriptor(descriptor_) {
+        setp(buffer, buffer + sizeof(buffer));
+    }
+    std::size_t count() {
+        drain();
+        return bytes;
+    }
+};
+
+struct Options {
+    std::string filter;
+    double minTime = 0.25;
+    bool devNull = false;
+};
+
+struct Result {
+    std::string name;
+    std::size_t frames;
+    std::size_t opsPerFrame;
+    double nsPerOp;
+    double nsPerFrame;
+    double bytesPerFrame;
+    double allocsPerFrame;
+};
+
+static Options options;
+static std::vector<Result> results;
+static CountingSink* sink;
+
+/** \brief Runs `frame` until the minimum time elapsed and records the averages.
+ *  \param name Name of the workload.
+ *  \param opsPerFrame Operations performed by one call to `frame`.
+ *  \param frame Renders one frame.
+*/
+static void measure(const std::string& name, std::size_t opsPerFrame, const std::function<void()>& frame) {
+    using clock = std::chrono::steady_clock;
+    frame(); // Warm-up, also fills the caches of the library
+    std::size_t bytesBefore = sink->count();
+    std::size_t allocationsBefore = allocations;
+    std::size_t frames = 0;
+    clock::duration elapsed(0);
+    auto budget = std::chrono::duration<double>(options.minTime);
+    while (frames < 3 || elapsed < budget) {
+        auto start = clock::now();
+        frame();
+        elapsed += clock::now() - start;
+        frames++;
+    }
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    results.push_back({
+        name, frames, opsPerFrame,
+        ns / (frames * opsPerFrame), ns / frames,
+        static_cast<double>(sink->count() - bytesBefore) / frames,
+        static_cast<double>(allocations - allocationsBefore) / frames
+    });
+}
+
+static bool selected(const std::string& name) {
+    return name.find(options.filter) != std::string::npos;
+}
+
+/** \brief Fills a field with pawns at the given density, in a reproducible order. */
+static std::vector<sista::Pawn*> populate(sista::Field& field, int width, int height, double density, bool styled, unsigned seed) {
+    std::mt19937 random(seed);
+    std::bernoulli_distribution occupied(density);
+    std::vector<sista::Pawn*> pawns;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!occupied(random))
+                continue;
+            sista::ANSISettings settings;
+            if (styled) {
+                settings = sista::ANSISettings(
+                    sista::RGBColor(random() % 256, random() % 256, random() % 256),
+                    sista::RGBColor(random() % 256, random() % 256, random() % 256),
+                    {sista::Attribute::BRIGHT, static_cast<sista::Attribute>(3 + random() % 3)}
+                );
+            }
+            auto pawn = std::make_shared<sista::Pawn>('A' + (x + y) % 26, sista::Coordinates(y, x), settings);
+            field.addPawn(pawn);
+            pawns.push_back(pawn.get());
+        }
+    }
+    return pawns;
+}
+
+static void benchPrint() {
+    const int sizes[][2] = {{20, 10}, {80, 24}, {200, 60}};
+    const double densities[] = {0.0, 0.25, 1.0};
+    for (auto& size : sizes) {
+        for (double density : densities) {
+            std::ostringstream name;
+            name << "print/" << size[0] << "x" << size[1] << "/density=" << density;
+            if (!selected(name.str()))
+                continue;
+            sista::Field field(size[0], size[1]);
+            populate(field, size[0], size[1], density, false, 1);
+            measure(name.str(), 1, [&] {
+                sista::getOutputStream() << TL;
+                field.print('#');
+            });
+        }
+    }
+}
+
+static void benchStyledPrint() {
+    const int sizes[][2] = {{80, 24}, {200, 60}};
+    for (auto& size : sizes) {
+        std::string name = "print-styled/" + std::to_string(size[0]) + "x" + std::to_string(size[1]);
+        if (!selected(name))
+            continue;
+        sista::Field field(size[0], size[1]);
+        populate(field, size[0], size[1], 1.0, true, 2);
+        measure(name, 1, [&] {
+            sista::getOutputStream() << TL;
+            field.print('#');
+        });
+    }
+}
+
+static void benchBorderPrint() {
+    const int sizes[][2] = {{80, 24}, {200, 60}};
+    sista::Border border('@', sista::ANSISettings(
+        sista::ForegroundColor::YELLOW, sista::BackgroundColor::BLUE, sista::Attribute::BRIGHT
+    ));
+    for (auto& size : sizes) {
+        std::string name = "print-border/" + std::to_string(size[0]) + "x" + std::to_string(size[1]);
+        if (!selected(name))
+            continue;
+        sista::Field field(size[0], size[1]);
+        populate(field, size[0], size[1], 0.25, false, 3);
+        measure(name, 1, [&] {
+            sista::getOutputStream() << TL;
+            field.print(border);
+        });
+    }
+}
+
+static void benchMoveStorm() {
+    const int sizes[][2] = {{80, 24}, {200, 60}};
+    const std::size_t moves = 1000;
+    for (auto& size : sizes) {
+        std::string name = "movePawn-storm/" + std::to_string(size[0]) + "x" + std::to_string(size[1]);
+        if (!selected(name))
+            continue;
+        const int width = size[0], height = size[1];
+        sista::Field field(width, height);
+        std::vector<sista::Pawn*> pawns = populate(field, width, height, 0.25, true, 4);
+        std::mt19937 random(5);
+        measure(name, moves, [&] {
+            for (std::size_t i = 0; i < moves; i++) {
+                sista::Pawn* pawn = pawns[random() % pawns.size()];
+                sista::Coordinates target = pawn->getCoordinates();
+                target.y = (target.y + height + random() % 3 - 1) % height;
+                target.x = (target.x + width + random() % 3 - 1) % width;
+                if (field.isFree(target))
+                    field.movePawn(pawn, target);
+            }
+        });
+    }
+}
+
+static void benchSwaps() {
+    const int width = 200;
+    const std::size_t counts[] = {1000, 10000, 100000};
+    for (std::size_t count : counts) {
+        std::string name = "applySwaps/" + std::to_string(count);
+        if (!selected(name))
+            continue;
+        // Pawns on the even columns step right, then back left: no conflicts, every path is applied
+        const int height = static_cast<int>(count / (width / 2));
+        sista::SwappableField field(width, height);
+        std::vector<sista::Pawn*> pawns;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x += 2) {
+                auto pawn = std::make_shared<sista::Pawn>('S', sista::Coordinates(y, x), sista::ANSISettings());
+                field.addPawn(pawn);
+                pawns.push_back(pawn.get());
+            }
+        }
+        int direction = 1;
+        measure(name, count, [&] {
+            for (sista::Pawn* pawn : pawns) {
+                sista::Coordinates target = pawn->getCoordinates();
+                target.x += direction;
+                field.addPawnToSwap(pawn, target);
+            }
+            field.applySwaps();
+            direction = -direction;
+        });
+    }
+}
+
+static void printResults() {
+    std::cout << "{\n";
+    std::cout << "  \"library\": \"sista\",\n";
+    std::cout << "  \"version\": \"" << sista::getVersion() << "\",\n";
+    std::cout << "  \"sink\": \"" << (options.devNull ? "/dev/null" : "memory") << "\",\n";
+    std::cout << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        std::cout << (i ? "," : "") << "\n    {"
+                  << "\"name\": \"" << result.name << "\", "
+                  << "\"frames\": " << result.frames << ", "
+                  << "\"ops_per_frame\": " << result.opsPerFrame << ", "
+                  << "\"ns_per_op\": " << result.nsPerOp << ", "
+                  << "\"ns_per_frame\": " << result.nsPerFrame << ", "
+                  << "\"bytes_per_frame\": " << result.bytesPerFrame << ", "
+                  << "\"allocs_per_frame\": " << result.allocsPerFrame << "}";
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+}
+
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            options.minTime = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--dev-null")) {
+            options.devNull = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter SUBSTRING] [--min-time SECONDS] [--dev-null]" << std::endl;
+            return 2;
+        }
+    }
+
+    int descriptor = -1;
+#if !defined(_WIN32)
+    if (options.devNull && (descriptor = open("/dev/null", O_WRONLY)) < 0) {
+        std::cerr << "Cannot open /dev/null" << std::endl;
+        return 1;
+    }
+#else
+    options.devNull = false;
+#endif
+    sink = new CountingSink(descriptor);
+    std::ostream stream(sink);
+    {
+        sista::OutputRedirect redirect(stream);
+        benchPrint();
+        benchStyledPrint();
+        benchBorderPrint();
+        benchMoveStorm();
+        benchSwaps();
+    }
+    printResults();
+#if !defined(_WIN32)
+    if (descriptor >= 0)
+        close(descriptor);
+#endif
+    delete sink;
+    return 0;
+}
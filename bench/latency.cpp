@@ -0,0 +1,277 @@
+/** \file latency.cpp
+ *  \brief End-to-end latency benchmark of the Sista library behind a pseudo-terminal.
+ *
+ *  The standard output of the process is replaced with the slave side of a pty opened with
+ *  `openpty`, so the rendering code writes through `std::cout` exactly as in an application.
+ *  Every frame timestamps its mutations (`movePawn` or `applySwaps`), then prints an APC
+ *  string carrying the frame number, which terminals ignore. A reader thread drains the
+ *  master side and timestamps the arrival of each marker: the difference is the time from
+ *  the state change to the bytes being readable by the terminal.
+ *
+ *  Usage: `sista-latency [--mode move|swap] [--frames N] [--size WxH] [--ops N] [--rate HZ]
+ *  [--busy THREADS] [--sink cout|writev]`
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include "../include/sista/sista.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+#if defined(__APPLE__)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string mode = "move";
+    std::size_t frames = 2000;
+    int width = 80;
+    int height = 24;
+    std::size_t ops = 20; // Moves or queued paths per frame
+    double rate = 60; // Frames per second, 0 to render as fast as possible
+    unsigned busy = 0; // Threads spinning to load the machine
+    std::string sink = "cout";
+};
+
+static const char MARKER[] = "\x1b_sista;"; // APC string, terminated by ST
+
+/** \brief Reads the master side until every marker arrived, recording their arrival times. */
+static void readMarkers(int master, std::vector<Clock::time_point>& arrivals, std::size_t& bytes) {
+    std::string pending;
+    std::vector<char> buffer(1 << 16);
+    std::size_t received = 0;
+    const std::size_t markerLength = sizeof(MARKER) - 1;
+    while (received < arrivals.size()) {
+        struct pollfd descriptor = {master, POLLIN, 0};
+        if (poll(&descriptor, 1, 5000) <= 0)
+            break; // The renderer stopped writing
+        ssize_t n = read(master, buffer.data(), buffer.size());
+        if (n <= 0)
+            break;
+        Clock::time_point now = Clock::now();
+        bytes += n;
+        pending.append(buffer.data(), n);
+        std::size_t position = 0;
+        while (true) {
+            std::size_t begin = pending.find(MARKER, position);
+            if (begin == std::string::npos) {
+                // Keep a possible partial marker at the end
+                position = pending.size() > markerLength ? pending.size() - markerLength : 0;
+                break;
+            }
+            std::size_t end = pending.find("\x1b\\", begin + markerLength);
+            if (end == std::string::npos) {
+                position = begin;
+                break;
+            }
+            std::size_t frame = std::strtoul(pending.c_str() + begin + markerLength, nullptr, 10);
+            if (frame < arrivals.size()) {
+                arrivals[frame] = now;
+                received++;
+            }
+            position = end + 2;
+        }
+        pending.erase(0, position);
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty())
+        return 0;
+    std::size_t index = static_cast<std::size_t>(fraction * sorted.size());
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static bool parse(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc)
+            return false;
+        std::string value = argv[++i];
+        if (argument == "--mode" && (value == "move" || value == "swap")) {
+            options.mode = value;
+        } else if (argument == "--frames") {
+            options.frames = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (argument == "--size") {
+            if (std::sscanf(value.c_str(), "%dx%d", &options.width, &options.height) != 2)
+                return false;
+        } else if (argument == "--ops") {
+            options.ops = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (argument == "--rate") {
+            options.rate = std::atof(value.c_str());
+        } else if (argument == "--busy") {
+            options.busy = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (argument == "--sink" && (value == "cout" || value == "writev")) {
+            options.sink = value;
+        } else {
+            return false;
+        }
+    }
+    return options.frames > 0 && options.width > 1 && options.height > 0;
+}
+
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parse(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--mode move|swap] [--frames N] [--size WxH] [--ops N]"
+                  << " [--rate HZ] [--busy THREADS] [--sink cout|writev]" << std::endl;
+        return 2;
+    }
+
+    int master, slave;
+    struct winsize size = {};
+    size.ws_row = static_cast<unsigned short>(options.height + 3);
+    size.ws_col = static_cast<unsigned short>(options.width + 2);
+    if (openpty(&master, &slave, nullptr, nullptr, &size) != 0) {
+        std::cerr << "openpty failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    int results = dup(STDOUT_FILENO); // The JSON goes to the original standard output
+    std::cout.flush();
+    dup2(slave, STDOUT_FILENO);
+
+    std::vector<Clock::time_point> mutations(options.frames), arrivals(options.frames);
+    std::size_t bytes = 0;
+    std::thread reader(readMarkers, master, std::ref(arrivals), std::ref(bytes));
+
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> busy;
+    for (unsigned i = 0; i < options.busy; i++) {
+        busy.emplace_back([&stop] {
+            volatile unsigned long spin = 0;
+            while (!stop.load(std::memory_order_relaxed))
+                spin = spin + 1;
+        });
+    }
+
+    {
+        std::unique_ptr<sista::FileDescriptorSink> sink;
+        std::unique_ptr<sista::OutputRedirect> redirect;
+        if (options.sink == "writev") {
+            sink = std::make_unique<sista::FileDescriptorSink>(STDOUT_FILENO);
+            redirect = std::make_unique<sista::OutputRedirect>(sink->stream());
+        }
+        std::ostream& out = sista::getOutputStream();
+
+        sista::SwappableField field(options.width, options.height);
+        std::mt19937 random(7);
+        std::vector<sista::Pawn*> pawns;
+        for (int y = 0; y < options.height; y++) {
+            for (int x = 0; x < options.width; x += 2) { // Even columns, the odd ones are free
+                if (random() % 2)
+                    continue;
+                auto pawn = std::make_shared<sista::Pawn>('A' + y % 26, sista::Coordinates(y, x),
+                    sista::ANSISettings(sista::RGBColor(random() % 256, random() % 256, random() % 256),
+                                        sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT));
+                field.addPawn(pawn);
+                pawns.push_back(pawn.get());
+            }
+        }
+        sista::clearScreen();
+        field.print('#');
+        out << std::flush;
+        if (sink)
+            sink->present();
+
+        Clock::time_point next = Clock::now();
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.rate > 0 ? 1.0 / options.rate : 0.0));
+        for (std::size_t frame = 0; frame < options.frames && !pawns.empty(); frame++) {
+            if (options.rate > 0) {
+                std::this_thread::sleep_until(next);
+                next += period;
+            }
+            mutations[frame] = Clock::now();
+            if (options.mode == "move") {
+                for (std::size_t i = 0; i < options.ops; i++) {
+                    sista::Pawn* pawn = pawns[random() % pawns.size()];
+                    sista::Coordinates target = pawn->getCoordinates();
+                    target.y = (target.y + options.height + random() % 3 - 1) % options.height;
+                    target.x = (target.x + options.width + random() % 3 - 1) % options.width;
+                    if (field.isFree(target))
+                        field.movePawn(pawn, target);
+                }
+            } else {
+                std::size_t first = random() % pawns.size(); // Distinct pawns, each queued once
+                for (std::size_t i = 0; i < std::min(options.ops, pawns.size()); i++) {
+                    sista::Pawn* pawn = pawns[(first + i) % pawns.size()];
+                    sista::Coordinates target = pawn->getCoordinates();
+                    target.x = (target.x + 1) % options.width;
+                    field.addPawnToSwap(pawn, target);
+                }
+                field.applySwaps();
+            }
+            out << MARKER << frame << ESC "\\" << std::flush;
+            if (sink)
+                sink->present();
+        }
+    }
+
+    reader.join();
+    stop = true;
+    for (std::thread& thread : busy)
+        thread.join();
+    close(slave);
+    close(master);
+
+    std::vector<double> latencies;
+    for (std::size_t frame = 0; frame < options.frames; frame++) {
+        if (arrivals[frame] != Clock::time_point())
+            latencies.push_back(std::chrono::duration<double, std::micro>(arrivals[frame] - mutations[frame]).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"library\": \"sista\",\n"
+         << "  \"version\": \"" << sista::getVersion() << "\",\n"
+         << "  \"mode\": \"" << options.mode << "\",\n"
+         << "  \"sink\": \"" << options.sink << "\",\n"
+         << "  \"size\": \"" << options.width << "x" << options.height << "\",\n"
+         << "  \"ops_per_frame\": " << options.ops << ",\n"
+         << "  \"rate_hz\": " << options.rate << ",\n"
+         << "  \"busy_threads\": " << options.busy << ",\n"
+         << "  \"frames\": " << options.frames << ",\n"
+         << "  \"frames_received\": " << latencies.size() << ",\n"
+         << "  \"bytes\": " << bytes << ",\n"
+         << "  \"latency_us\": {"
+         << "\"p50\": " << percentile(latencies, 0.50) << ", "
+         << "\"p99\": " << percentile(latencies, 0.99) << ", "
+         << "\"p999\": " << percentile(latencies, 0.999) << ", "
+         << "\"max\": " << (latencies.empty() ? 0 : latencies.back()) << "}\n"
+         << "}\n";
+    std::string text = json.str();
+    if (write(results, text.data(), text.size()) < 0)
+        return 1;
+    close(results);
+    return latencies.size() == options.frames ? 0 : 1;
+}
+
+#else
+int main() {
+    std::cout << "The latency benchmark needs openpty, skipping" << std::endl;
+    return 0;
+}
+#endif
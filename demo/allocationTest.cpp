@@ -0,0 +1,153 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/** \brief Discards every byte without allocating. */
+class DiscardBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override {
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        return n;
+    }
+};
+
+template <typename Frame>
+static std::size_t countAllocations(Frame frame) { // Allocations of 50 frames after 4 warm-up frames
+    for (int i = 0; i < 4; i++)
+        frame(i);
+    allocations = 0;
+    counting = true;
+    for (int i = 4; i < 54; i++)
+        frame(i);
+    counting = false;
+    return allocations;
+}
+
+static bool expectNone(std::size_t count, const std::string& description) {
+    if (count != 0) {
+        std::cerr << "✗ " << description << ": " << count << " allocations in 50 frames" << std::endl;
+        return false;
+    }
+    std::cout << "✓ " << description << " doesn't allocate" << std::endl;
+    return true;
+}
+
+
+int main() {
+    std::cout << "Testing steady-state allocations..." << std::endl;
+    DiscardBuffer discard;
+    std::ostream discarded(&discard);
+    sista::OutputRedirect redirect(discarded);
+    sista::ANSISettings style(sista::RGBColor(10, 20, 30), sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT);
+
+    sista::SwappableField field(48, 16);
+    std::vector<std::shared_ptr<sista::Pawn>> pawns;
+    for (unsigned short y = 0; y < 16; y++) {
+        for (unsigned short x = 0; x < 48; x += 2) {
+            pawns.push_back(std::make_shared<sista::Pawn>('x', sista::Coordinates(y, x), style));
+            field.addPawn(pawns.back());
+        }
+    }
+    auto shift = [&](int frame, auto move) { // Moves every pawn one cell right, then back
+        for (auto& pawn : pawns) {
+            sista::Coordinates coordinates = pawn->getCoordinates();
+            move(pawn.get(), sista::Coordinates(coordinates.y, coordinates.x + (frame % 2 ? -1 : 1)));
+        }
+    };
+
+    // Test 1: incremental moves
+    if (!expectNone(countAllocations([&](int frame) {
+        shift(frame, [&](sista::Pawn* pawn, sista::Coordinates destination) { field.movePawn(pawn, destination); });
+    }), "movePawn"))
+        return 1;
+
+    // Test 2: swaps without conflicts
+    if (!expectNone(countAllocations([&](int frame) {
+        shift(frame, [&](sista::Pawn* pawn, sista::Coordinates destination) { field.addPawnToSwap(pawn, destination); });
+        field.applySwaps();
+    }), "applySwaps"))
+        return 1;
+
+    // Test 3: swaps rejected by simulateSwaps, two pawns of each triplet head to its free cell
+    sista::SwappableField conflicts(48, 16);
+    std::vector<std::shared_ptr<sista::Pawn>> triplets;
+    for (unsigned short y = 0; y < 16; y++) {
+        for (unsigned short x = 0; x < 48; x += 3) {
+            triplets.push_back(std::make_shared<sista::Pawn>('a', sista::Coordinates(y, x), style));
+            conflicts.addPawn(triplets.back());
+            triplets.push_back(std::make_shared<sista::Pawn>('b', sista::Coordinates(y, x + 2), style));
+            conflicts.addPawn(triplets.back());
+        }
+    }
+    sista::resetStats();
+    if (!expectNone(countAllocations([&](int) {
+        for (std::size_t i = 0; i < triplets.size(); i += 2) {
+            sista::Coordinates free((i / 2) / 16, (i / 2) % 16 * 3); // First cell of the triplet
+            while (!conflicts.isFree(free))
+                free.x++;
+            conflicts.addPawnToSwap(triplets[i].get(), free);
+            conflicts.addPawnToSwap(triplets[i + 1].get(), free);
+        }
+        conflicts.applySwaps();
+    }), "applySwaps with conflicts"))
+        return 1;
+    if (sista::getStats().swapsRejected != 54 * triplets.size() / 2) {
+        std::cerr << "✗ Test 3 failed: " << sista::getStats().swapsRejected << " rejected swaps" << std::endl;
+        return 1;
+    }
+
+    // Test 4: full prints and the performance overlay
+    sista::Border border('#', style);
+    if (!expectNone(countAllocations([&](int) { field.print(); }), "Field::print()")
+        || !expectNone(countAllocations([&](int) { field.print('#'); }), "Field::print(char)")
+        || !expectNone(countAllocations([&](int) { field.print(border); }), "Field::print(Border&)"))
+        return 1;
+    sista::PerformanceOverlay overlay(1, 1, style);
+    if (!expectNone(countAllocations([&](int) { overlay.frame(); }), "PerformanceOverlay::frame"))
+        return 1;
+
+    // Test 5: a pawn crossing the edge of a chunk back and forth, on a chunked field
+    sista::SwappableField large(1000, 1000);
+    auto walker = std::make_shared<sista::Pawn>('w', sista::Coordinates(500, 7), style);
+    large.addPawn(walker);
+    if (!expectNone(countAllocations([&](int) { // Columns 7 and 8 are in two chunks
+        large.movePawn(walker.get(), sista::Coordinates(500, 8));
+        large.addPawnToSwap(walker.get(), sista::Coordinates(500, 7));
+        large.applySwaps();
+    }), "movePawn and applySwaps across chunks"))
+        return 1;
+
+    // Test 6: presenting and enqueuing frames through a FileDescriptorSink
+#if !defined(_WIN32)
+    int descriptor = open("/dev/null", O_WRONLY);
+    if (descriptor < 0)
+        return 1;
+    {
+        sista::FileDescriptorSink sink(descriptor);
+        sista::OutputRedirect sinkRedirect(sink.stream());
+        sista::SharedFrame shared = sista::encodeFrame([&]() { field.print('#'); });
+        if (!expectNone(countAllocations([&](int frame) {
+            shift(frame, [&](sista::Pawn* pawn, sista::Coordinates destination) { field.movePawn(pawn, destination); });
+            sink.present();
+        }), "FileDescriptorSink::present")
+            || !expectNone(countAllocations([&](int) { sink.enqueue(shared); }), "FileDescriptorSink::enqueue"))
+            return 1;
+    }
+    close(descriptor);
+#else
+    std::cout << "FileDescriptorSink is not available on this platform, skipping Test 6" << std::endl;
+#endif
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
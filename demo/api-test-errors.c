@@ -25,9 +25,15 @@ static int expect_message(const char* label, const char* expected) {
 
 int main(void) {
     int failures = 0;
+    FieldHandler_t field;
+    struct sista_Coordinates path[2];
+    struct sista_Coordinates far_coords;
+    size_t length = 0;
     struct sista_Coordinates zero_coords;
     zero_coords.y = 0;
     zero_coords.x = 0;
+    far_coords.y = 0;
+    far_coords.x = 4;
 
     failures += expect_code("print null field return", sista_printField(NULL, '#'), SISTA_ERR_NULL_FIELD);
     failures += expect_code("print null field last error", sista_getLastErrorCode(), SISTA_ERR_NULL_FIELD);
@@ -61,6 +67,33 @@ int main(void) {
     failures += expect_code("destroy null field last error", sista_getLastErrorCode(), SISTA_ERR_NULL_FIELD);
     failures += expect_message("destroy null field message", "field is null");
 
+    failures += expect_code("field with null arena return", sista_createFieldWithArena(4, 4, NULL) == NULL, 1);
+    failures += expect_code("field with null arena last error", sista_getLastErrorCode(), SISTA_ERR_NULL_ARENA);
+    failures += expect_message("field with null arena message", "arena is null");
+
+    failures += expect_code("destroy null arena return", sista_destroyArena(NULL), SISTA_ERR_NULL_ARENA);
+    failures += expect_code("destroy null arena last error", sista_getLastErrorCode(), SISTA_ERR_NULL_ARENA);
+    failures += expect_message("destroy null arena message", "arena is null");
+
+    failures += expect_code("path null field return", sista_findPath(NULL, zero_coords, far_coords, CONNECTIVITY_FOUR,
+        E_CLAMP, PATH_ASTAR, path, 2, &length), SISTA_ERR_NULL_FIELD);
+    failures += expect_message("path null field message", "field is null");
+    field = sista_createField(5, 3);
+    failures += expect_code("path null length return", sista_findPath(field, zero_coords, far_coords, CONNECTIVITY_FOUR,
+        E_CLAMP, PATH_ASTAR, path, 2, NULL), SISTA_ERR_NULL_PATH);
+    failures += expect_code("path longer than capacity return", sista_findPath(field, zero_coords, far_coords, CONNECTIVITY_FOUR,
+        E_CLAMP, PATH_ASTAR, path, 2, &length), SISTA_OK);
+    failures += expect_code("path longer than capacity length", (int)length, 4);
+    failures += expect_code("path first cell", path[0].y * 10 + path[0].x, 1);
+    failures += expect_code("path around the edge return", sista_findPath(field, zero_coords, far_coords, CONNECTIVITY_EIGHT,
+        E_PACMAN, PATH_JUMP_POINT, path, 2, &length), SISTA_OK);
+    failures += expect_code("path around the edge length", (int)length, 1);
+    far_coords.y = 3;
+    failures += expect_code("path out of bounds return", sista_findPath(field, zero_coords, far_coords, CONNECTIVITY_FOUR,
+        E_CLAMP, PATH_ASTAR, path, 2, &length), SISTA_ERR_OUT_OF_BOUNDS);
+    failures += expect_code("path out of bounds last error", sista_getLastErrorCode(), SISTA_ERR_OUT_OF_BOUNDS);
+    sista_destroyField(field);
+
     if (failures != 0) {
         fprintf(stderr, "api-test-errors: %d assertion(s) failed\n", failures);
         return 1;
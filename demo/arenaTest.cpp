@@ -0,0 +1,130 @@
+#include <iostream>
+#include <sstream>
+#include <memory_resource>
+#include "../include/sista/sista.hpp"
+
+/** \brief Forwards to another resource, counting the blocks still allocated. */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t live = 0;
+    std::pmr::memory_resource* upstream;
+
+    explicit CountingResource(std::pmr::memory_resource* upstream_): upstream(upstream_) {}
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        live++;
+        return upstream->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+        live--;
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+
+int main() {
+    std::cout << "Testing memory resources of fields..." << std::endl;
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+
+    // Test 1: the default resource is used when none is given
+    {
+        sista::Field field(4, 4);
+        if (field.getMemoryResource() != std::pmr::get_default_resource()) {
+            std::cerr << "✗ Test 1 failed: the field doesn't use the default resource" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✓ Test 1 passed: fields use the default resource by default" << std::endl;
+
+    // Test 2: the grid of a Field comes from its resource and goes back to it
+    CountingResource counting(std::pmr::new_delete_resource());
+    {
+        sista::Field field(8, 4, &counting);
+        if (field.getMemoryResource() != &counting || counting.allocations != 2) { // Small fields store every cell and its occupancy bit at once
+            std::cerr << "✗ Test 2 failed: " << counting.allocations << " allocations for a dense field" << std::endl;
+            return 1;
+        }
+    }
+    counting.allocations = 0;
+    {
+        sista::Field field(8, 4, sista::Storage::CHUNKED, &counting);
+        if (field.getMemoryResource() != &counting || counting.allocations != 0) { // Chunks are allocated on demand
+            std::cerr << "✗ Test 2 failed: " << counting.allocations << " allocations for an empty field" << std::endl;
+            return 1;
+        }
+        field.addPawn(std::make_shared<sista::Pawn>('A', sista::Coordinates(3, 7), sista::ANSISettings()));
+        if (counting.allocations != 3) { // The chunk, the chunk directory and the tile counts
+            std::cerr << "✗ Test 2 failed: " << counting.allocations << " allocations from the resource" << std::endl;
+            return 1;
+        }
+    }
+    if (counting.live != 0) {
+        std::cerr << "✗ Test 2 failed: " << counting.live << " blocks not returned to the resource" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 2 passed: the grid of a Field is allocated from its resource" << std::endl;
+
+    // Test 3: a SwappableField works from a fixed buffer with no fallback
+    alignas(std::max_align_t) static unsigned char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    try {
+        sista::SwappableField field(16, 8, &arena);
+        auto first = std::make_shared<sista::Pawn>('A', sista::Coordinates(0, 0), sista::ANSISettings());
+        auto second = std::make_shared<sista::Pawn>('B', sista::Coordinates(0, 2), sista::ANSISettings());
+        field.addPawn(first);
+        field.addPawn(second);
+        for (int tick = 0; tick < 10; tick++) { // Both pawns head to the free cell between them, one is rejected
+            sista::Coordinates free = field.isFree(sista::Coordinates(0, 1)) ? sista::Coordinates(0, 1) : sista::Coordinates(0, 2);
+            field.addPawnToSwap(first.get(), free);
+            field.addPawnToSwap(second.get(), free);
+            field.applySwaps();
+        }
+        field.movePawn(first.get(), sista::Coordinates(7, 15));
+        if (field.getPawn(sista::Coordinates(7, 15)) != first.get() || field.getPawn(second->getCoordinates()) != second.get()) {
+            std::cerr << "✗ Test 3 failed: the pawns are not where they should be" << std::endl;
+            return 1;
+        }
+    } catch (const std::bad_alloc&) {
+        std::cerr << "✗ Test 3 failed: a container allocated outside of the arena" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 3 passed: a SwappableField runs entirely inside an arena" << std::endl;
+
+    // Test 4: a pawn crossing the edge of a chunk reuses the chunk it left
+    counting.allocations = 0;
+    {
+        sista::SwappableField field(1000, 1000, &counting);
+        auto pawn = std::make_shared<sista::Pawn>('A', sista::Coordinates(500, 7), sista::ANSISettings());
+        field.addPawn(pawn);
+        field.movePawn(pawn.get(), sista::Coordinates(500, 8)); // Columns 7 and 8 are in two chunks
+        field.movePawn(pawn.get(), sista::Coordinates(500, 7));
+        std::size_t before = counting.allocations, live = counting.live;
+        for (int step = 0; step < 10000; step++)
+            field.movePawn(pawn.get(), sista::Coordinates(500, step % 2 ? 7 : 8));
+        if (counting.allocations != before) {
+            std::cerr << "✗ Test 4 failed: " << counting.allocations - before << " allocations in 10000 moves" << std::endl;
+            return 1;
+        }
+        field.removePawn(pawn.get());
+        field.shrink();
+        if (counting.live >= live) {
+            std::cerr << "✗ Test 4 failed: shrink() didn't free the empty chunks" << std::endl;
+            return 1;
+        }
+    }
+    if (counting.live != 0) {
+        std::cerr << "✗ Test 4 failed: " << counting.live << " blocks not returned to the resource" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 4 passed: a pawn crossing chunks doesn't allocate" << std::endl;
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../include/sista/sista.hpp"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
+
+static std::string readAll(int fd) { // Reads whatever is available in the pipe
+    std::string result;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+        result.append(buffer, n);
+    return result;
+}
+#endif
+
+
+int main() {
+#if defined(_WIN32)
+    std::cout << "FileDescriptorSink is not available on this platform, skipping" << std::endl;
+    return 0;
+#else
+    std::cout << "Testing BroadcastChannel..." << std::endl;
+    std::ostringstream silenced; // Field's Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+
+    sista::Field field(10, 4);
+    field.addPawn(std::make_shared<sista::Pawn>('P', sista::Coordinates(1, 0), sista::ANSISettings()));
+
+    // Test 1: encodeFrame captures exactly what the drawing code prints
+    sista::SharedFrame keyframe = sista::encodeFrame([&] {
+        sista::clearScreen();
+        field.print('#');
+    });
+    std::ostringstream reference;
+    {
+        sista::OutputRedirect redirect(reference);
+        sista::clearScreen();
+        field.print('#');
+    }
+    if (keyframe == nullptr || *keyframe != reference.str()) {
+        std::cerr << "✗ Test 1 failed: the encoded frame differs from the printed one" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 1 passed: encodeFrame captures the printed bytes" << std::endl;
+
+    // Test 2: every spectator receives the same bytes, late joiners get the keyframe first
+    const int spectators = 3;
+    int fds[spectators][2];
+    std::vector<std::unique_ptr<sista::FileDescriptorSink>> sinks;
+    for (auto& pair : fds) {
+        if (pipe(pair) != 0)
+            return 1;
+        fcntl(pair[0], F_SETFL, O_NONBLOCK);
+        sinks.push_back(std::make_unique<sista::FileDescriptorSink>(pair[1]));
+    }
+    sista::BroadcastChannel channel;
+    channel.subscribe(*sinks[0]);
+    channel.publishKeyframe(keyframe);
+    channel.subscribe(*sinks[1]);
+    std::string expected = *keyframe;
+    for (int tick = 0; tick < 4; tick++) {
+        sista::SharedFrame delta = sista::encodeFrame([&] {
+            field.movePawnBy(field.getPawn(1, tick), 0, 1); // Prints only the moved cells
+        });
+        channel.publish(delta);
+        expected += *delta;
+        if (tick == 1)
+            channel.subscribe(*sinks[2]); // Joins mid-stream
+    }
+    for (int i = 0; i < spectators; i++) {
+        std::string received = readAll(fds[i][0]);
+        if (received != expected) {
+            std::cerr << "✗ Test 2 failed: spectator " << i << " received different bytes" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✓ Test 2 passed: spectators, late or not, see the same screen" << std::endl;
+
+    // Test 3: frames waiting for a slow spectator are referenced, not copied
+    fcntl(fds[0][1], F_SETFL, O_NONBLOCK);
+    std::string filler(4096, '.');
+    while (write(fds[0][1], filler.data(), filler.size()) > 0); // Fill the pipe of spectator 0
+    sista::SharedFrame delta = sista::encodeFrame([&] {
+        field.movePawnBy(field.getPawn(1, 4), 0, 1);
+    });
+    channel.publish(delta);
+    // The test, the channel's history and the slow spectator's backlog hold the frame
+    if (delta.use_count() != 3 || !sinks[0]->pending()) {
+        std::cerr << "✗ Test 3 failed: use_count is " << delta.use_count() << std::endl;
+        return 1;
+    }
+    readAll(fds[0][0]);
+    sinks[0]->flush();
+    if (delta.use_count() != 2 || sinks[0]->pending()) {
+        std::cerr << "✗ Test 3 failed: the frame was not released after being written" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 3 passed: fan-out is zero-copy" << std::endl;
+
+    // Test 4: deltas larger than the keyframe ask for a new keyframe
+    bool asked = false;
+    for (int tick = 5; tick < 200 && !asked; tick++) {
+        channel.publish(sista::encodeFrame([&] {
+            field.movePawnBy(field.getPawn(1, tick % 10), 0, 1, sista::Effect::PACMAN);
+        }));
+        asked = channel.needsKeyframe();
+    }
+    channel.publishKeyframe(sista::encodeFrame([&] {
+        sista::clearScreen();
+        field.print('#');
+    }));
+    if (!asked || channel.needsKeyframe()) {
+        std::cerr << "✗ Test 4 failed: needsKeyframe is not tracking the deltas" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 4 passed: the channel asks for keyframes" << std::endl;
+
+    // Test 5: failed spectators are dropped
+    signal(SIGPIPE, SIG_IGN);
+    close(fds[1][0]);
+    channel.publish(sista::encodeFrame([&] {
+        field.print('#');
+    }));
+    if (channel.subscriberCount() != 2 || !sinks[1]->hasFailed()) {
+        std::cerr << "✗ Test 5 failed: the closed spectator is still subscribed" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 5 passed: failed spectators are unsubscribed" << std::endl;
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+#endif
+}
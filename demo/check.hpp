@@ -0,0 +1,53 @@
+// Shared harness of the tests: expect() prints the outcome of each check and counts the failures.
+// Defining SISTA_CHECK_ALLOCATIONS before the include also replaces the global operator new and
+// delete, counting in `allocations` every allocation made while `counting` is set.
+#pragma once
+
+#include <iostream>
+#include <string>
+#if defined(SISTA_CHECK_ALLOCATIONS)
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+static int failures = 0;
+
+static inline void expect(bool condition, const std::string& description) { // Prints the outcome of a check
+    if (condition) {
+        std::cout << "✓ " << description << std::endl;
+    } else {
+        std::cerr << "✗ " << description << std::endl;
+        failures++;
+    }
+}
+
+#if defined(SISTA_CHECK_ALLOCATIONS)
+// Every allocation of the process goes through these, counted while `counting` is set
+static bool counting = false;
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    if (counting)
+        allocations++;
+    void* pointer = std::malloc(size > 0 ? size : 1);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+#endif
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <random>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// Coordinates are usable in constant expressions
+constexpr sista::Coordinates origin;
+constexpr sista::Coordinates corner(23, 79);
+static_assert(origin == sista::Coordinates(0, 0) && corner != origin, "equality");
+static_assert(origin < corner && sista::Coordinates(1, 0) < sista::Coordinates(1, 1) && sista::Coordinates(0, 79) < sista::Coordinates(1, 0), "row-major ordering");
+static_assert(corner + sista::Coordinates(1, 1) == sista::Coordinates(24, 80) && corner - corner == origin, "arithmetic");
+static_assert(sista::Coordinates(2, 3) * 4 == sista::Coordinates(8, 12), "scalar multiplication");
+static_assert(corner.pack() == (23u << 16 | 79u) && sista::Coordinates::unpack(corner.pack()) == corner, "packed form");
+static_assert(sista::Coordinates::fromPair(corner.toPair()) == corner, "pair conversion");
+
+
+int main() {
+    std::cout << "Testing Coordinates..." << std::endl;
+    std::mt19937 random(42);
+
+    // The packed form orders and hashes like the coordinates
+    bool ordered = true;
+    for (int i = 0; i < 10000; i++) {
+        sista::Coordinates a(random() % 65536, random() % 65536), b(random() % 65536, random() % 65536);
+        bool less = a.y != b.y ? a.y < b.y : a.x < b.x;
+        ordered = ordered && (a < b) == less && (a.pack() < b.pack()) == less;
+    }
+    expect(ordered, "operator< and pack order the coordinates by row, then by column");
+    std::unordered_set<sista::Coordinates> cells;
+    for (unsigned short y = 0; y < 64; y++)
+        for (unsigned short x = 0; x < 64; x++)
+            cells.insert(sista::Coordinates(y, x));
+    expect(cells.size() == 64 * 64 && cells.count(sista::Coordinates(63, 63)) == 1
+        && std::hash<sista::Coordinates>()(corner) == corner.pack(), "std::hash uses the packed form");
+
+    // Compound assignments return the updated instance
+    sista::Coordinates moving(5, 5);
+    (moving += sista::Coordinates(1, 2)) -= sista::Coordinates(0, 1);
+    expect(moving == sista::Coordinates(6, 6), "compound assignments chain on the same instance");
+
+    // Batch transforms match the element-wise operators
+    std::vector<sista::Coordinates> batch, expected;
+    for (int i = 0; i < 1003; i++) { // Not a multiple of any vector width
+        batch.emplace_back(random() % 1000 + 10, random() % 1000 + 10);
+        expected.push_back(batch.back() - sista::Coordinates(3, 7));
+    }
+    sista::translate(batch.data(), batch.size(), -3, -7);
+    expect(batch == expected, "translate moves every coordinate of the array");
+    std::vector<std::uint32_t> packed(batch.size());
+    std::vector<sista::Coordinates> unpacked(batch.size());
+    sista::pack(batch.data(), batch.size(), packed.data());
+    sista::unpack(packed.data(), packed.size(), unpacked.data());
+    expect(packed[17] == batch[17].pack() && unpacked == batch, "pack and unpack round-trip arrays");
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
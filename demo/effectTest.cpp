@@ -0,0 +1,126 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// The policies are usable in constant expressions
+static_assert(sista::floorModulo(-1, 10) == 9 && sista::floorModulo(-20, 10) == 0 && sista::floorQuotient(-1, 10) == -1, "floor division");
+static_assert(sista::ClampEffect::clamp(-5, 10) == 0 && sista::ClampEffect::clamp(12, 10) == 9, "clamp");
+static_assert(sista::BounceEffect::reflect(-1, 10) == 1 && sista::BounceEffect::reflect(10, 10) == 8 && sista::BounceEffect::reflect(3, 1) == 0, "bounce");
+
+// Step-by-step references of the effects, following a coordinate one cell at a time
+static int pacman(int value, int size) {
+    while (value < 0) value += size;
+    while (value >= size) value -= size;
+    return value;
+}
+static int bounce(int value, int size) {
+    int position = 0, direction = value < 0 ? -1 : 1;
+    for (int step = 0; step < (value < 0 ? -value : value); step++) {
+        if (position + direction < 0 || position + direction >= size)
+            direction = -direction; // Reflected by the edge
+        if (size > 1)
+            position += direction;
+    }
+    return position;
+}
+static bool matrix(int& y, int& x, int height, int width) {
+    while (x < 0) { x += width; y--; }
+    while (x >= width) { x -= width; y++; }
+    return y >= 0 && y < height;
+}
+
+
+int main() {
+    std::cout << "Testing wrap-around effects..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+
+    // Each policy matches its reference on small fields
+    bool pacmanSame = true, matrixSame = true, clampSame = true, bounceSame = true;
+    for (int height = 1; height <= 7; height++) {
+        for (int width = 1; width <= 7; width++) {
+            for (int y = -40; y <= 40; y++) {
+                for (int x = -40; x <= 40; x++) {
+                    int py = y, px = x, my = y, mx = x, cy = y, cx = x, by = y, bx = x;
+                    sista::PacmanEffect::apply(py, px, height, width);
+                    pacmanSame = pacmanSame && py == pacman(y, height) && px == pacman(x, width);
+                    int ry = y, rx = x;
+                    bool valid = sista::MatrixEffect::apply(my, mx, height, width);
+                    matrixSame = matrixSame && valid == matrix(ry, rx, height, width) && (!valid || (my == ry && mx == rx));
+                    sista::ClampEffect::apply(cy, cx, height, width);
+                    clampSame = clampSame && cy == std::min(std::max(y, 0), height - 1) && cx == std::min(std::max(x, 0), width - 1);
+                    sista::BounceEffect::apply(by, bx, height, width);
+                    bounceSame = bounceSame && by == bounce(y, height) && bx == bounce(x, width);
+                }
+            }
+        }
+    }
+    expect(pacmanSame, "PACMAN wraps to the opposite side");
+    expect(matrixSame, "MATRIX wraps to the previous and next rows");
+    expect(clampSame, "CLAMP stops at the edges");
+    expect(bounceSame, "BOUNCE reflects off the edges");
+
+    // The batch computes the same destinations as the single moves
+    std::mt19937 random(43);
+    std::vector<sista::Coordinates> from, to(5000);
+    std::vector<short> dy, dx;
+    for (int i = 0; i < 5000; i++) {
+        from.emplace_back(random() % 37, random() % 100);
+        dy.push_back(static_cast<short>(random() % 201) - 100);
+        dx.push_back(static_cast<short>(random() % 401) - 200);
+    }
+    bool batchSame = true;
+    for (sista::Effect effect : {sista::Effect::PACMAN, sista::Effect::MATRIX, sista::Effect::CLAMP, sista::Effect::BOUNCE}) {
+        std::size_t invalid = sista::applyEffect(effect, from.data(), dy.data(), dx.data(), from.size(), 37, 100, to.data());
+        std::size_t expectedInvalid = 0;
+        for (std::size_t i = 0; i < from.size(); i++) {
+            int y = from[i].y + dy[i], x = from[i].x + dx[i];
+            sista::Coordinates expected = from[i];
+            if (sista::applyEffect(effect, y, x, 37, 100))
+                expected = sista::Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x));
+            else
+                expectedInvalid++;
+            batchSame = batchSame && to[i] == expected;
+        }
+        batchSame = batchSame && invalid == expectedInvalid;
+    }
+    expect(batchSame, "the batch API matches the single moves for every effect");
+
+    // Field applies the effects on fields that aren't square
+    sista::Field field(10, 4);
+    auto pawn = std::make_shared<sista::Pawn>('P', sista::Coordinates(0, 0), sista::ANSISettings());
+    field.addPawn(pawn);
+    expect(field.movingByCoordinates(pawn.get(), -2, -13, sista::Effect::PACMAN) == sista::Coordinates(2, 7),
+        "PACMAN wraps rows by the height of the field");
+    expect(field.movingByCoordinates(pawn.get(), 5, 13, sista::Effect::CLAMP) == sista::Coordinates(3, 9)
+        && field.movingByCoordinates(pawn.get(), 5, 13, sista::Effect::BOUNCE) == sista::Coordinates(1, 5),
+        "CLAMP and BOUNCE keep the pawn inside the field");
+    field.movePawnBy(pawn.get(), -2, -13, sista::Effect::PACMAN);
+    expect(pawn->getCoordinates() == sista::Coordinates(2, 7) && field.getPawn(sista::Coordinates(2, 7)) == pawn.get(),
+        "movePawnBy moves the pawn to the wrapped cell");
+    bool rangeError = false, outOfRange = false;
+    try {
+        field.movingByCoordinates(pawn.get(), 0, 30, sista::Effect::MATRIX);
+    } catch (const std::range_error&) {
+        rangeError = true;
+    }
+    try {
+        field.movePawnBy(pawn.get(), 0, 30, sista::Effect::MATRIX);
+    } catch (const std::out_of_range&) {
+        outOfRange = true;
+    }
+    expect(rangeError && outOfRange && pawn->getCoordinates() == sista::Coordinates(2, 7),
+        "MATRIX past the last row throws and leaves the pawn in place");
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
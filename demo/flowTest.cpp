@@ -0,0 +1,242 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+// Breadth-first search from every goal with the rules of FlowField, over an explicit set of walls
+static std::vector<std::uint32_t> referenceDistances(int width, int height, const std::vector<char>& walls,
+                                                     const std::vector<sista::Coordinates>& goals, bool eight, bool wrap) {
+    auto open = [&](int y, int x) {
+        if (wrap) {
+            y = (y + height) % height;
+            x = (x + width) % width;
+        } else if (y < 0 || y >= height || x < 0 || x >= width) {
+            return false;
+        }
+        return !walls[y * width + x];
+    };
+    std::vector<std::uint32_t> distances(static_cast<std::size_t>(width) * height, sista::FlowField::UNREACHABLE);
+    std::vector<int> queue;
+    for (const sista::Coordinates& goal : goals) {
+        if (distances[goal.y * width + goal.x] != 0) {
+            distances[goal.y * width + goal.x] = 0;
+            queue.push_back(goal.y * width + goal.x);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        int y = queue[head] / width, x = queue[head] % width;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                bool diagonal = dy != 0 && dx != 0;
+                if ((dy == 0 && dx == 0) || (diagonal && !eight) || !open(y + dy, x + dx))
+                    continue;
+                if (diagonal && (!open(y + dy, x) || !open(y, x + dx)))
+                    continue;
+                int next = ((y + dy + height) % height) * width + (x + dx + width) % width;
+                if (distances[next] == sista::FlowField::UNREACHABLE) {
+                    distances[next] = distances[queue[head]] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+    return distances;
+}
+
+// Counts the cells whose distance differs from the reference
+static int mismatches(const sista::FlowField& flow, const std::vector<std::uint32_t>& expected, int width, int height) {
+    int wrong = 0;
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            wrong += flow.getDistance(sista::Coordinates(y, x)) != expected[y * width + x];
+    return wrong;
+}
+
+
+int main() {
+    std::cout << "Testing flow fields..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(47);
+
+    // The distances match a breadth-first search, and the incremental updates a full one
+    for (bool wrap : {false, true}) {
+        for (bool eight : {false, true}) {
+            const int width = 71, height = 29; // Rows of more than one word of the bitmaps
+            int computed = 0, updated = 0, steps = 0;
+            for (int round = 0; round < 4; round++) {
+                sista::Field field(width, height);
+                std::vector<std::shared_ptr<sista::Pawn>> pawns;
+                std::vector<char> walls(width * height, 0);
+                for (int y = 0; y < height; y++) {
+                    for (int x = 0; x < width; x++) {
+                        if (random() % 100 < 25) {
+                            pawns.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, x), sista::ANSISettings()));
+                            field.addPawn(pawns.back());
+                            walls[y * width + x] = 1;
+                        }
+                    }
+                }
+                std::vector<sista::Coordinates> goals = {sista::Coordinates(random() % height, random() % width),
+                                                         sista::Coordinates(random() % height, random() % width)};
+                for (const sista::Coordinates& goal : goals)
+                    walls[goal.y * width + goal.x] = 0; // The goals are never obstacles
+                sista::FlowField flow(field, eight ? sista::Connectivity::EIGHT : sista::Connectivity::FOUR,
+                    wrap ? sista::Effect::PACMAN : sista::Effect::CLAMP);
+                flow.compute(goals);
+                computed += mismatches(flow, referenceDistances(width, height, walls, goals, eight, wrap), width, height);
+
+                for (int change = 0; change < 150; change++) {
+                    sista::Coordinates cell(random() % height, random() % width);
+                    bool wall = random() % 2;
+                    flow.setObstacle(cell, wall);
+                    bool goal = cell == goals[0] || cell == goals[1];
+                    walls[cell.y * width + cell.x] = wall && !goal;
+                    if (change % 25 == 24)
+                        updated += mismatches(flow, referenceDistances(width, height, walls, goals, eight, wrap), width, height);
+                }
+
+                for (int y = 0; y < height; y++) { // Every next step is one step nearer to a goal
+                    for (int x = 0; x < width; x++) {
+                        sista::Coordinates from(y, x), next;
+                        std::uint32_t distance = flow.getDistance(from);
+                        bool moved = flow.nextStep(from, next);
+                        if (walls[y * width + x])
+                            continue;
+                        if (moved != (distance != 0 && distance != sista::FlowField::UNREACHABLE)
+                            || (moved && flow.getDistance(next) + 1 != distance))
+                            steps++;
+                    }
+                }
+            }
+            std::string name = std::string(wrap ? "PACMAN" : "bounded") + (eight ? " 8-connected" : " 4-connected");
+            expect(computed == 0, name + " distances match breadth-first search (" + std::to_string(computed) + " wrong)");
+            expect(updated == 0, name + " incremental updates match a full search (" + std::to_string(updated) + " wrong)");
+            expect(steps == 0, name + " next steps lead to the goals (" + std::to_string(steps) + " wrong)");
+        }
+    }
+
+    // Goals may be occupied, and out-of-bounds goals throw
+    {
+        sista::Field field(10, 3);
+        auto target = std::make_shared<sista::Pawn>('T', sista::Coordinates(1, 9), sista::ANSISettings());
+        field.addPawn(target);
+        sista::FlowField flow(field);
+        flow.compute({target->getCoordinates()});
+        expect(flow.getDistance(sista::Coordinates(1, 0)) == 9 && !flow.isObstacle(target->getCoordinates()),
+            "an occupied goal is reached");
+        bool thrown = false;
+        try {
+            flow.compute({sista::Coordinates(3, 0)});
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        expect(thrown, "a goal out of bounds throws std::out_of_range");
+        expect(flow.getDistance(sista::Coordinates(7, 7)) == sista::FlowField::UNREACHABLE, "a cell out of bounds is unreachable");
+    }
+
+    // update reads the occupancy of a cell after a Pawn moves
+    {
+        sista::Field field(9, 1);
+        auto door = std::make_shared<sista::Pawn>('|', sista::Coordinates(0, 4), sista::ANSISettings());
+        field.addPawn(door);
+        sista::FlowField flow(field);
+        flow.compute({sista::Coordinates(0, 8)});
+        bool closed = flow.getDistance(sista::Coordinates(0, 0)) == sista::FlowField::UNREACHABLE;
+        field.movePawn(door.get(), sista::Coordinates(0, 8));
+        flow.update(sista::Coordinates(0, 4));
+        flow.update(sista::Coordinates(0, 8));
+        expect(closed && flow.getDistance(sista::Coordinates(0, 0)) == 8, "a Pawn leaving a corridor opens it");
+    }
+
+    // A crowd walks to the goal, steered through a SwappableField
+    {
+        const int width = 60, height = 20;
+        sista::SwappableField field(width, height);
+        std::vector<std::shared_ptr<sista::Pawn>> walls, crowd;
+        for (int y = 8; y < height; y++) {
+            walls.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, 30), sista::ANSISettings()));
+            field.addPawn(walls.back());
+        }
+        for (int k = 0; k < 200; k++) {
+            sista::Coordinates cell(random() % height, random() % 30);
+            if (field.isFree(cell)) {
+                crowd.push_back(std::make_shared<sista::Pawn>('o', cell, sista::ANSISettings()));
+                field.addPawn(crowd.back());
+            }
+        }
+        sista::FlowField flow(field, sista::Connectivity::EIGHT);
+        flow.compute({sista::Coordinates(height - 1, width - 1)}, [](const sista::Pawn& pawn) {
+            return pawn.getSymbol() == '#'; // The crowd doesn't block its own walk
+        });
+        auto total = [&]() {
+            std::uint64_t sum = 0;
+            for (const auto& pawn : crowd)
+                sum += flow.getDistance(pawn->getCoordinates());
+            return sum;
+        };
+        std::uint64_t before = total();
+        bool monotone = true;
+        std::size_t queued = 0;
+        for (int tick = 0; tick < 60; tick++) {
+            std::uint64_t previous = total();
+            queued += flow.steer(field, crowd);
+            field.applySwaps();
+            monotone = monotone && total() <= previous;
+        }
+        std::uint64_t after = total();
+        expect(monotone && after < before * 2 / 3, "200 Pawns steered through a gap: total distance " + std::to_string(before)
+            + " down to " + std::to_string(after) + " with " + std::to_string(queued) + " steps queued");
+    }
+
+    // Incremental updates don't allocate once the scratch buffers grew
+    {
+        const int width = 256, height = 256;
+        sista::Field field(width, height);
+        std::vector<std::shared_ptr<sista::Pawn>> pawns;
+        for (int k = 0; k < 8000; k++) {
+            sista::Coordinates cell(random() % height, random() % width);
+            if (field.isFree(cell)) {
+                pawns.push_back(std::make_shared<sista::Pawn>('#', cell, sista::ANSISettings()));
+                field.addPawn(pawns.back());
+            }
+        }
+        sista::FlowField flow(field, sista::Connectivity::EIGHT);
+        std::vector<sista::Coordinates> goals = {sista::Coordinates(128, 128)};
+        std::vector<sista::Coordinates> changes;
+        for (int k = 0; k < 500; k++)
+            changes.push_back(sista::Coordinates(random() % height, random() % width));
+        flow.compute(goals);
+        for (int pass = 0; pass < 2; pass++) { // The first pass grows the buffers, the second one must not allocate
+            counting = pass == 1;
+            for (const sista::Coordinates& cell : changes)
+                flow.setObstacle(cell, !flow.isObstacle(cell));
+            for (const sista::Coordinates& cell : changes)
+                flow.setObstacle(cell, !flow.isObstacle(cell));
+            counting = false;
+        }
+        expect(allocations == 0, "2000 incremental updates after the first ones made " + std::to_string(allocations) + " allocations");
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < 10; k++)
+            flow.compute(goals);
+        long long full = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / 10;
+        begin = std::chrono::steady_clock::now();
+        for (const sista::Coordinates& cell : changes)
+            flow.setObstacle(cell, !flow.isObstacle(cell));
+        long long incremental = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "  256x256 with 8000 walls: full search " << full << "us, 500 incremental updates " << incremental << "us" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+static long long squaredDistance(const sista::Pawn* pawn, const sista::Coordinates& center) {
+    long long dy = pawn->getCoordinates().y - center.y, dx = pawn->getCoordinates().x - center.x;
+    return dy * dy + dx * dx;
+}
+
+// Checks every kind of query against a scan of all the Pawns, returning the number of wrong answers
+static int check(const sista::Field& field, const std::vector<std::shared_ptr<sista::Pawn>>& pawns, std::mt19937& random, int queries) {
+    int wrong = 0;
+    std::vector<sista::Pawn*> found, expected;
+    auto sameSet = [&]() {
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        return found == expected;
+    };
+    auto even = [](const sista::Pawn& pawn) { return pawn.getCoordinates().x % 2 == 0; };
+    for (int query = 0; query < queries; query++) {
+        sista::Coordinates center(random() % field.getHeight(), random() % field.getWidth());
+        sista::Rectangle area(center, static_cast<unsigned short>(random() % 150 + 1), static_cast<unsigned short>(random() % 150 + 1));
+        field.findPawnsIn(area, found);
+        expected.clear();
+        for (const auto& pawn : pawns)
+            if (area.contains(pawn->getCoordinates()))
+                expected.push_back(pawn.get());
+        wrong += !sameSet();
+
+        unsigned short radius = static_cast<unsigned short>(random() % 100);
+        field.findPawnsNear(center, radius, found, even);
+        expected.clear();
+        for (const auto& pawn : pawns)
+            if (squaredDistance(pawn.get(), center) <= radius * radius && even(*pawn))
+                expected.push_back(pawn.get());
+        wrong += !sameSet();
+
+        std::size_t count = random() % 12 + 1;
+        for (bool filtered : {false, true}) {
+            if (filtered)
+                field.findNearestPawns(center, count, found, even);
+            else
+                field.findNearestPawns(center, count, found);
+            expected.clear();
+            for (const auto& pawn : pawns)
+                if (!filtered || even(*pawn))
+                    expected.push_back(pawn.get());
+            std::sort(expected.begin(), expected.end(), [&](const sista::Pawn* first, const sista::Pawn* second) {
+                long long a = squaredDistance(first, center), b = squaredDistance(second, center);
+                return a != b ? a < b : first->getCoordinates().pack() < second->getCoordinates().pack();
+            });
+            expected.resize(std::min(count, expected.size()));
+            wrong += found != expected;
+        }
+    }
+    return wrong;
+}
+
+
+int main() {
+    std::cout << "Testing spatial queries..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(50);
+
+    // The queries match a scan of every Pawn, on both layouts and while the Pawns move
+    for (sista::Storage storage : {sista::Storage::DENSE, sista::Storage::CHUNKED}) {
+        const int width = 300, height = 200;
+        sista::SwappableField field(width, height, storage);
+        std::vector<std::shared_ptr<sista::Pawn>> pawns;
+        for (int k = 0; k < 1500; k++) {
+            sista::Coordinates cell(random() % height, random() % width);
+            if (cell.y < 100 && cell.x < 150 && random() % 4 != 0)
+                continue; // Sparser in a corner, so that some tiles are empty
+            if (field.isFree(cell)) {
+                pawns.push_back(std::make_shared<sista::Pawn>('o', cell, sista::ANSISettings()));
+                field.addPawn(pawns.back());
+            }
+        }
+        std::string name = storage == sista::Storage::DENSE ? "dense" : "chunked";
+        int wrong = check(field, pawns, random, 100);
+
+        for (int tick = 0; tick < 30; tick++) { // Moves, swaps and removals keep the tiles up to date
+            for (int k = 0; k < 40; k++) {
+                sista::Pawn* pawn = pawns[random() % pawns.size()].get();
+                sista::Coordinates cell(random() % height, random() % width);
+                if (field.isFree(cell))
+                    field.movePawn(pawn, cell);
+            }
+            for (const auto& pawn : pawns) {
+                sista::Coordinates cell = pawn->getCoordinates();
+                int dy = static_cast<int>(random() % 3) - 1, dx = static_cast<int>(random() % 3) - 1;
+                sista::Coordinates next(std::min(std::max(cell.y + dy, 0), height - 1), std::min(std::max(cell.x + dx, 0), width - 1));
+                field.addPawnToSwap(pawn.get(), next);
+            }
+            field.applySwaps();
+            if (tick % 10 == 9) {
+                field.removePawn(pawns.back().get());
+                pawns.pop_back();
+                wrong += check(field, pawns, random, 30);
+            }
+        }
+        expect(wrong == 0, name + " fields answer rectangle, radius and nearest queries like a scan (" + std::to_string(wrong) + " wrong)");
+    }
+
+    // Edge cases
+    {
+        sista::Field field(10, 10);
+        std::vector<sista::Pawn*> found = {nullptr};
+        field.findNearestPawns(sista::Coordinates(5, 5), 3, found);
+        expect(found.empty(), "an empty field has no nearest Pawns");
+        auto pawn = std::make_shared<sista::Pawn>('o', sista::Coordinates(9, 9), sista::ANSISettings());
+        field.addPawn(pawn);
+        field.findNearestPawns(sista::Coordinates(0, 0), 3, found);
+        expect(found.size() == 1 && found.front() == pawn.get(), "fewer Pawns than asked are all found");
+        field.findNearestPawns(sista::Coordinates(10, 0), 3, found);
+        expect(found.empty(), "a center out of bounds has no nearest Pawns");
+        field.findPawnsNear(sista::Coordinates(0, 0), 12, found);
+        bool far = found.empty();
+        field.findPawnsNear(sista::Coordinates(0, 0), 13, found);
+        expect(far && found.size() == 1, "the radius is a Euclidean distance");
+        field.findPawnsIn(sista::Rectangle(sista::Coordinates(9, 9), 50, 50), found);
+        expect(found.size() == 1, "a rectangle is clipped to the field");
+    }
+
+    // Large sparse fields answer from the occupied tiles
+    {
+        sista::Field field(60000, 60000);
+        std::vector<std::shared_ptr<sista::Pawn>> pawns;
+        for (int k = 0; k < 3000; k++) {
+            sista::Coordinates cell(random() % 60000, random() % 60000);
+            if (field.isFree(cell)) {
+                pawns.push_back(std::make_shared<sista::Pawn>('o', cell, sista::ANSISettings()));
+                field.addPawn(pawns.back());
+            }
+        }
+        int wrong = check(field, pawns, random, 20);
+        expect(wrong == 0, "a 60000x60000 field with 3000 Pawns answers like a scan (" + std::to_string(wrong) + " wrong)");
+
+        std::vector<sista::Pawn*> found;
+        std::vector<sista::Coordinates> centers;
+        for (int k = 0; k < 200; k++)
+            centers.push_back(sista::Coordinates(random() % 60000, random() % 60000));
+        for (int pass = 0; pass < 2; pass++) { // The first pass grows the buffers, the second one must not allocate
+            counting = pass == 1;
+            for (const sista::Coordinates& center : centers) {
+                field.findNearestPawns(center, 8, found);
+                field.findPawnsNear(center, 2000, found);
+            }
+            counting = false;
+        }
+        expect(allocations == 0, "400 queries after the first ones made " + std::to_string(allocations) + " allocations");
+
+        auto begin = std::chrono::steady_clock::now();
+        for (const sista::Coordinates& center : centers)
+            field.findNearestPawns(center, 8, found);
+        long long nearest = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "  200 queries of the 8 nearest of 3000 Pawns on 60000x60000: " << nearest << "us" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// Checks that the occupancy of every cell agrees with its pawn
+static bool consistent(const sista::Field& field, int width, int height) {
+    for (unsigned short y = 0; y < height; y++)
+        for (unsigned short x = 0; x < width; x++)
+            if (field.isOccupied(sista::Coordinates(y, x)) != (field.getPawn(sista::Coordinates(y, x)) != nullptr))
+                return false;
+    return true;
+}
+
+// Counts the pawns of an area one cell at a time
+static std::size_t bruteCount(const sista::Field& field, const sista::Rectangle& area) {
+    std::size_t count = 0;
+    for (int y = area.origin.y; y < area.origin.y + area.height; y++)
+        for (int x = area.origin.x; x < area.origin.x + area.width; x++)
+            count += field.getPawn(sista::Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x))) != nullptr;
+    return count;
+}
+
+// Runs random additions, moves, swaps and removals, checking the bitboard and the counts
+static bool randomWalk(sista::SwappableField& field, int width, int height, std::mt19937& random) {
+    std::vector<std::shared_ptr<sista::Pawn>> pawns;
+    for (int k = 0; k < width * height / 3; k++) {
+        sista::Coordinates coordinates(random() % height, random() % width);
+        if (field.isOccupied(coordinates))
+            continue;
+        pawns.push_back(std::make_shared<sista::Pawn>('a' + k % 26, coordinates, sista::ANSISettings()));
+        field.addPawn(pawns.back());
+    }
+    for (int tick = 0; tick < 40; tick++) {
+        for (const auto& pawn : pawns) {
+            if (field.getPawn(pawn->getCoordinates()) != pawn.get())
+                continue; // Removed
+            sista::Coordinates target = field.movingByCoordinates(pawn.get(), random() % 3 - 1, random() % 3 - 1, sista::Effect::PACMAN);
+            if (tick % 2 == 0 && field.isFree(target))
+                field.movePawn(pawn.get(), target);
+            else if (tick % 2 == 1)
+                field.addPawnToSwap(pawn.get(), target);
+        }
+        field.applySwaps();
+        if (tick % 10 == 9) // Some pawns leave the field
+            field.removePawn(pawns[random() % pawns.size()].get());
+        for (int query = 0; query < 20; query++) {
+            sista::Rectangle area(sista::Coordinates(random() % height, random() % width),
+                                  static_cast<unsigned short>(random() % 150), static_cast<unsigned short>(random() % 40));
+            sista::Rectangle clipped(area.origin, static_cast<unsigned short>(std::min<int>(area.width, width - area.origin.x)),
+                                     static_cast<unsigned short>(std::min<int>(area.height, height - area.origin.y)));
+            std::size_t count = bruteCount(field, clipped);
+            if (field.countPawnsIn(area) != count || field.isEmpty(area) != (count == 0))
+                return false;
+        }
+    }
+    if (!consistent(field, width, height) || field.countPawnsIn(sista::Rectangle(sista::Coordinates(0, 0), width, height))
+        != bruteCount(field, sista::Rectangle(sista::Coordinates(0, 0), width, height)))
+        return false;
+    field.clear();
+    return field.isEmpty(sista::Rectangle(sista::Coordinates(0, 0), width, height)) && consistent(field, width, height);
+}
+
+
+int main() {
+    std::cout << "Testing the occupancy bitboard..." << std::endl;
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(44);
+
+    // Every mutator keeps the bitboard in sync, in both layouts and across word and chunk boundaries
+    sista::SwappableField dense(130, 37, sista::Storage::DENSE);
+    sista::SwappableField chunked(130, 37, sista::Storage::CHUNKED);
+    expect(randomWalk(dense, 130, 37, random), "a dense field keeps its bitboard in sync and counts rectangles");
+    expect(randomWalk(chunked, 130, 37, random), "a chunked field keeps its bitboard in sync and counts rectangles");
+
+    // Counting over a huge sparse field visits the allocated chunks, not the area
+    sista::Field sparse(60000, 60000);
+    for (unsigned short i = 0; i < 1000; i++)
+        sparse.addPawn(std::make_shared<sista::Pawn>('#', sista::Coordinates(static_cast<unsigned short>(i * 59), static_cast<unsigned short>(i * 37)), sista::ANSISettings()));
+    auto start = std::chrono::steady_clock::now();
+    std::size_t all = sparse.countPawnsIn(sista::Rectangle(sista::Coordinates(0, 0), 60000, 60000));
+    std::size_t half = sparse.countPawnsIn(sista::Rectangle(sista::Coordinates(0, 0), 60000, 59 * 500));
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    expect(all == 1000 && half == 500 && sparse.isEmpty(sista::Rectangle(sista::Coordinates(1, 0), 58, 58)),
+        "a 60000x60000 field counts its pawns from the allocated chunks");
+    std::cout << "  " << elapsed << " us to count the pawns of 3.6 billion cells twice" << std::endl;
+
+    // Counting a dense board is faster than testing each cell
+    sista::Field board(200, 60, sista::Storage::DENSE);
+    for (int k = 0; k < 4000; k++) {
+        sista::Coordinates coordinates(random() % 60, random() % 200);
+        if (board.isFree(coordinates))
+            board.addPawn(std::make_shared<sista::Pawn>('o', coordinates, sista::ANSISettings()));
+    }
+    sista::Rectangle area(sista::Coordinates(0, 0), 200, 60);
+    std::size_t fast = 0, slow = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++)
+        fast += board.countPawnsIn(area);
+    auto fastTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++)
+        slow += bruteCount(board, area);
+    auto slowTime = std::chrono::steady_clock::now() - start;
+    expect(fast == slow, "popcount counts match the cell-by-cell counts");
+    std::cout << "  " << std::chrono::duration_cast<std::chrono::microseconds>(fastTime).count() << " us with popcount, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(slowTime).count() << " us cell by cell" << std::endl;
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
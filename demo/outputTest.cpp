@@ -0,0 +1,224 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include "../include/sista/sista.hpp"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <fcntl.h>
+
+static std::string readAll(int fd) { // Reads whatever is available in the pipe
+    std::string result;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+        result.append(buffer, n);
+    return result;
+}
+#endif
+
+static void drawFrame(sista::Field& field, int frame) { // Prints the field and moves the pawn
+    field.print('#');
+    sista::Pawn* pawn = field.getPawn(0, frame % 10);
+    if (pawn != nullptr)
+        field.movePawn(pawn, 0, (frame + 1) % 10);
+}
+
+
+int main() {
+    std::cout << "Testing output streams and sinks..." << std::endl;
+
+    // Test 1: the output stream can be redirected per thread
+    std::string expected;
+    {
+        sista::Field reference(10, 5);
+        reference.addPawn(std::make_shared<sista::Pawn>('X', sista::Coordinates(0, 0), sista::ANSISettings()));
+        std::ostringstream captured;
+        {
+            sista::OutputRedirect redirect(captured);
+            for (int frame = 0; frame < 3; frame++)
+                drawFrame(reference, frame);
+        }
+        expected = captured.str();
+        if (expected.empty() || &sista::getOutputStream() != &std::cout) {
+            std::cerr << "✗ Test 1 failed: output was not redirected and restored" << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 1 passed: OutputRedirect captures and restores the output stream" << std::endl;
+    }
+
+#if !defined(_WIN32)
+    // Test 2: FileDescriptorSink delivers the frames with writev
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            return 1;
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        sista::Field copy(10, 5);
+        copy.addPawn(std::make_shared<sista::Pawn>('X', sista::Coordinates(0, 0), sista::ANSISettings()));
+        {
+            sista::FileDescriptorSink sink(fds[1], 16); // Tiny buffer to exercise growth
+            sista::OutputRedirect redirect(sink.stream());
+            for (int frame = 0; frame < 3; frame++) {
+                drawFrame(copy, frame);
+                sink.present();
+            }
+            if (sink.pending() || sink.delivered() != expected.size()) {
+                std::cerr << "✗ Test 2 failed: the sink did not deliver every byte" << std::endl;
+                return 1;
+            }
+        }
+        std::string received = readAll(fds[0]);
+        close(fds[0]);
+        close(fds[1]);
+        if (received != expected) {
+            std::cerr << "✗ Test 2 failed: bytes differ from the captured output" << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 2 passed: FileDescriptorSink writes the exact frames" << std::endl;
+    }
+#endif
+
+#ifdef SISTA_HAS_IO_URING
+    // Test 3: UringSink batches many sessions through one context
+    {
+        sista::UringContext context(8, 64); // Small buffers so that a frame spans several of them
+        if (!context.available()) {
+            std::cout << "- Test 3 skipped: io_uring is not available on this system" << std::endl;
+        } else {
+            const int sessions = 3;
+            int fds[sessions][2];
+            for (auto& pair : fds) {
+                if (pipe(pair) != 0)
+                    return 1;
+                fcntl(pair[0], F_SETFL, O_NONBLOCK);
+            }
+            std::string received[sessions];
+            {
+                std::vector<std::unique_ptr<sista::Field>> fields;
+                std::vector<std::unique_ptr<sista::OutputSink>> sinks;
+                for (int i = 0; i < sessions; i++) {
+                    sinks.push_back(sista::makeAsyncSink(context, fds[i][1]));
+                    sista::OutputRedirect redirect(sinks.back()->stream());
+                    fields.push_back(std::make_unique<sista::Field>(10, 5)); // Cursor hides itself into the sink
+                    fields.back()->addPawn(std::make_shared<sista::Pawn>('X', sista::Coordinates(0, 0), sista::ANSISettings()));
+                }
+                for (int frame = 0; frame < 3; frame++) {
+                    for (int i = 0; i < sessions; i++) {
+                        sista::OutputRedirect redirect(sinks[i]->stream());
+                        drawFrame(*fields[i], frame);
+                        sinks[i]->present();
+                    }
+                    context.submit(); // One system call for every session
+                    while (context.writesInFlight() > 0)
+                        context.reap(true);
+                    for (int i = 0; i < sessions; i++)
+                        received[i] += readAll(fds[i][0]);
+                }
+                for (int i = 0; i < sessions; i++) {
+                    sista::OutputRedirect redirect(sinks[i]->stream());
+                    fields[i].reset(); // The Cursor shows itself again
+                    sinks[i]->present();
+                }
+                context.submit();
+                while (context.writesInFlight() > 0)
+                    context.reap(true);
+            }
+            for (int i = 0; i < sessions; i++) {
+                received[i] += readAll(fds[i][0]);
+                close(fds[i][0]);
+                close(fds[i][1]);
+                std::string wanted = std::string(HIDE_CURSOR) + expected + SHOW_CURSOR;
+                if (received[i] != wanted) {
+                    std::cerr << "✗ Test 3 failed: session " << i << " received different bytes" << std::endl;
+                    return 1;
+                }
+            }
+            std::cout << "✓ Test 3 passed: UringSink delivers every session in order" << std::endl;
+        }
+    }
+
+    // Test 4: makeAsyncSink falls back to writev without io_uring
+    {
+        sista::UringContext unavailable(0, 0);
+        int fds[2];
+        if (pipe(fds) != 0)
+            return 1;
+        std::unique_ptr<sista::OutputSink> sink = sista::makeAsyncSink(unavailable, fds[1]);
+        if (unavailable.available() || dynamic_cast<sista::FileDescriptorSink*>(sink.get()) == nullptr) {
+            std::cerr << "✗ Test 4 failed: no writev fallback" << std::endl;
+            return 1;
+        }
+        sink.reset();
+        close(fds[0]);
+        close(fds[1]);
+        std::cout << "✓ Test 4 passed: makeAsyncSink falls back to FileDescriptorSink" << std::endl;
+    }
+
+    // Test 5: sinks finding no free buffer keep their frames in a backlog instead of blocking
+    {
+        sista::UringContext context(2, 64); // Fewer buffers than sinks, each frame spans many of them
+        if (!context.available()) {
+            std::cout << "- Test 5 skipped: io_uring is not available on this system" << std::endl;
+        } else {
+            const int sessions = 3;
+            int fds[sessions][2];
+            for (auto& pair : fds) {
+                if (pipe(pair) != 0)
+                    return 1;
+                fcntl(pair[0], F_SETFL, O_NONBLOCK);
+            }
+            std::string sent[sessions], received[sessions];
+            {
+                std::vector<std::unique_ptr<sista::OutputSink>> sinks;
+                for (int i = 0; i < sessions; i++)
+                    sinks.push_back(sista::makeAsyncSink(context, fds[i][1]));
+                for (int frame = 0; frame < 4; frame++) {
+                    for (int i = 0; i < sessions; i++) {
+                        std::string bytes;
+                        for (int k = 0; k < 40; k++)
+                            bytes += "session " + std::to_string(i) + " frame " + std::to_string(frame) + " line " + std::to_string(k) + "\n";
+                        sinks[i]->stream() << bytes; // Every sink holds a buffer while the next one encodes
+                        sent[i] += bytes;
+                    }
+                    for (int i = 0; i < sessions; i++) {
+                        if (!sinks[i]->present()) {
+                            std::cerr << "✗ Test 5 failed: present reported an error" << std::endl;
+                            return 1;
+                        }
+                    }
+                    context.submit();
+                }
+                for (int round = 0; round < 10000; round++) { // The backlogs drain as the buffers are recycled
+                    bool pending = false;
+                    for (int i = 0; i < sessions; i++) {
+                        received[i] += readAll(fds[i][0]);
+                        pending = pending || sinks[i]->pending();
+                    }
+                    if (!pending)
+                        break;
+                    context.reap(true);
+                    context.submit();
+                }
+            }
+            bool same = true;
+            for (int i = 0; i < sessions; i++) {
+                received[i] += readAll(fds[i][0]);
+                close(fds[i][0]);
+                close(fds[i][1]);
+                same = same && received[i] == sent[i];
+            }
+            if (!same) {
+                std::cerr << "✗ Test 5 failed: a session received different bytes" << std::endl;
+                return 1;
+            }
+            std::cout << "✓ Test 5 passed: an exhausted buffer pool delays the frames without blocking" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+int main() {
+    std::cout << "Testing PerformanceOverlay..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    sista::ANSISettings style(sista::ForegroundColor::GREEN, sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT);
+
+    sista::VirtualTerminal terminal(12, 40);
+    sista::OutputRedirect redirect(terminal.stream());
+    sista::PerformanceOverlay overlay(2, 20, style, 16);
+    sista::Field field(10, 3);
+    auto pawn = std::make_shared<sista::Pawn>('P', sista::Coordinates(0, 0), sista::ANSISettings());
+    field.addPawn(pawn);
+
+    // The first frame draws every line of the overlay at its position
+    overlay.frame();
+    expect(terminal.line(1).substr(19) == "FPS         0.0"
+        && terminal.line(4).substr(19, 5) == "bytes"
+        && terminal.line(5).substr(19, 5) == "dirty", "the first frame draws the whole overlay");
+    expect(terminal.at(1, 19).foreground == (sista::Cell::INDEXED | 2)
+        && terminal.at(1, 19).attributes == (1 << 1), "the overlay is drawn with its ANSISettings");
+    sista::getOutputStream() << "\x1b[10;1Hz" << std::flush; // Unstyled text printed after the overlay
+    expect(terminal.at(9, 0).symbol == U'z' && terminal.at(9, 0).foreground == (sista::Cell::INDEXED | 7)
+        && terminal.at(9, 0).attributes == 0, "the style of the overlay is reset after it, not leaking into the following output");
+
+    // Frame times and dirty cells are measured between frames
+    std::size_t before = terminal.bytesConsumed();
+    for (int i = 0; i < 4; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        field.movePawn(pawn.get(), sista::Coordinates(0, i % 2));
+        sista::addStat(sista::Stat::BYTES_EMITTED, 100);
+        overlay.frame();
+    }
+    expect(overlay.getDirtyCells() == 2 && overlay.getBytesPerFrame() == 100,
+        "dirty cells and bytes are the difference of the render statistics");
+    expect(overlay.getFramesPerSecond() > 0 && overlay.getFramesPerSecond() < 1000
+        && overlay.getFrameTime(50) >= 2 && overlay.getFrameTime(50) <= overlay.getFrameTime(99),
+        "frame rate and percentiles are computed from the frame times");
+    expect(terminal.line(4).substr(19) == "bytes       100" && terminal.line(5).substr(19) == "dirty         2",
+        "the overlay shows the last frame");
+
+    // Incremental updates leave the same screen as a full redraw
+    sista::VirtualTerminal full(12, 40);
+    {
+        sista::OutputRedirect fullRedirect(full.stream());
+        overlay.redraw();
+    }
+    std::size_t redrawBytes = full.bytesConsumed();
+    bool same = true;
+    for (int row = 1; row < 1 + (int)sista::PerformanceOverlay::LINES; row++)
+        for (int column = 19; column < 19 + (int)sista::PerformanceOverlay::WIDTH; column++)
+            same = same && terminal.at(row, column) == full.at(row, column);
+    expect(same, "incremental updates match a full redraw");
+    std::size_t steady = terminal.bytesConsumed();
+    overlay.frame(); // Same bytes and dirty cells, only the timings may change
+    expect(terminal.bytesConsumed() - steady < redrawBytes, "a steady frame writes less than a full redraw");
+    expect((terminal.bytesConsumed() - before) / 5 < redrawBytes, "updates only write the changed spans");
+
+    // Toggling erases and restores the overlay
+    overlay.toggle();
+    expect(!overlay.isEnabled() && terminal.line(1).size() <= 19 && terminal.line(5).size() <= 19,
+        "disabling the overlay erases it");
+    steady = terminal.bytesConsumed();
+    overlay.frame();
+    expect(terminal.bytesConsumed() == steady, "a disabled overlay writes nothing");
+    overlay.toggle();
+    expect(overlay.isEnabled() && terminal.line(1).substr(19, 3) == "FPS", "enabling the overlay draws it again");
+
+    if (failures == 0)
+        std::cout << "\nAll tests passed! ✓" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
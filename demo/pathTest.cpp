@@ -0,0 +1,208 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+// Dijkstra over every cell with the rules of PathFinder, returning the cost to `to` or 0 if unreachable
+static std::uint32_t referenceCost(const sista::Field& field, sista::Coordinates from, sista::Coordinates to, bool eight, bool wrap) {
+    int width = field.getWidth(), height = field.getHeight();
+    auto walkable = [&](int y, int x) {
+        if (wrap) {
+            y = (y + height) % height;
+            x = (x + width) % width;
+        } else if (y < 0 || y >= height || x < 0 || x >= width) {
+            return false;
+        }
+        sista::Coordinates cell(y, x);
+        return cell == from || cell == to || !field.isOccupied(cell);
+    };
+    std::vector<std::uint32_t> cost(static_cast<std::size_t>(width) * height, UINT32_MAX);
+    using Entry = std::pair<std::uint32_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    cost[from.y * width + from.x] = 0;
+    open.push({0, from.y * width + from.x});
+    while (!open.empty()) {
+        auto [distance, index] = open.top();
+        open.pop();
+        if (distance != cost[index])
+            continue;
+        int y = index / width, x = index % width;
+        if (y == to.y && x == to.x)
+            return distance;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                bool diagonal = dy != 0 && dx != 0;
+                if ((dy == 0 && dx == 0) || (diagonal && !eight) || !walkable(y + dy, x + dx))
+                    continue;
+                if (diagonal && (!walkable(y + dy, x) || !walkable(y, x + dx)))
+                    continue;
+                int next = ((y + dy + height) % height) * width + (x + dx + width) % width;
+                std::uint32_t step = diagonal ? sista::PathFinder::DIAGONAL_COST : sista::PathFinder::ORTHOGONAL_COST;
+                if (distance + step < cost[next]) {
+                    cost[next] = distance + step;
+                    open.push({cost[next], next});
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Checks that every step of a path moves to a neighbouring free cell and ends at the goal
+static bool validPath(const sista::Field& field, sista::Coordinates from, sista::Coordinates to,
+                      const std::vector<sista::Coordinates>& path, bool eight, bool wrap) {
+    int width = field.getWidth(), height = field.getHeight();
+    sista::Coordinates previous = from;
+    for (const sista::Coordinates& cell : path) {
+        int dy = std::abs(cell.y - previous.y), dx = std::abs(cell.x - previous.x);
+        if (wrap) {
+            dy = std::min(dy, height - dy);
+            dx = std::min(dx, width - dx);
+        }
+        if (dy > 1 || dx > 1 || dy + dx == 0 || (!eight && dy + dx > 1))
+            return false;
+        if (!(cell == to) && field.isOccupied(cell))
+            return false;
+        previous = cell;
+    }
+    return !path.empty() && path.back() == to;
+}
+
+
+int main() {
+    std::cout << "Testing path finding..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(46);
+
+    // A*, and Jump Point Search on 8-connected fields, find paths as short as Dijkstra's
+    for (bool wrap : {false, true}) {
+        for (int density : {10, 30}) {
+            int mismatches = 0, invalid = 0, reachable = 0;
+            for (int round = 0; round < 20; round++) {
+                sista::Field field(37, 23);
+                std::vector<std::shared_ptr<sista::Pawn>> pawns;
+                for (int y = 0; y < 23; y++)
+                    for (int x = 0; x < 37; x++)
+                        if (static_cast<int>(random() % 100) < density)
+                            pawns.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, x), sista::ANSISettings()));
+                for (const auto& pawn : pawns)
+                    field.addPawn(pawn);
+                sista::Effect effect = wrap ? sista::Effect::PACMAN : sista::Effect::CLAMP;
+                for (int query = 0; query < 10; query++) {
+                    sista::Coordinates from(random() % 23, random() % 37), to(random() % 23, random() % 37);
+                    if (from == to)
+                        continue;
+                    struct { sista::Connectivity connectivity; sista::PathSearch algorithm; } cases[3] = {
+                        {sista::Connectivity::FOUR, sista::PathSearch::ASTAR},
+                        {sista::Connectivity::EIGHT, sista::PathSearch::ASTAR},
+                        {sista::Connectivity::EIGHT, sista::PathSearch::JUMP_POINT}};
+                    for (const auto& search : cases) {
+                        bool eight = search.connectivity == sista::Connectivity::EIGHT;
+                        std::uint32_t expected = referenceCost(field, from, to, eight, wrap);
+                        std::vector<sista::Coordinates> path;
+                        sista::PathFinder finder(field, search.connectivity, effect);
+                        bool found = finder.findPath(from, to, path, search.algorithm);
+                        if (found != (expected != 0) || (found && finder.pathCost(from, path) != expected))
+                            mismatches++;
+                        if (found && !validPath(field, from, to, path, eight, wrap))
+                            invalid++;
+                        reachable += found;
+                    }
+                }
+            }
+            expect(mismatches == 0 && invalid == 0 && reachable > 0, std::string(wrap ? "PACMAN" : "bounded") + " fields with "
+                + std::to_string(density) + "% walls: " + std::to_string(reachable) + " shortest paths, "
+                + std::to_string(mismatches) + " mismatches, " + std::to_string(invalid) + " invalid");
+        }
+    }
+
+    // The start and the goal may be occupied, walls are not crossed, and the edges wrap only with PACMAN
+    {
+        sista::Field field(10, 5);
+        std::vector<std::shared_ptr<sista::Pawn>> wall;
+        for (int y = 0; y < 5; y++) {
+            wall.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, 5), sista::ANSISettings()));
+            field.addPawn(wall.back());
+        }
+        auto hunter = std::make_shared<sista::Pawn>('H', sista::Coordinates(2, 1), sista::ANSISettings());
+        auto prey = std::make_shared<sista::Pawn>('P', sista::Coordinates(2, 8), sista::ANSISettings());
+        field.addPawn(hunter);
+        field.addPawn(prey);
+        std::vector<sista::Coordinates> path = {sista::Coordinates(0, 0)};
+        expect(!field.findPath(hunter->getCoordinates(), prey->getCoordinates(), path) && path.empty(),
+            "a wall across a bounded field leaves no path");
+        expect(field.findPath(hunter->getCoordinates(), prey->getCoordinates(), path, sista::Connectivity::FOUR, sista::Effect::PACMAN)
+            && path.size() == 3 && path.front() == sista::Coordinates(2, 0) && path[1] == sista::Coordinates(2, 9),
+            "PACMAN paths cross the edge of the field");
+        expect(field.findPath(hunter->getCoordinates(), prey->getCoordinates(), path, sista::Connectivity::EIGHT, sista::Effect::PACMAN,
+            sista::PathSearch::JUMP_POINT) && path.size() == 3 && path.back() == prey->getCoordinates(),
+            "Jump Point Search expands the jumps into every cell of the path");
+        expect(field.findPath(hunter->getCoordinates(), hunter->getCoordinates(), path) && path.empty(), "a path to the start is empty");
+        expect(!field.findPath(hunter->getCoordinates(), sista::Coordinates(5, 0), path), "a goal out of bounds has no path");
+    }
+
+    // Large fields hash their nodes, without allocating for the area
+    {
+        sista::Field field(60000, 60000);
+        std::vector<std::shared_ptr<sista::Pawn>> wall;
+        for (int y = 29990; y < 30010; y++) {
+            wall.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, 30005), sista::ANSISettings()));
+            field.addPawn(wall.back());
+        }
+        std::vector<sista::Coordinates> path;
+        bool found = field.findPath(sista::Coordinates(30000, 30000), sista::Coordinates(30000, 30010), path,
+            sista::Connectivity::EIGHT, sista::Effect::CLAMP, sista::PathSearch::JUMP_POINT);
+        expect(found && validPath(field, sista::Coordinates(30000, 30000), sista::Coordinates(30000, 30010), path, true, false),
+            "a 60000x60000 field finds a path around a wall in " + std::to_string(path.size()) + " steps");
+    }
+
+    // Repeated queries reuse the buffers of the thread
+    {
+        sista::Field field(120, 40);
+        std::vector<std::shared_ptr<sista::Pawn>> pawns;
+        for (int k = 0; k < 1200; k++) {
+            sista::Coordinates cell(random() % 40, random() % 120);
+            if (field.isFree(cell)) {
+                pawns.push_back(std::make_shared<sista::Pawn>('#', cell, sista::ANSISettings()));
+                field.addPawn(pawns.back());
+            }
+        }
+        std::vector<sista::Coordinates> path;
+        std::vector<std::pair<sista::Coordinates, sista::Coordinates>> queries;
+        for (int k = 0; k < 200; k++)
+            queries.push_back({sista::Coordinates(random() % 40, random() % 120), sista::Coordinates(random() % 40, random() % 120)});
+        for (int pass = 0; pass < 2; pass++) { // The first pass grows the buffers, the second one must not allocate
+            counting = pass == 1;
+            for (const auto& query : queries) {
+                field.findPath(query.first, query.second, path, sista::Connectivity::FOUR, sista::Effect::PACMAN);
+                field.findPath(query.first, query.second, path, sista::Connectivity::EIGHT, sista::Effect::CLAMP, sista::PathSearch::JUMP_POINT);
+            }
+            counting = false;
+        }
+        expect(allocations == 0, "400 queries after the first ones made " + std::to_string(allocations) + " allocations");
+
+        // Jump Point Search skips the symmetric paths of open areas
+        auto time = [&](sista::PathSearch algorithm) {
+            auto begin = std::chrono::steady_clock::now();
+            for (const auto& query : queries)
+                field.findPath(query.first, query.second, path, sista::Connectivity::EIGHT, sista::Effect::CLAMP, algorithm);
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        };
+        long long astar = time(sista::PathSearch::ASTAR), jumping = time(sista::PathSearch::JUMP_POINT);
+        std::cout << "  200 queries on 120x40 with 1200 walls: A* " << astar << "us, Jump Point Search " << jumping << "us" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
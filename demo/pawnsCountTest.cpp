@@ -99,6 +99,31 @@ int main() {
         }
     }
     
+    // Test 6: movePawn leaves a count of 0 at the old cell, so two pawns heading there conflict
+    {
+        sista::SwappableField field(5, 5);
+        auto pawn1 = std::make_shared<sista::Pawn>('X', sista::Coordinates(2, 2), sista::ANSISettings());
+        auto pawn2 = std::make_shared<sista::Pawn>('A', sista::Coordinates(1, 2), sista::ANSISettings());
+        auto pawn3 = std::make_shared<sista::Pawn>('B', sista::Coordinates(2, 1), sista::ANSISettings());
+        field.addPawn(pawn1);
+        field.addPawn(pawn2);
+        field.addPawn(pawn3);
+        field.movePawn(pawn1.get(), sista::Coordinates(3, 3));
+
+        // With a count of -1 at (2, 2), both moves would be accepted
+        field.addPawnToSwap(pawn2.get(), sista::Coordinates(2, 2));
+        field.addPawnToSwap(pawn3.get(), sista::Coordinates(2, 2));
+        field.applySwaps();
+        bool secondMoved = pawn2->getCoordinates() == sista::Coordinates(2, 2);
+        bool thirdMoved = pawn3->getCoordinates() == sista::Coordinates(2, 2);
+        if (secondMoved != thirdMoved) {
+            std::cout << "✓ Test 6 passed: movePawn empties the count of the old cell" << std::endl;
+        } else {
+            std::cerr << "✗ Test 6 failed: the count of the old cell is not 0" << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "\nAll tests passed! ✓" << std::endl;
     return 0;
 }
@@ -0,0 +1,181 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+// Counts the cells where the regions differ from a breadth-first labelling of a set of cells
+static int mismatches(const sista::Regions& regions, const std::vector<char>& set, int width, int height, bool eight) {
+    std::vector<int> reference(set.size(), 0);
+    std::vector<int> sizes(1, 0), queue;
+    for (int start = 0; start < width * height; start++) {
+        if (!set[start] || reference[start] != 0)
+            continue;
+        int label = static_cast<int>(sizes.size());
+        sizes.push_back(0);
+        reference[start] = label;
+        queue.assign(1, start);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            int y = queue[head] / width, x = queue[head] % width;
+            sizes[label]++;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int row = y + dy, column = x + dx;
+                    if ((dy != 0 && dx != 0 && !eight) || row < 0 || row >= height || column < 0 || column >= width)
+                        continue;
+                    if (set[row * width + column] && reference[row * width + column] == 0) {
+                        reference[row * width + column] = label;
+                        queue.push_back(row * width + column);
+                    }
+                }
+            }
+        }
+    }
+    // The labels must match one to one, with the same sizes
+    int wrong = regions.getRegionCount() != sizes.size() - 1;
+    std::vector<std::uint32_t> toLabel(sizes.size(), sista::Regions::NONE);
+    std::vector<int> toReference;
+    const std::vector<std::uint32_t>& labels = regions.getLabels();
+    for (int cell = 0; cell < width * height; cell++) {
+        std::uint32_t label = labels[cell];
+        if ((label == sista::Regions::NONE) != (reference[cell] == 0)) {
+            wrong++;
+            continue;
+        }
+        if (label == sista::Regions::NONE)
+            continue;
+        if (toReference.size() <= label)
+            toReference.resize(label + 1, 0);
+        if (toLabel[reference[cell]] == sista::Regions::NONE && toReference[label] == 0) {
+            toLabel[reference[cell]] = label;
+            toReference[label] = reference[cell];
+        }
+        wrong += toLabel[reference[cell]] != label || toReference[label] != reference[cell]
+            || regions.getRegionSize(label) != static_cast<std::size_t>(sizes[reference[cell]]);
+    }
+    return wrong;
+}
+
+
+int main() {
+    std::cout << "Testing regions..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(49);
+
+    // The labellings and the edits match a breadth-first labelling
+    for (bool eight : {false, true}) {
+        for (bool occupied : {false, true}) {
+            const int width = 83, height = 31; // Rows of more than one word of the bitmap
+            int labelled = 0, edited = 0, predicate = 0;
+            for (int round = 0; round < 4; round++) {
+                sista::Field field(width, height);
+                std::vector<std::shared_ptr<sista::Pawn>> pawns;
+                std::vector<char> set(width * height, !occupied);
+                for (int y = 0; y < height; y++) {
+                    for (int x = 0; x < width; x++) {
+                        if (random() % 100 < 40) {
+                            pawns.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, x), sista::ANSISettings()));
+                            field.addPawn(pawns.back());
+                            set[y * width + x] = occupied;
+                        }
+                    }
+                }
+                sista::Regions regions(field, eight ? sista::Connectivity::EIGHT : sista::Connectivity::FOUR);
+                if (occupied)
+                    regions.labelOccupied();
+                else
+                    regions.labelFree();
+                labelled += mismatches(regions, set, width, height, eight);
+
+                for (int change = 0; change < 400; change++) {
+                    sista::Coordinates cell(random() % height, random() % width);
+                    bool inSet = random() % 2;
+                    regions.setMember(cell, inSet);
+                    set[cell.y * width + cell.x] = inSet;
+                    if (change % 50 == 49)
+                        edited += mismatches(regions, set, width, height, eight);
+                }
+
+                regions.label([&](const sista::Coordinates& cell) { return set[cell.y * width + cell.x] != 0; });
+                predicate += mismatches(regions, set, width, height, eight);
+            }
+            std::string name = std::string(eight ? "8-connected " : "4-connected ") + (occupied ? "occupied" : "free");
+            expect(labelled == 0, name + " cells are labelled as with breadth-first search (" + std::to_string(labelled) + " wrong)");
+            expect(edited == 0, name + " cells keep their regions through single edits (" + std::to_string(edited) + " wrong)");
+            expect(predicate == 0, name + " cells are labelled the same through a predicate (" + std::to_string(predicate) + " wrong)");
+        }
+    }
+
+    // A wall splits a room in two, and a door joins the halves again
+    {
+        sista::Field field(11, 5);
+        std::vector<std::shared_ptr<sista::Pawn>> wall;
+        for (int y = 0; y < 5; y++) {
+            wall.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, 5), sista::ANSISettings()));
+            field.addPawn(wall.back());
+        }
+        sista::Regions regions(field);
+        regions.labelFree();
+        bool split = regions.getRegionCount() == 2 && !regions.connected(sista::Coordinates(0, 0), sista::Coordinates(0, 10))
+            && regions.getRegionSize(regions.getLabel(sista::Coordinates(0, 0))) == 25;
+        field.removePawn(wall[2].get());
+        regions.update(sista::Coordinates(2, 5));
+        expect(split && regions.getRegionCount() == 1 && regions.connected(sista::Coordinates(0, 0), sista::Coordinates(4, 10))
+            && regions.getRegionSize(regions.getLabel(sista::Coordinates(2, 5))) == 51, "a door through a wall joins two rooms");
+        field.addPawn(wall[2]);
+        regions.update(sista::Coordinates(2, 5));
+        expect(regions.getRegionCount() == 2 && regions.getLabel(sista::Coordinates(2, 5)) == sista::Regions::NONE,
+            "closing the door splits them again");
+        expect(regions.getLabel(sista::Coordinates(5, 0)) == sista::Regions::NONE && !regions.connected(sista::Coordinates(2, 5), sista::Coordinates(2, 5)),
+            "cells out of bounds or out of the set are in no region");
+    }
+
+    // Labellings and edits reuse their buffers
+    {
+        const int width = 200, height = 200;
+        sista::Field field(width, height);
+        std::vector<std::shared_ptr<sista::Pawn>> pawns;
+        for (int k = 0; k < 16000; k++) {
+            sista::Coordinates cell(random() % height, random() % width);
+            if (field.isFree(cell)) {
+                pawns.push_back(std::make_shared<sista::Pawn>('#', cell, sista::ANSISettings()));
+                field.addPawn(pawns.back());
+            }
+        }
+        sista::Regions regions(field, sista::Connectivity::EIGHT);
+        std::vector<sista::Coordinates> changes;
+        for (int k = 0; k < 1000; k++)
+            changes.push_back(sista::Coordinates(random() % height, random() % width));
+        for (int pass = 0; pass < 2; pass++) { // The first pass grows the buffers, the second one must not allocate
+            counting = pass == 1;
+            regions.labelOccupied();
+            for (const sista::Coordinates& cell : changes)
+                regions.setMember(cell, regions.getLabel(cell) == sista::Regions::NONE);
+            counting = false;
+        }
+        expect(allocations == 0, "a labelling and 1000 edits after the first ones made " + std::to_string(allocations) + " allocations");
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < 10; k++)
+            regions.labelOccupied();
+        long long full = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / 10;
+        begin = std::chrono::steady_clock::now();
+        for (const sista::Coordinates& cell : changes)
+            regions.setMember(cell, regions.getLabel(cell) == sista::Regions::NONE);
+        long long edits = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "  200x200 with 40% occupied: labelling " << full << "us, 1000 edits " << edits << "us, "
+                  << regions.getRegionCount() << " regions" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <atomic>
+#include "../include/sista/sista.hpp"
+
+#ifdef SISTA_HAS_SESSION_SERVER
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+
+static int connectUnix(const std::string& path) { // Connects a blocking client to the Unix socket
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int connectTCP(unsigned short port) { // Connects a blocking client to the loopback port
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static std::string receive(int fd, std::size_t length) { // Reads exactly length bytes, or less on timeout
+    timeval timeout{2, 0}; // Never hang the CI if a frame is missing
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::string result(length, '\0');
+    std::size_t got = 0;
+    while (got < length) {
+        ssize_t n = read(fd, &result[got], length - got);
+        if (n <= 0)
+            break;
+        got += n;
+    }
+    result.resize(got);
+    return result;
+}
+
+static std::string expectedFrame(int column, bool first) { // Encodes the frame of a session locally
+    std::ostringstream captured;
+    sista::Field field(8, 4);
+    sista::OutputRedirect redirect(captured);
+    field.addPawn(std::make_shared<sista::Pawn>('@', sista::Coordinates(1, column), sista::ANSISettings()));
+    sista::clearScreen(first);
+    field.print('#');
+    return captured.str();
+}
+#endif
+
+
+int main() {
+#ifndef SISTA_HAS_SESSION_SERVER
+    std::cout << "SessionServer is not available on this platform, skipping" << std::endl;
+    return 0;
+#else
+    std::cout << "Testing SessionServer..." << std::endl;
+
+    // Test 1: the worker pool runs every iteration exactly once
+    {
+        sista::WorkerPool pool(3);
+        std::atomic<int> sum(0);
+        pool.run(1000, [&](std::size_t i) { sum += i; });
+        if (sum != 999 * 1000 / 2) {
+            std::cerr << "✗ Test 1 failed: sum is " << sum << std::endl;
+            return 1;
+        }
+        bool thrown = false;
+        try {
+            pool.run(10, [](std::size_t i) { if (i == 7) throw std::runtime_error("iteration 7"); });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        if (!thrown) {
+            std::cerr << "✗ Test 1 failed: the exception was not rethrown" << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 1 passed: WorkerPool runs parallel loops" << std::endl;
+    }
+
+    std::string path = "/tmp/sista-serverTest-" + std::to_string(getpid()) + ".sock";
+    sista::SessionServer server(3);
+    server.listenUnix(path);
+    unsigned short port = server.listenTCP(0);
+
+    std::map<unsigned, std::unique_ptr<sista::Field>> fields; // One Field per player
+    std::map<unsigned, std::string> inputs;
+    unsigned disconnected = 0;
+    std::stringstream silenced; // Field's Cursor hides and shows itself on the current stream
+    server.onConnect([&](sista::Session& session) {
+        sista::OutputRedirect redirect(silenced);
+        fields[session.getId()] = std::make_unique<sista::Field>(8, 4);
+        fields[session.getId()]->addPawn(std::make_shared<sista::Pawn>('@', sista::Coordinates(1, 0), sista::ANSISettings()));
+        session.setField(fields[session.getId()].get());
+    });
+    server.onInput([&](sista::Session& session, const char* data, std::size_t length) {
+        inputs[session.getId()].append(data, length);
+        if (std::string(data, length).find('q') != std::string::npos)
+            session.close();
+    });
+    server.onDisconnect([&](sista::Session& session) {
+        disconnected++;
+        sista::OutputRedirect redirect(silenced);
+        session.setField(nullptr);
+        fields.erase(session.getId());
+    });
+
+    // Test 2: Unix and TCP clients get a session each
+    int clients[3] = {connectUnix(path), connectUnix(path), connectTCP(port)};
+    for (int fd : clients) {
+        if (fd < 0) {
+            std::cerr << "✗ Test 2 failed: could not connect" << std::endl;
+            return 1;
+        }
+    }
+    for (int i = 0; i < 100 && server.sessionCount() < 3; i++)
+        server.poll(10);
+    if (server.sessionCount() != 3) {
+        std::cerr << "✗ Test 2 failed: " << server.sessionCount() << " sessions" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 2 passed: Unix and TCP clients are accepted" << std::endl;
+
+    // Test 3: every client receives the frame of its own Field
+    const std::string first = expectedFrame(0, true);
+    const std::string second = expectedFrame(1, false);
+    server.render('#');
+    for (int fd : clients) {
+        if (receive(fd, first.size()) != first) {
+            std::cerr << "✗ Test 3 failed: first frame differs" << std::endl;
+            return 1;
+        }
+    }
+    for (auto& entry : fields) {
+        sista::OutputRedirect redirect(silenced);
+        entry.second->movePawn(entry.second->getPawn(1, 0), 1, 1);
+    }
+    server.render('#');
+    for (int fd : clients) {
+        if (receive(fd, second.size()) != second) {
+            std::cerr << "✗ Test 3 failed: second frame differs" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✓ Test 3 passed: frames are rendered per session" << std::endl;
+
+    // Test 4: input reaches the session, which can close itself
+    if (write(clients[0], "wasd", 4) != 4 || write(clients[2], "q", 1) != 1)
+        return 1;
+    for (int i = 0; i < 100 && (inputs.size() < 2 || server.sessionCount() > 2); i++)
+        server.poll(10);
+    bool delivered = inputs.size() == 2;
+    for (auto& entry : inputs)
+        delivered = delivered && (entry.second == "wasd" || entry.second == "q");
+    if (!delivered || server.sessionCount() != 2 || disconnected != 1) {
+        std::cerr << "✗ Test 4 failed: input was not delivered or the session was not closed" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 4 passed: input is delivered and sessions can close themselves" << std::endl;
+
+    // Test 5: a client hanging up closes its session
+    close(clients[1]);
+    for (int i = 0; i < 100 && server.sessionCount() > 1; i++)
+        server.poll(10);
+    if (server.sessionCount() != 1 || disconnected != 2) {
+        std::cerr << "✗ Test 5 failed: the session of the closed client is still open" << std::endl;
+        return 1;
+    }
+    server.render('#'); // Rendering after hang-ups must not raise SIGPIPE
+    std::cout << "✓ Test 5 passed: hang-ups close the session" << std::endl;
+
+    close(clients[0]);
+    close(clients[2]);
+
+    // Test 6: sessions submitting through io_uring, with fewer buffers than sessions
+    {
+        sista::SessionServer async(2);
+        bool uring = async.enableAsyncOutput(2, 64); // Each frame spans many buffers
+        std::string asyncPath = path + ".async";
+        async.listenUnix(asyncPath);
+        sista::OutputRedirect quiet(silenced); // The Fields show the cursor again when destroyed
+        std::map<unsigned, std::unique_ptr<sista::Field>> asyncFields;
+        async.onConnect([&](sista::Session& session) {
+            sista::OutputRedirect redirect(silenced);
+            asyncFields[session.getId()] = std::make_unique<sista::Field>(8, 4);
+            asyncFields[session.getId()]->addPawn(std::make_shared<sista::Pawn>('@', sista::Coordinates(1, 0), sista::ANSISettings()));
+            session.setField(asyncFields[session.getId()].get());
+        });
+        int asyncClients[2] = {connectUnix(asyncPath), connectUnix(asyncPath)};
+        for (int i = 0; i < 100 && async.sessionCount() < 2; i++)
+            async.poll(10);
+        const std::string still = expectedFrame(0, false);
+        const std::string frames = first + still + still;
+        for (int frame = 0; frame < 3; frame++)
+            async.render('#');
+        for (int i = 0; i < 100; i++) // The frames left in the backlogs go out as the writes complete
+            async.poll(1);
+        bool same = async.sessionCount() == 2;
+        for (int fd : asyncClients) {
+            same = same && receive(fd, frames.size()) == frames;
+            close(fd);
+        }
+        if (!same) {
+            std::cerr << "✗ Test 6 failed: frames differ through " << (uring ? "io_uring" : "writev") << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 6 passed: sessions render through " << (uring ? "io_uring" : "the writev fallback") << std::endl;
+    }
+
+    // Test 7: a spectator hanging up leaves the BroadcastChannel its session subscribed to
+    {
+        sista::SessionServer spectators(1);
+        std::string spectatorPath = path + ".spectators";
+        spectators.listenUnix(spectatorPath);
+        sista::BroadcastChannel channel; // Destroyed first, while a session is still subscribed
+        channel.publishKeyframe(std::make_shared<const std::string>("keyframe"));
+        spectators.onConnect([&](sista::Session& session) {
+            channel.subscribe(session.getSink());
+        });
+        int watchers[2] = {connectUnix(spectatorPath), connectUnix(spectatorPath)};
+        for (int i = 0; i < 100 && spectators.sessionCount() < 2; i++)
+            spectators.poll(10);
+        bool joined = channel.subscriberCount() == 2;
+        close(watchers[0]);
+        for (int i = 0; i < 100 && spectators.sessionCount() > 1; i++)
+            spectators.poll(10);
+        bool left = spectators.sessionCount() == 1 && channel.subscriberCount() == 1;
+        channel.publish(std::make_shared<const std::string>("delta")); // Must not reach the destroyed sink
+        spectators.poll(10);
+        bool received = receive(watchers[1], 13) == "keyframedelta";
+        close(watchers[1]);
+        if (!joined || !left || !received) {
+            std::cerr << "✗ Test 7 failed: the closed session is still subscribed, or the frames differ" << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 7 passed: closed sessions leave their channels" << std::endl;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+#endif
+}
@@ -0,0 +1,168 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <random>
+#include <memory_resource>
+#include "../include/sista/sista.hpp"
+
+/** \brief Forwards to another resource, counting the bytes still allocated. */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t bytes = 0;
+    std::size_t peak = 0;
+    std::pmr::memory_resource* upstream;
+
+    explicit CountingResource(std::pmr::memory_resource* upstream_): upstream(upstream_) {}
+
+protected:
+    void* do_allocate(std::size_t size, std::size_t alignment) override {
+        bytes += size;
+        peak = std::max(peak, bytes);
+        return upstream->allocate(size, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override {
+        bytes -= size;
+        upstream->deallocate(pointer, size, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+
+int main() {
+    std::cout << "Testing sparse fields..." << std::endl;
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+    CountingResource counting(std::pmr::new_delete_resource());
+    std::mt19937 random(2025);
+
+    // Test 1: a 60000x60000 field with 10000 pawns takes memory for the pawns, not for the area
+    sista::SwappableField field(60000, 60000, &counting);
+    std::vector<std::shared_ptr<sista::Pawn>> pawns;
+    while (pawns.size() < 10000) {
+        sista::Coordinates coordinates(random() % 60000, random() % 60000);
+        if (field.isOccupied(coordinates))
+            continue;
+        pawns.push_back(std::make_shared<sista::Pawn>('P', coordinates, sista::ANSISettings()));
+        field.addPawn(pawns.back());
+    }
+    if (counting.bytes > 32u << 20) {
+        std::cerr << "✗ Test 1 failed: " << counting.bytes << " bytes for 10000 pawns" << std::endl;
+        return 1;
+    }
+    for (const auto& pawn : pawns) {
+        if (field.getPawn(pawn->getCoordinates()) != pawn.get()) {
+            std::cerr << "✗ Test 1 failed: a pawn is not found at its coordinates" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✓ Test 1 passed: " << counting.bytes / 1024 << " KiB for 10000 pawns on 60000x60000 cells" << std::endl;
+
+    // Test 2: moves and swaps across chunks keep the grid consistent
+    for (int tick = 0; tick < 20; tick++) {
+        for (const auto& pawn : pawns) {
+            sista::Coordinates coordinates = pawn->getCoordinates();
+            coordinates.x = static_cast<unsigned short>((coordinates.x + 7) % 60000); // Often into the next chunk
+            if (tick % 2)
+                field.addPawnToSwap(pawn.get(), coordinates);
+            else if (field.isFree(coordinates))
+                field.movePawn(pawn.get(), coordinates);
+        }
+        field.applySwaps();
+    }
+    for (const auto& pawn : pawns) {
+        if (field.getPawn(pawn->getCoordinates()) != pawn.get()) {
+            std::cerr << "✗ Test 2 failed: a pawn is not found at its coordinates" << std::endl;
+            return 1;
+        }
+    }
+    std::size_t occupied = 0;
+    for (const auto& pawn : pawns) // Neighbours of every pawn, most of them empty
+        for (int dx = -3; dx <= 3; dx++)
+            occupied += field.isOccupied(sista::Coordinates(pawn->getCoordinates().y, static_cast<unsigned short>(pawn->getCoordinates().x + dx)));
+    if (occupied < pawns.size()) {
+        std::cerr << "✗ Test 2 failed: " << occupied << " occupied cells around the pawns" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 2 passed: movePawn and applySwaps across chunks" << std::endl;
+
+    // Test 3: conflicting swaps are rejected as on a dense field, one pawn moves
+    {
+        auto first = std::make_shared<sista::Pawn>('A', sista::Coordinates(59990, 59990), sista::ANSISettings());
+        auto second = std::make_shared<sista::Pawn>('B', sista::Coordinates(59990, 59992), sista::ANSISettings());
+        field.removePawn(field.getPawn(first->getCoordinates()));
+        field.removePawn(field.getPawn(second->getCoordinates()));
+        field.removePawn(field.getPawn(sista::Coordinates(59990, 59991)));
+        field.addPawn(first);
+        field.addPawn(second);
+        field.addPawnToSwap(first.get(), sista::Coordinates(59990, 59991));
+        field.addPawnToSwap(second.get(), sista::Coordinates(59990, 59991));
+        field.applySwaps();
+        bool firstMoved = field.getPawn(sista::Coordinates(59990, 59991)) == first.get() && field.getPawn(sista::Coordinates(59990, 59992)) == second.get();
+        bool secondMoved = field.getPawn(sista::Coordinates(59990, 59991)) == second.get() && field.getPawn(sista::Coordinates(59990, 59990)) == first.get();
+        if (firstMoved == secondMoved) {
+            std::cerr << "✗ Test 3 failed: the conflict was not resolved" << std::endl;
+            return 1;
+        }
+        field.removePawn(first.get());
+        field.removePawn(second.get());
+    }
+    std::cout << "✓ Test 3 passed: conflicting swaps are rejected" << std::endl;
+
+    // Test 4: empty chunks are kept for reuse until shrink() frees them
+    std::size_t peak = counting.peak;
+    for (const auto& pawn : pawns)
+        field.removePawn(pawn.get());
+    field.shrink();
+    if (counting.bytes * 4 > peak) { // Only the chunk directories and the swap scratch storage are left
+        std::cerr << "✗ Test 4 failed: " << counting.bytes << " bytes left after removing every pawn" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 4 passed: " << counting.bytes / 1024 << " KiB left of " << peak / 1024 << " KiB after removing every pawn" << std::endl;
+
+    // Test 5: dense and chunked fields render the same moves and swaps identically
+    {
+        sista::SwappableField dense(100, 40, sista::Storage::DENSE);
+        sista::SwappableField chunked(100, 40, sista::Storage::CHUNKED);
+        sista::Field automatic(100, 40);
+        if (dense.getStorage() != sista::Storage::DENSE || chunked.getStorage() != sista::Storage::CHUNKED
+            || automatic.getStorage() != sista::Storage::DENSE || field.getStorage() != sista::Storage::CHUNKED) {
+            std::cerr << "✗ Test 5 failed: the fields don't use the requested layouts" << std::endl;
+            return 1;
+        }
+        sista::VirtualTerminal screens[2] = {sista::VirtualTerminal(44, 104), sista::VirtualTerminal(44, 104)};
+        sista::SwappableField* fields[2] = {&dense, &chunked};
+        for (int i = 0; i < 2; i++) {
+            std::mt19937 moves(99); // The same moves on both fields
+            std::vector<std::shared_ptr<sista::Pawn>> board;
+            sista::OutputRedirect redirect(screens[i].stream());
+            for (int k = 0; k < 600; k++) {
+                sista::Coordinates coordinates(moves() % 40, moves() % 100);
+                if (fields[i]->isOccupied(coordinates))
+                    continue;
+                board.push_back(std::make_shared<sista::Pawn>('a' + k % 26, coordinates, sista::ANSISettings()));
+                fields[i]->addPawn(board.back());
+            }
+            for (int tick = 0; tick < 30; tick++) {
+                for (const auto& pawn : board) {
+                    sista::Coordinates target = fields[i]->movingByCoordinates(pawn.get(), moves() % 3 - 1, moves() % 3 - 1, sista::Effect::PACMAN);
+                    if (tick % 3 == 0 && fields[i]->isFree(target))
+                        fields[i]->movePawn(pawn.get(), target);
+                    else if (tick % 3 != 0)
+                        fields[i]->addPawnToSwap(pawn.get(), target);
+                }
+                fields[i]->applySwaps();
+            }
+            fields[i]->print('#');
+        }
+        if (!screens[0].sameScreen(screens[1])) {
+            std::cerr << "✗ Test 5 failed: " << screens[0].countDifferences(screens[1]) << " cells differ" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✓ Test 5 passed: dense and chunked fields behave the same" << std::endl;
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
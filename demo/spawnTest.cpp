@@ -0,0 +1,112 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <unordered_set>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// Checks that the cells are distinct, free and as many as expected
+static bool validSample(const sista::Field& field, const std::vector<sista::Coordinates>& cells, std::size_t count) {
+    std::unordered_set<sista::Coordinates> distinct(cells.begin(), cells.end());
+    if (cells.size() != count || distinct.size() != count)
+        return false;
+    for (const sista::Coordinates& cell : cells)
+        if (!field.isFree(cell))
+            return false;
+    return true;
+}
+
+// Samples cells many times, checking that every free cell comes up as often as the others
+static bool uniform(const sista::Field& field, int width, int height, std::size_t count, std::mt19937& random) {
+    std::vector<int> hits(width * height, 0);
+    const int draws = 20000;
+    for (int draw = 0; draw < draws; draw++) {
+        std::vector<sista::Coordinates> cells = field.sampleFreeCells(count, random);
+        if (!validSample(field, cells, count))
+            return false;
+        for (const sista::Coordinates& cell : cells)
+            hits[cell.y * width + cell.x]++;
+    }
+    int freeCells = 0;
+    for (int i = 0; i < width * height; i++)
+        freeCells += field.isFree(sista::Coordinates(i / width, i % width));
+    double expected = static_cast<double>(draws) * count / freeCells;
+    for (int i = 0; i < width * height; i++)
+        if (field.isFree(sista::Coordinates(i / width, i % width)) && (hits[i] < expected * 0.85 || hits[i] > expected * 1.15))
+            return false;
+    return true;
+}
+
+
+int main() {
+    std::cout << "Testing free-cell search and sampling..." << std::endl;
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(45);
+
+    // The first free cell is found across words, rows and chunks
+    for (sista::Storage storage : {sista::Storage::DENSE, sista::Storage::CHUNKED}) {
+        sista::Field field(150, 20, storage);
+        for (unsigned short y = 0; y < 20; y++)
+            for (unsigned short x = 0; x < 150; x++)
+                if (!(y == 13 && x == 97) && !(y == 2 && x == 149))
+                    field.addPawn(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, x), sista::ANSISettings()));
+        sista::Coordinates cell;
+        bool first = field.findFreeCell(cell) && cell == sista::Coordinates(2, 149);
+        bool inArea = field.findFreeCellIn(sista::Rectangle(sista::Coordinates(5, 90), 100, 100), cell) && cell == sista::Coordinates(13, 97);
+        bool none = !field.findFreeCellIn(sista::Rectangle(sista::Coordinates(14, 0), 150, 6), cell);
+        std::vector<sista::Coordinates> all = field.sampleFreeCells(10, random);
+        expect(first && inArea && none && validSample(field, all, 2),
+            std::string("findFreeCell and findFreeCellIn scan a ") + (storage == sista::Storage::DENSE ? "dense" : "chunked") + " field");
+    }
+
+    // Sampling is uniform, both drawing cells on a mostly free field and selecting ranks on a crowded one
+    sista::Field sparse(7, 5), crowded(7, 5);
+    for (int i = 0; i < 35; i++) {
+        sista::Coordinates cell(i / 7, i % 7);
+        if (i % 5 == 0)
+            sparse.addPawn(std::make_shared<sista::Pawn>('s', cell, sista::ANSISettings()));
+        if (i % 4 != 0)
+            crowded.addPawn(std::make_shared<sista::Pawn>('c', cell, sista::ANSISettings()));
+    }
+    expect(uniform(sparse, 7, 5, 2, random), "sampling a mostly free field is uniform");
+    expect(uniform(crowded, 7, 5, 3, random), "sampling a crowded field is uniform");
+
+    // Spawning on a nearly full board costs a scan of its bitboard
+    sista::Field board(200, 60);
+    std::vector<sista::Coordinates> free;
+    for (unsigned short y = 0; y < 60; y++)
+        for (unsigned short x = 0; x < 200; x++)
+            if (random() % 100 < 97)
+                board.addPawn(std::make_shared<sista::Pawn>('o', sista::Coordinates(y, x), sista::ANSISettings()));
+    std::size_t freeCount = 200 * 60 - board.countPawnsIn(sista::Rectangle(sista::Coordinates(0, 0), 200, 60));
+    auto start = std::chrono::steady_clock::now();
+    std::vector<sista::Coordinates> spawned = board.sampleFreeCells(freeCount / 2, random);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    expect(validSample(board, spawned, freeCount / 2), "sampling half of the free cells of a 97% full board");
+    std::cout << "  " << elapsed << " us to pick " << spawned.size() << " of " << freeCount << " free cells" << std::endl;
+
+    // A huge sparse field draws cells without scanning it
+    sista::Field huge(60000, 60000);
+    huge.addPawn(std::make_shared<sista::Pawn>('H', sista::Coordinates(0, 0), sista::ANSISettings()));
+    start = std::chrono::steady_clock::now();
+    std::vector<sista::Coordinates> scattered = huge.sampleFreeCells(5000, random);
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    expect(validSample(huge, scattered, 5000), "sampling a 60000x60000 field");
+    std::cout << "  " << elapsed << " us to pick 5000 cells of 3.6 billion" << std::endl;
+
+    // Empty fields and empty samples draw nothing
+    sista::Field flat(0, 5), thin(5, 0);
+    expect(flat.sampleFreeCells(3, random).empty() && thin.sampleFreeCells(3, random).empty() && sparse.sampleFreeCells(0, random).empty(),
+        "sampling a field with no cells, or sampling no cells, picks none");
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// The bounds and the wrap-around are constant expressions
+static_assert(sista::StaticField<8, 8>::wrapX(-1) == 7 && sista::StaticField<8, 8>::wrapY(8) == 0, "masked wrap");
+static_assert(sista::StaticField<10, 6>::wrapX(-23) == 7 && sista::StaticField<10, 6>::wrapY(-7) == 5, "modulo wrap");
+static_assert(sista::StaticField<80, 24>::isOutOfBounds(-1, 0) && sista::StaticField<80, 24>::isOutOfBounds(0, 80)
+    && !sista::StaticField<80, 24>::isOutOfBounds(23, 79), "bounds");
+static_assert(sista::StaticField<80, 24>::index(1, 2) == 82, "row-major index");
+
+// Runs the same random walk on a Field and a StaticField, returning whether the screens match
+template <unsigned short N>
+static bool sameAsField(std::mt19937& random) {
+    sista::Field field(N, N);
+    sista::StaticField<N, N> board;
+    sista::VirtualTerminal screens[2] = {sista::VirtualTerminal(N + 4, N + 4), sista::VirtualTerminal(N + 4, N + 4)};
+    std::vector<std::shared_ptr<sista::Pawn>> pawns[2];
+    for (int k = 0; k < N * N / 4; k++) {
+        sista::Coordinates coordinates(random() % N, random() % N);
+        if (field.isOccupied(coordinates))
+            continue;
+        sista::ANSISettings settings(static_cast<sista::ForegroundColor>(30 + k % 8), sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT);
+        pawns[0].push_back(std::make_shared<sista::Pawn>('a' + k % 26, coordinates, settings));
+        pawns[1].push_back(std::make_shared<sista::Pawn>('a' + k % 26, coordinates, settings));
+        field.addPawn(pawns[0].back());
+        board.addPawn(pawns[1].back());
+    }
+    {
+        sista::OutputRedirect redirect(screens[0].stream());
+        field.print();
+    }
+    {
+        sista::OutputRedirect redirect(screens[1].stream());
+        board.print();
+    }
+    for (int tick = 0; tick < 50; tick++) {
+        for (std::size_t i = 0; i < pawns[0].size(); i++) {
+            short dy = static_cast<short>(random() % 3) - 1, dx = static_cast<short>(random() % 3) - 1;
+            sista::Effect effect = random() % 2 ? sista::Effect::PACMAN : sista::Effect::MATRIX;
+            sista::Coordinates expected;
+            try {
+                expected = field.movingByCoordinates(pawns[0][i].get(), dy, dx, effect);
+            } catch (const std::range_error&) {
+                try {
+                    board.movingByCoordinates(pawns[1][i].get(), dy, dx, effect);
+                    return false; // Both must reject the same moves
+                } catch (const std::range_error&) {
+                    continue;
+                }
+            }
+            if (!(board.movingByCoordinates(pawns[1][i].get(), dy, dx, effect) == expected))
+                return false;
+            if (!field.isFree(expected))
+                continue;
+            {
+                sista::OutputRedirect redirect(screens[0].stream());
+                field.movePawn(pawns[0][i].get(), expected);
+            }
+            {
+                sista::OutputRedirect redirect(screens[1].stream());
+                board.movePawn(pawns[1][i].get(), expected);
+            }
+        }
+    }
+    for (const auto& pawn : pawns[1])
+        if (board.getPawn(pawn->getCoordinates()) != pawn.get())
+            return false;
+    return screens[0].sameScreen(screens[1]);
+}
+
+
+int main() {
+    std::cout << "Testing StaticField..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(41);
+
+    // The same operations produce the same screen as a Field
+    expect(sameAsField<16>(random), "a 16x16 StaticField (masked wrap) renders the same moves as a Field");
+    expect(sameAsField<10>(random), "a 10x10 StaticField (modulo wrap) renders the same moves as a Field");
+
+    // PACMAN wraps moves of any length, also on boards that aren't square
+    sista::StaticField<10, 6> board;
+    auto pawn = std::make_shared<sista::Pawn>('P', sista::Coordinates(0, 0), sista::ANSISettings());
+    board.addPawn(pawn);
+    board.movePawnBy(pawn.get(), -7, -23, sista::Effect::PACMAN);
+    expect(pawn->getCoordinates() == sista::Coordinates(5, 7) && board.getPawn(5, 7) == pawn.get()
+        && board.getPawn(0, 0) == nullptr, "PACMAN wraps long negative moves");
+    board.movePawnBy(pawn.get(), -1, 3, sista::Effect::MATRIX);
+    expect(pawn->getCoordinates() == sista::Coordinates(5, 0), "MATRIX continues on the next row");
+
+    // The errors are the ones of Field
+    bool outOfRange = false, occupied = false, outOfMatrix = false;
+    try {
+        board.addPawn(std::make_shared<sista::Pawn>('X', sista::Coordinates(6, 0), sista::ANSISettings()));
+    } catch (const std::out_of_range&) {
+        outOfRange = true;
+    }
+    try {
+        board.addPawn(std::make_shared<sista::Pawn>('X', pawn->getCoordinates(), sista::ANSISettings()));
+    } catch (const std::invalid_argument&) {
+        occupied = true;
+    }
+    try {
+        board.movePawnBy(pawn.get(), 1, 0, sista::Effect::MATRIX);
+    } catch (const std::out_of_range&) {
+        outOfMatrix = true;
+    }
+    expect(outOfRange && occupied && outOfMatrix, "invalid additions and moves throw like Field");
+    board.clear();
+    expect(board.isFree(sista::Coordinates(5, 0)) && !board.isFree(sista::Coordinates(6, 0)), "clear empties every cell");
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
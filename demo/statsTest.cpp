@@ -0,0 +1,131 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "../include/sista/sista.hpp"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+
+int main() {
+    std::cout << "Testing render statistics..." << std::endl;
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+    sista::resetStats();
+
+    // Test 1: a full print counts every cell and the time spent encoding it
+    sista::SwappableField field(10, 4);
+    auto first = std::make_shared<sista::Pawn>('A', sista::Coordinates(0, 0), sista::ANSISettings());
+    auto second = std::make_shared<sista::Pawn>('B', sista::Coordinates(0, 2), sista::ANSISettings());
+    field.addPawn(first);
+    field.addPawn(second);
+    field.print('#');
+    sista::RenderStats stats = sista::getStats();
+    if (stats.cellsRedrawn != 40 || stats.styleSequences == 0 || stats.encodeNanoseconds == 0) {
+        std::cerr << "✗ Test 1 failed: " << stats.cellsRedrawn << " cells, "
+                  << stats.styleSequences << " SGR sequences" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 1 passed: Field::print is counted" << std::endl;
+
+    // Test 2: incremental updates count cursor jumps and redrawn cells
+    sista::resetStats();
+    field.movePawn(first.get(), sista::Coordinates(1, 0));
+    stats = sista::getStats();
+    if (stats.cursorJumps != 2 || stats.cellsRedrawn != 2 || stats.cursorSequences != 2) {
+        std::cerr << "✗ Test 2 failed: " << stats.cursorJumps << " jumps, "
+                  << stats.cellsRedrawn << " cells" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 2 passed: movePawn is counted" << std::endl;
+
+    // Test 3: simulateSwaps accepts one of two moves heading to the same cell
+    sista::resetStats();
+    field.addPawnToSwap(first.get(), sista::Coordinates(0, 1));
+    field.addPawnToSwap(second.get(), sista::Coordinates(0, 1));
+    field.applySwaps();
+    stats = sista::getStats();
+    if (stats.swapsAccepted != 1 || stats.swapsRejected != 1) {
+        std::cerr << "✗ Test 3 failed: " << stats.swapsAccepted << " accepted, "
+                  << stats.swapsRejected << " rejected" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 3 passed: accepted and rejected swaps are counted" << std::endl;
+
+    // Test 4: sinks count presented frames, emitted bytes and write time
+#if !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) != 0)
+        return 1;
+    sista::resetStats();
+    {
+        sista::FileDescriptorSink sink(fds[1]);
+        sista::OutputRedirect redirect(sink.stream());
+        sista::clearScreen();
+        sink.present();
+        field.print('#');
+        sink.present();
+    }
+    std::size_t bytes = 0;
+    char buffer[4096];
+    close(fds[1]);
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;)
+        bytes += n;
+    close(fds[0]);
+    stats = sista::getStats();
+    if (stats.framesPresented != 2 || stats.bytesEmitted != bytes || stats.eraseSequences != 2
+        || stats.writeNanoseconds == 0) {
+        std::cerr << "✗ Test 4 failed: " << stats.framesPresented << " frames, "
+                  << stats.bytesEmitted << " of " << bytes << " bytes" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 4 passed: presented frames and emitted bytes are counted" << std::endl;
+#else
+    std::cout << "FileDescriptorSink is not available on this platform, skipping Test 4" << std::endl;
+#endif
+
+    // Test 5: resetStats zeroes every counter
+    sista::resetStats();
+    stats = sista::getStats();
+    if (stats.framesPresented || stats.bytesEmitted || stats.styleSequences || stats.cursorSequences
+        || stats.cellsRedrawn || stats.swapsAccepted || stats.encodeNanoseconds || stats.writeNanoseconds) {
+        std::cerr << "✗ Test 5 failed: resetStats left some counters set" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 5 passed: resetStats zeroes the counters" << std::endl;
+
+    // Test 6: the counters of every thread are summed, while it runs and after it exits
+    sista::addStat(sista::Stat::CELLS_REDRAWN);
+    std::atomic<int> counted(0);
+    std::atomic<bool> release(false);
+    std::vector<std::thread> workers;
+    for (int k = 0; k < 4; k++) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < 1000; i++)
+                sista::addStat(sista::Stat::CELLS_REDRAWN);
+            counted++;
+            while (!release)
+                std::this_thread::yield();
+        });
+    }
+    while (counted < 4)
+        std::this_thread::yield();
+    std::uint64_t running = sista::getStats().cellsRedrawn;
+    release = true;
+    for (std::thread& worker : workers)
+        worker.join();
+    std::uint64_t exited = sista::getStats().cellsRedrawn;
+    sista::resetStats();
+    if (running != 4001 || exited != 4001 || sista::getStats().cellsRedrawn != 0) {
+        std::cerr << "✗ Test 6 failed: " << running << " cells while running, " << exited << " after exiting" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 6 passed: per-thread counters are summed" << std::endl;
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <random>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+template <typename Draw>
+static void render(sista::VirtualTerminal& terminal, Draw draw) { // Draws into the terminal
+    sista::OutputRedirect redirect(terminal.stream());
+    draw();
+}
+
+
+int main() {
+    std::cout << "Testing VirtualTerminal..." << std::endl;
+    std::ostringstream silenced; // Field's Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+
+    // Control sequences emitted by the library
+    {
+        sista::VirtualTerminal terminal(5, 10);
+        terminal.feed(CSI "2;3HAB" CSI "1;31mC" CSI "0m");
+        expect(terminal.line(1) == "  ABC", "CUP positions the cursor (1-based)");
+        expect(terminal.at(1, 4).foreground == (sista::Cell::INDEXED | 1)
+            && terminal.at(1, 4).attributes == (1 << 1), "SGR sets colors and attributes");
+        terminal.feed(CSI "38;2;1;2;3m" CSI "48;5;200mD" CSI "0m");
+        expect(terminal.at(1, 5).foreground == (sista::Cell::TRUE_COLOR | 0x010203)
+            && terminal.at(1, 5).background == (sista::Cell::INDEXED | 200), "SGR decodes 256 and true colors");
+        terminal.feed(CSI "1;1Hxy" CSI "3b");
+        expect(terminal.line(0) == "xyyyy", "REP repeats the last character");
+        terminal.feed(CSI "1;2H" CSI "2X");
+        expect(terminal.line(0) == "x  yy", "ECH erases characters without moving the cursor");
+        terminal.feed(CSI "1;4H" CSI "K");
+        expect(terminal.line(0) == "x", "EL erases to the end of the line");
+        terminal.feed(CLS TL);
+        expect(terminal.text() == std::string(5, '\n') && terminal.getCursorRow() == 0, "ED clears the screen");
+        terminal.feed(HIDE_CURSOR "0123456789ab\n\xe2\x9c\x93");
+        expect(terminal.line(0) == "0123456789" && terminal.line(1) == "ab" && terminal.line(2) == "✓",
+            "Lines wrap, LF returns the carriage and UTF-8 is decoded");
+        expect(!terminal.isCursorVisible(), "DECTCEM hides the cursor");
+    }
+
+    // Scroll regions and character shifts
+    {
+        sista::VirtualTerminal terminal(5, 6);
+        terminal.feed("a\nb\nc\nd\ne");
+        terminal.feed(CSI "2;4r" CSI "1S");
+        expect(terminal.text() == "a\nc\nd\n\ne\n" && terminal.getCursorRow() == 0,
+            "SU scrolls only the rows of the DECSTBM region");
+        terminal.feed(CSI "2T");
+        expect(terminal.text() == "a\n\n\nc\ne\n", "SD scrolls the region down");
+        terminal.feed(CSI "4;1H\n\n");
+        expect(terminal.text() == "a\nc\n\n\ne\n" && terminal.getCursorRow() == 3, "LF scrolls at the bottom margin");
+        terminal.feed(CSI "r" CSI "1;1H" "012345" CSI "1;2H" CSI "2P");
+        expect(terminal.line(0) == "0345", "DCH deletes characters, shifting the line left");
+        terminal.feed(CSI "3@");
+        expect(terminal.line(0) == "0   34", "ICH inserts blanks, shifting the line right");
+    }
+
+    // A 256-color pawn is encoded as a number, not as a raw byte
+    {
+        sista::VirtualTerminal terminal(3, 10);
+        render(terminal, [] {
+            sista::setForegroundColor(static_cast<unsigned char>(202));
+            sista::getOutputStream() << 'Z';
+        });
+        expect(terminal.at(0, 0).symbol == U'Z' && terminal.at(0, 0).foreground == (sista::Cell::INDEXED | 202),
+            "setForegroundColor(unsigned char) emits a valid SGR");
+    }
+
+    // Incremental updates produce the same screen as a full print
+    {
+        const int width = 30, height = 12;
+        sista::SwappableField field(width, height);
+        std::mt19937 random(42);
+        std::vector<sista::ANSISettings> styles = {
+            sista::ANSISettings(sista::ForegroundColor::RED, sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT),
+            sista::ANSISettings(sista::RGBColor(10, 200, 30), sista::RGBColor(0, 0, 90), {sista::Attribute::ITALIC, sista::Attribute::UNDERSCORE}),
+            sista::ANSISettings(sista::ForegroundColor::CYAN, sista::RGBColor(40, 40, 40), sista::Attribute::REVERSE),
+        };
+        std::vector<sista::Pawn*> pawns;
+        for (int i = 0; i < 60; i++) {
+            sista::Coordinates coordinates(random() % height, random() % width);
+            if (field.isOccupied(coordinates))
+                continue;
+            auto pawn = std::make_shared<sista::Pawn>('A' + i % 26, coordinates, styles[i % styles.size()]);
+            field.addPawn(pawn);
+            pawns.push_back(pawn.get());
+        }
+        sista::VirtualTerminal incremental(height + 4, width + 4);
+        render(incremental, [&] {
+            sista::clearScreen();
+            field.print('#');
+        });
+        render(incremental, [&] {
+            for (int step = 0; step < 500; step++) {
+                sista::Pawn* pawn = pawns[random() % pawns.size()];
+                short dy = static_cast<short>(random() % 3) - 1;
+                short dx = static_cast<short>(random() % 3) - 1;
+                sista::Coordinates target = pawn->getCoordinates();
+                target.y = (target.y + dy + height) % height;
+                target.x = (target.x + dx + width) % width;
+                if (field.isFree(target))
+                    field.movePawn(pawn, target);
+            }
+            for (sista::Pawn* pawn : pawns) { // Every pawn tries to step right at once
+                sista::Coordinates target = pawn->getCoordinates();
+                target.x = (target.x + 1) % width;
+                field.addPawnToSwap(pawn, target);
+            }
+            field.applySwaps();
+        });
+        sista::VirtualTerminal full(height + 4, width + 4);
+        render(full, [&] {
+            sista::clearScreen();
+            field.print('#');
+        });
+        expect(incremental.sameScreen(full), "movePawn and applySwaps deltas match a full print");
+        std::cout << "  " << incremental.bytesConsumed() << " bytes and "
+                  << incremental.sequencesExecuted() << " sequences interpreted" << std::endl;
+
+        sista::Border border('@', sista::ANSISettings(sista::ForegroundColor::YELLOW, sista::BackgroundColor::BLUE, sista::Attribute::BRIGHT));
+        sista::VirtualTerminal bordered(height + 4, width + 4);
+        render(bordered, [&] {
+            sista::clearScreen();
+            field.print(border);
+        });
+        expect(bordered.at(1, 0).symbol == U'@' && bordered.at(1, 0).background == (sista::Cell::INDEXED | 4)
+            && bordered.countDifferences(full) >= static_cast<std::size_t>(2 * (width + height)),
+            "Field::print(Border&) draws a styled border");
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
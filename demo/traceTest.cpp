@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <cstdio>
+#include "../include/sista/sista.hpp"
+
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static std::size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1))
+        count++;
+    return count;
+}
+
+int main() {
+    std::cout << "Testing Chrome-trace export..." << std::endl;
+    const std::string path = "traceTest.json";
+    std::ostringstream silenced;
+    sista::OutputRedirect quiet(silenced);
+
+    // Test 1: scopes outside of a trace are not recorded
+    {
+        sista::TraceScope ignored("ignored");
+    }
+    if (sista::isTracing()) {
+        std::cerr << "✗ Test 1 failed: a trace is running before startTrace" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 1 passed: no trace runs before startTrace" << std::endl;
+
+    // Test 2: a second trace cannot start while one is running
+    if (!sista::startTrace(path) || sista::startTrace(path) || !sista::isTracing()) {
+        std::cerr << "✗ Test 2 failed: startTrace did not start exactly one trace" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 2 passed: only one trace runs at a time" << std::endl;
+
+    // Test 3: nested scopes on two threads, with the frame number
+    sista::setTraceFrame(7);
+    {
+        sista::TraceScope outer("outer");
+        sista::TraceScope inner("inner");
+    }
+    std::thread worker([]() {
+        sista::TraceScope other("worker");
+    });
+    worker.join();
+    sista::nextTraceFrame();
+    sista::SwappableField field(10, 4);
+    field.addPawn(std::make_shared<sista::Pawn>('A', sista::Coordinates(0, 0), sista::ANSISettings()));
+    field.print('#');
+    sista::stopTrace();
+
+    std::string trace = readFile(path);
+    std::remove(path.c_str());
+    if (trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) != 0
+        || trace.find("\n]}") == std::string::npos) {
+        std::cerr << "✗ Test 3 failed: the trace is not a Chrome Trace Event document" << std::endl;
+        return 1;
+    }
+    if (countOccurrences(trace, "\"ph\":\"X\"") < 3 || trace.find("\"name\":\"ignored\"") != std::string::npos
+        || trace.find("\"name\":\"outer\"") == std::string::npos
+        || trace.find("\"name\":\"inner\"") == std::string::npos
+        || trace.find("\"name\":\"worker\"") == std::string::npos
+        || trace.find("\"args\":{\"frame\":7}") == std::string::npos) {
+        std::cerr << "✗ Test 3 failed: missing events in\n" << trace << std::endl;
+        return 1;
+    }
+    std::size_t mainThread = trace.find("\"tid\":", trace.find("\"name\":\"outer\""));
+    std::size_t workerThread = trace.find("\"tid\":", trace.find("\"name\":\"worker\""));
+    if (trace.compare(mainThread, trace.find(',', mainThread) - mainThread,
+                      trace, workerThread, trace.find(',', workerThread) - workerThread) == 0) {
+        std::cerr << "✗ Test 3 failed: both threads have the same tid" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Test 3 passed: events carry their thread and frame" << std::endl;
+
+    // Test 4: the trace points of the library, when compiled
+    if (sista::isTraceCompiled()) {
+        if (trace.find("\"name\":\"Field::print\"") == std::string::npos
+            || trace.find("\"args\":{\"frame\":8}") == std::string::npos) {
+            std::cerr << "✗ Test 4 failed: Field::print was not traced" << std::endl;
+            return 1;
+        }
+        std::cout << "✓ Test 4 passed: Field::print is traced" << std::endl;
+    } else {
+        if (trace.find("\"name\":\"Field::print\"") != std::string::npos) {
+            std::cerr << "✗ Test 4 failed: Field::print was traced without SISTA_TRACE" << std::endl;
+            return 1;
+        }
+        std::cout << "The library was compiled without SISTA_TRACE, skipping the library trace points" << std::endl;
+    }
+
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
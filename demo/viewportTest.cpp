@@ -0,0 +1,163 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <vector>
+#include "../include/sista/sista.hpp"
+#include "check.hpp"
+
+// Checks that the window on screen shows exactly the cells of the field it covers
+static bool showsWindow(const sista::VirtualTerminal& terminal, const sista::Field& field, const sista::Viewport& viewport,
+                        int row, int column) {
+    for (int y = 0; y < viewport.getHeight(); y++) {
+        for (int x = 0; x < viewport.getWidth(); x++) {
+            sista::Pawn* pawn = field.getPawn(sista::Coordinates(viewport.getOrigin().y + y, viewport.getOrigin().x + x));
+            char32_t expected = pawn != nullptr ? static_cast<char32_t>(pawn->getSymbol()) : U' ';
+            if (terminal.at(row - 1 + y, column - 1 + x).symbol != expected)
+                return false;
+        }
+    }
+    return true;
+}
+
+
+int main() {
+    std::cout << "Testing Viewport..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+
+    sista::SwappableField field(2000, 2000);
+    auto player = std::make_shared<sista::Pawn>('@', sista::Coordinates(5, 5), sista::ANSISettings());
+    auto far = std::make_shared<sista::Pawn>('F', sista::Coordinates(1500, 1500), sista::ANSISettings());
+    field.addPawn(player);
+    field.addPawn(far);
+    for (unsigned short i = 0; i < 40; i++)
+        field.addPawn(std::make_shared<sista::Pawn>('#', sista::Coordinates(i, 2 * i + 1), sista::ANSISettings()));
+
+    sista::VirtualTerminal terminal(24, 80);
+    sista::OutputRedirect redirect(terminal.stream());
+    sista::Viewport viewport(field, 30, 12, 3, 5);
+    expect(field.getViewport() == &viewport, "the viewport attaches itself to the field");
+
+    // Printing draws the window only, at its screen position
+    sista::resetStats();
+    viewport.print();
+    expect(showsWindow(terminal, field, viewport, 3, 5), "print draws the window at its screen position");
+    expect(terminal.line(1).empty() && terminal.line(15).empty() && terminal.at(2, 3).symbol == U' ',
+        "print draws nothing outside the window");
+    expect(sista::getStats().cellsRedrawn == 30 * 12, "print redraws only the cells of the window");
+
+    // Moves inside the window are drawn at the translated position
+    field.movePawn(player.get(), sista::Coordinates(6, 7));
+    expect(terminal.at(2 + 6, 4 + 7).symbol == U'@' && terminal.at(2 + 5, 4 + 5).symbol == U' ',
+        "movePawn inside the window goes through the diff path");
+
+    // Mutations outside of the window are culled
+    std::size_t before = terminal.bytesConsumed();
+    field.movePawn(far.get(), sista::Coordinates(1501, 1500));
+    field.addPawnToSwap(far.get(), sista::Coordinates(1502, 1500));
+    field.applySwaps();
+    field.rePrintPawn(far.get());
+    expect(terminal.bytesConsumed() == before, "updates outside of the window emit nothing");
+
+    // Leaving the window clears the old cell and draws nothing else
+    field.movePawn(player.get(), sista::Coordinates(6, 40));
+    expect(terminal.at(2 + 6, 4 + 7).symbol == U' ' && showsWindow(terminal, field, viewport, 3, 5),
+        "moving out of the window clears the old cell");
+
+    // Scrolling redraws the new window, clamped inside the field
+    expect(viewport.follow(player->getCoordinates(), 3) && viewport.isVisible(player->getCoordinates())
+        && player->getCoordinates().x - viewport.getOrigin().x == 30 - 1 - 3, "follow keeps the target inside the margin");
+    expect(showsWindow(terminal, field, viewport, 3, 5), "scrolling redraws the window");
+    expect(!viewport.follow(player->getCoordinates(), 3), "follow doesn't scroll when the target is inside the margin");
+    viewport.scrollTo(sista::Coordinates(5000, 5000));
+    expect(viewport.getOrigin() == sista::Coordinates(2000 - 12, 2000 - 30), "scrollTo is clamped inside the field");
+    viewport.scrollBy(-3000, -3000);
+    expect(viewport.getOrigin() == sista::Coordinates(0, 0) && showsWindow(terminal, field, viewport, 3, 5),
+        "scrollBy is clamped inside the field");
+
+    // Accelerated horizontal scrolling leaves the rest of the row in place
+    viewport.setScrollAcceleration(true);
+    terminal.feed(CSI "4;40H|");
+    viewport.scrollBy(0, 2);
+    viewport.scrollBy(0, -1);
+    expect(showsWindow(terminal, field, viewport, 3, 5) && terminal.at(3, 39).symbol == U'|',
+        "accelerated horizontal scrolling keeps the cells right of the window");
+
+    // Erasing by coordinates clears the cell of the scrolled window, and culls the cells outside of it
+    {
+        viewport.scrollTo(sista::Coordinates(10, 20));
+        auto crate = std::make_shared<sista::Pawn>('C', sista::Coordinates(13, 24), sista::ANSISettings());
+        field.addPrintPawn(crate);
+        std::vector<char32_t> screen;
+        for (int y = 0; y < terminal.getRows(); y++)
+            for (int x = 0; x < 80; x++)
+                screen.push_back(terminal.at(y, x).symbol);
+        field.erasePawn(sista::Coordinates(13, 24));
+        int changed = 0;
+        for (int y = 0; y < terminal.getRows(); y++)
+            for (int x = 0; x < 80; x++)
+                changed += terminal.at(y, x).symbol != screen[y * 80 + x];
+        expect(changed == 1 && terminal.at(2 + 3, 4 + 4).symbol == U' ' && showsWindow(terminal, field, viewport, 3, 5),
+            "erasePawn by coordinates clears the cell at its window position only");
+        std::size_t before = terminal.bytesConsumed();
+        field.erasePawn(sista::Coordinates(1502, 1500));
+        expect(terminal.bytesConsumed() == before && field.getPawn(sista::Coordinates(1502, 1500)) == nullptr,
+            "erasePawn by coordinates outside of the window emits nothing");
+    }
+
+    // A window larger than the field is reduced to the field
+    {
+        sista::Field small(10, 4);
+        sista::Viewport large(small, 30, 12);
+        expect(large.getWidth() == 10 && large.getHeight() == 4, "the window never exceeds the field");
+    }
+
+    // Accelerated scrolling shifts the screen and matches a full print
+    {
+        sista::SwappableField map(300, 300);
+        std::mt19937 random(7);
+        std::vector<sista::ANSISettings> styles = {
+            sista::ANSISettings(sista::ForegroundColor::RED, sista::BackgroundColor::BLACK, sista::Attribute::BRIGHT),
+            sista::ANSISettings(sista::RGBColor(10, 200, 30), sista::RGBColor(0, 0, 90), sista::Attribute::ITALIC),
+        };
+        for (unsigned short y = 0; y < 300; y++)
+            for (unsigned short x = 0; x < 300; x++)
+                if (random() % 3 == 0)
+                    map.addPawn(std::make_shared<sista::Pawn>('a' + random() % 26, sista::Coordinates(y, x), styles[random() % 2]));
+        sista::VirtualTerminal panned(14, 40);
+        sista::OutputRedirect pannedRedirect(panned.stream());
+        sista::Viewport camera(map, 40, 12, 2, 1); // Whole rows of the terminal
+        camera.setScrollAcceleration(true);
+        camera.scrollTo(sista::Coordinates(100, 100));
+        std::size_t fullBytes = panned.bytesConsumed();
+        camera.print();
+        fullBytes = panned.bytesConsumed() - fullBytes;
+
+        const short steps[][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}, {1, 1}, {-2, 3}, {3, -2}, {0, 39}, {11, 0}};
+        bool same = true;
+        std::size_t panBytes = 0;
+        for (const auto& step : steps) {
+            std::size_t before = panned.bytesConsumed();
+            camera.scrollBy(step[0], step[1]);
+            if (step[0] == 1 && step[1] == 0)
+                panBytes = panned.bytesConsumed() - before;
+            sista::VirtualTerminal reference(14, 40);
+            {
+                sista::OutputRedirect referenceRedirect(reference.stream());
+                camera.print();
+            }
+            same = same && panned.sameScreen(reference);
+        }
+        expect(same, "accelerated scrolling produces the same screen as a full print");
+        expect(panBytes * 4 < fullBytes, "scrolling by a row emits a fraction of a full print");
+        std::cout << "  " << panBytes << " bytes to scroll by a row, " << fullBytes << " bytes for a full print" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
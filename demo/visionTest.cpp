@@ -0,0 +1,180 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "../include/sista/sista.hpp"
+#define SISTA_CHECK_ALLOCATIONS
+#include "check.hpp"
+
+// Fills a field with walls at random, returning their Pawns
+static std::vector<std::shared_ptr<sista::Pawn>> scatter(sista::Field& field, std::mt19937& random, int percent) {
+    std::vector<std::shared_ptr<sista::Pawn>> walls;
+    for (int y = 0; y < field.getHeight(); y++) {
+        for (int x = 0; x < field.getWidth(); x++) {
+            if (static_cast<int>(random() % 100) < percent) {
+                walls.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, x), sista::ANSISettings()));
+                field.addPawn(walls.back());
+            }
+        }
+    }
+    return walls;
+}
+
+
+int main() {
+    std::cout << "Testing field of view..." << std::endl;
+    std::ostringstream silenced; // Cursor hides and shows itself on the current stream
+    sista::OutputRedirect quiet(silenced);
+    std::mt19937 random(48);
+
+    // On an open field the view is the disc of the radius, clipped by the edges
+    {
+        sista::Field field(90, 30);
+        sista::FieldOfView view(field);
+        for (sista::Coordinates viewer : {sista::Coordinates(15, 45), sista::Coordinates(0, 0), sista::Coordinates(29, 80)}) {
+            view.compute(viewer, 12);
+            std::size_t expected = 0;
+            int wrong = 0;
+            for (int y = 0; y < 30; y++) {
+                for (int x = 0; x < 90; x++) {
+                    int dy = y - viewer.y, dx = x - viewer.x;
+                    bool inside = dy * dy + dx * dx <= 144;
+                    expected += inside;
+                    wrong += view.isVisible(sista::Coordinates(y, x)) != inside;
+                }
+            }
+            expect(wrong == 0 && view.countVisible() == expected, "an open view from (" + std::to_string(viewer.y) + ", "
+                + std::to_string(viewer.x) + ") sees the " + std::to_string(expected) + " cells of its radius");
+        }
+    }
+
+    // A wall is seen, and hides what is behind it
+    {
+        sista::Field field(20, 9);
+        std::vector<std::shared_ptr<sista::Pawn>> wall;
+        for (int y = 0; y < 9; y++) {
+            wall.push_back(std::make_shared<sista::Pawn>('#', sista::Coordinates(y, 10), sista::ANSISettings()));
+            field.addPawn(wall.back());
+        }
+        sista::FieldOfView view(field);
+        view.compute(sista::Coordinates(4, 2), 100);
+        bool behind = false, seen = true;
+        for (int y = 0; y < 9; y++) {
+            seen = seen && view.isVisible(sista::Coordinates(y, 10));
+            for (int x = 11; x < 20; x++)
+                behind = behind || view.isVisible(sista::Coordinates(y, x));
+        }
+        expect(seen && !behind, "a wall across the field is seen and hides the cells behind it");
+        expect(!view.lineOfSight(sista::Coordinates(4, 2), sista::Coordinates(4, 15))
+            && view.lineOfSight(sista::Coordinates(4, 2), sista::Coordinates(0, 10)), "a line of sight stops at the wall and reaches it");
+
+        view.setOpaque(sista::Coordinates(4, 10), false); // A door opens
+        view.compute(sista::Coordinates(4, 2), 100);
+        expect(view.isVisible(sista::Coordinates(4, 19)) && !view.isVisible(sista::Coordinates(0, 19)),
+            "an open door shows a cone behind the wall");
+        view.update(sista::Coordinates(4, 10)); // The Pawn is still there
+        expect(view.isOpaque(sista::Coordinates(4, 10)), "update reads the occupancy again");
+
+        view.refresh([](const sista::Pawn& pawn) { return pawn.getCoordinates().y != 4; }); // A window
+        view.compute(sista::Coordinates(4, 2), 100);
+        expect(view.isVisible(sista::Coordinates(4, 19)), "a predicate leaves some Pawns transparent");
+    }
+
+    // The views and the lines of sight are symmetric
+    {
+        int asymmetric = 0, lines = 0, pairs = 0;
+        for (int round = 0; round < 6; round++) {
+            sista::Field field(70, 25);
+            std::vector<std::shared_ptr<sista::Pawn>> walls = scatter(field, random, 20);
+            sista::FieldOfView view(field), other(field);
+            for (int query = 0; query < 40; query++) {
+                sista::Coordinates a(random() % 25, random() % 70), b(random() % 25, random() % 70);
+                if (view.isOpaque(a) || view.isOpaque(b))
+                    continue;
+                pairs++;
+                view.compute(a, 30);
+                other.compute(b, 30);
+                asymmetric += view.isVisible(b) != other.isVisible(a);
+                lines += view.lineOfSight(a, b) != view.lineOfSight(b, a);
+            }
+        }
+        expect(asymmetric == 0 && lines == 0 && pairs > 0, std::to_string(pairs) + " pairs of cells see each other both ways ("
+            + std::to_string(asymmetric) + " views and " + std::to_string(lines) + " lines asymmetric)");
+    }
+
+    // The batch of views matches the views one at a time
+    {
+        sista::Field field(150, 50);
+        std::vector<std::shared_ptr<sista::Pawn>> walls = scatter(field, random, 15);
+        sista::FieldOfView view(field);
+        std::vector<sista::Coordinates> viewers;
+        for (int k = 0; k < 60; k++)
+            viewers.push_back(sista::Coordinates(random() % 50, random() % 150));
+        std::vector<sista::Coordinates> cells;
+        std::vector<std::size_t> offsets;
+        view.compute(viewers, 10, cells, offsets);
+        int wrong = 0;
+        std::vector<char> any(150 * 50, 0);
+        for (std::size_t i = 0; i < viewers.size(); i++) {
+            view.compute(viewers[i], 10);
+            wrong += view.countVisible() != offsets[i + 1] - offsets[i]; // No cell is listed twice
+            for (std::size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+                wrong += !view.isVisible(cells[k]);
+                any[cells[k].y * 150 + cells[k].x] = 1;
+            }
+        }
+        view.compute(viewers, 10);
+        for (int y = 0; y < 50; y++)
+            for (int x = 0; x < 150; x++)
+                wrong += view.isVisible(sista::Coordinates(y, x)) != static_cast<bool>(any[y * 150 + x]);
+        expect(wrong == 0 && offsets.size() == viewers.size() + 1, "60 views listed at once match the views one by one and their union");
+
+        for (int pass = 0; pass < 2; pass++) { // The first pass grows the buffers, the second one must not allocate
+            counting = pass == 1;
+            view.compute(viewers, 10, cells, offsets);
+            for (const sista::Coordinates& viewer : viewers) {
+                view.compute(viewer, 10);
+                view.lineOfSight(viewer, viewers.front());
+            }
+            counting = false;
+        }
+        expect(allocations == 0, "120 views after the first ones made " + std::to_string(allocations) + " allocations");
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < 10; k++)
+            view.compute(viewers, 10, cells, offsets);
+        long long batch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / 10;
+        std::cout << "  60 views of radius 10 on 150x50 with 15% walls: " << batch << "us, " << cells.size() << " cells" << std::endl;
+    }
+
+    // Viewers out of bounds throw
+    {
+        sista::Field field(5, 5);
+        sista::FieldOfView view(field);
+        bool thrown = false;
+        try {
+            view.compute(sista::Coordinates(5, 0), 3);
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        expect(thrown && !view.lineOfSight(sista::Coordinates(0, 0), sista::Coordinates(0, 5)), "cells out of bounds are rejected");
+    }
+
+    // A cell sees itself, in a corner and when opaque
+    {
+        sista::Field field(10, 10);
+        sista::FieldOfView view(field);
+        view.setOpaque(sista::Coordinates(9, 9), true);
+        expect(view.lineOfSight(sista::Coordinates(0, 0), sista::Coordinates(0, 0)) && view.lineOfSight(sista::Coordinates(9, 9), sista::Coordinates(9, 9))
+            && view.lineOfSight(sista::Coordinates(0, 0), sista::Coordinates(0, 1)), "a line of sight from a cell to itself or its neighbour is clear");
+    }
+
+    if (failures > 0) {
+        std::cerr << "\n" << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed! ✓" << std::endl;
+    return 0;
+}
@@ -19,8 +19,9 @@
  * \copyright GNU General Public License v3.0
  */
 #include "ansi.hpp"
-#include <iostream>
-#include <sstream>
+#include "output.hpp"
+#include "stats.hpp"
+#include <cstdio> // std::snprintf
 
 
 namespace sista {
@@ -28,20 +29,24 @@ namespace sista {
     RGBColor::RGBColor(unsigned char red, unsigned char green, unsigned char blue) : red(red), green(green), blue(blue) {}
 
     void setForegroundColor(ForegroundColor color) {
-        std::cout << CSI << static_cast<int>(color) << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << static_cast<int>(color) << "m";
     }
     void setBackgroundColor(BackgroundColor color) {
-        std::cout << CSI << static_cast<int>(color) << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << static_cast<int>(color) << "m";
     }
     void setAttribute(Attribute attribute) {
-        std::cout << CSI << static_cast<int>(attribute) << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << static_cast<int>(attribute) << "m";
     }
     void resetAttribute(Attribute attribute) {
+        addStat(Stat::STYLE_SEQUENCES);
         if (attribute == Attribute::BRIGHT) {
-            std::cout << CSI << static_cast<int>(attribute) + 21 << "m";
+            getOutputStream() << CSI << static_cast<int>(attribute) + 21 << "m";
             return;
         }
-        std::cout << CSI << static_cast<int>(attribute) + 20 << "m";
+        getOutputStream() << CSI << static_cast<int>(attribute) + 20 << "m";
     }
 
     void resetAnsi() {
@@ -57,20 +62,24 @@ namespace sista {
         setBackgroundColor(rgbcolor.red, rgbcolor.green, rgbcolor.blue);
     }
     void setForegroundColor(unsigned char red, unsigned char green, unsigned char blue) {
-        std::cout << CSI << "38;2;" << static_cast<short int>(red) << ";";
-        std::cout << static_cast<short int>(green) << ";";
-        std::cout << static_cast<short int>(blue) << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << "38;2;" << static_cast<short int>(red) << ";";
+        getOutputStream() << static_cast<short int>(green) << ";";
+        getOutputStream() << static_cast<short int>(blue) << "m";
     }
     void setBackgroundColor(unsigned char red, unsigned char green, unsigned char blue) {
-        std::cout << CSI << "48;2;" << static_cast<short int>(red) << ";";
-        std::cout << static_cast<short int>(green) << ";";
-        std::cout << static_cast<short int>(blue) << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << "48;2;" << static_cast<short int>(red) << ";";
+        getOutputStream() << static_cast<short int>(green) << ";";
+        getOutputStream() << static_cast<short int>(blue) << "m";
     }
     void setForegroundColor(unsigned char color) {
-        std::cout << CSI << "38;5;" << color << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << "38;5;" << static_cast<short int>(color) << "m";
     }
     void setBackgroundColor(unsigned char color) {
-        std::cout << CSI << "48;5;" << color << "m";
+        addStat(Stat::STYLE_SEQUENCES);
+        getOutputStream() << CSI << "48;5;" << static_cast<short int>(color) << "m";
     }
 
     std::string fgColorStr(ForegroundColor color) {
@@ -82,40 +91,31 @@ namespace sista {
     std::string attrStr(Attribute attribute) {
         return CSI + std::to_string(static_cast<int>(attribute)) + "m";
     }
+    // The RGB sequences are formatted on the stack, so building one allocates only the returned string
     std::string fgColorStr(const RGBColor& color) {
-        std::ostringstream oss;
-        oss << CSI << "38;2;" << static_cast<short int>(color.red) << ";"
-            << static_cast<short int>(color.green) << ";"
-            << static_cast<short int>(color.blue) << "m";
-        return oss.str();
+        return fgColorStr(color.red, color.green, color.blue);
     }
     std::string bgColorStr(const RGBColor& color) {
-        std::ostringstream oss;
-        oss << CSI << "48;2;" << static_cast<short int>(color.red) << ";"
-            << static_cast<short int>(color.green) << ";"
-            << static_cast<short int>(color.blue) << "m";
-        return oss.str();
+        return bgColorStr(color.red, color.green, color.blue);
     }
     std::string fgColorStr(unsigned char red, unsigned char green, unsigned char blue) {
-        std::ostringstream oss;
-        oss << CSI << "38;2;" << static_cast<short int>(red) << ";"
-            << static_cast<short int>(green) << ";"
-            << static_cast<short int>(blue) << "m";
-        return oss.str();
+        char buffer[24];
+        int length = std::snprintf(buffer, sizeof(buffer), CSI "38;2;%d;%d;%dm", red, green, blue);
+        return std::string(buffer, length);
     }
     std::string bgColorStr(unsigned char red, unsigned char green, unsigned char blue) {
-        std::ostringstream oss;
-        oss << CSI << "48;2;" << static_cast<short int>(red) << ";"
-            << static_cast<short int>(green) << ";"
-            << static_cast<short int>(blue) << "m";
-        return oss.str();
+        char buffer[24];
+        int length = std::snprintf(buffer, sizeof(buffer), CSI "48;2;%d;%d;%dm", red, green, blue);
+        return std::string(buffer, length);
     }
 
     void setScreenMode(ScreenMode mode) {
-        std::cout << CSI << '=' << static_cast<int>(mode) << 'h';
+        addStat(Stat::MODE_SEQUENCES);
+        getOutputStream() << CSI << '=' << static_cast<int>(mode) << 'h';
     }
     void unsetScreenMode(ScreenMode mode) {
-        std::cout << CSI << '=' << static_cast<int>(mode) << 'l';
+        addStat(Stat::MODE_SEQUENCES);
+        getOutputStream() << CSI << '=' << static_cast<int>(mode) << 'l';
     }
 
     ANSISettings::ANSISettings() {
@@ -13,6 +13,8 @@
 #include <sista/api.h>
 #include <sista/sista.hpp>
 #include <stdexcept>
+#include <system_error>
+#include <memory_resource> // std::pmr::monotonic_buffer_resource
 
 using namespace sista;
 
@@ -70,6 +72,60 @@ extern "C" {
         return SISTA_OK;
     }
 
+    ArenaHandler_t sista_createArena(size_t initialSize) {
+        sista_clear_last_error();
+        try {
+            std::pmr::monotonic_buffer_resource* arena = initialSize > 0
+                ? new std::pmr::monotonic_buffer_resource(initialSize)
+                : new std::pmr::monotonic_buffer_resource();
+            return reinterpret_cast<ArenaHandler_t>(arena);
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while creating arena");
+            return NULL;
+        }
+    }
+    int sista_destroyArena(ArenaHandler_t arena) {
+        sista_clear_last_error();
+        if (arena == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_ARENA, "arena is null");
+            return SISTA_ERR_NULL_ARENA;
+        }
+        delete reinterpret_cast<std::pmr::monotonic_buffer_resource*>(arena);
+        return SISTA_OK;
+    }
+    FieldHandler_t sista_createFieldWithArena(size_t width, size_t height, ArenaHandler_t arena) {
+        sista_clear_last_error();
+        if (arena == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_ARENA, "arena is null");
+            return NULL;
+        }
+        try {
+            return reinterpret_cast<FieldHandler_t>(
+                new Field(static_cast<int>(width), static_cast<int>(height),
+                          reinterpret_cast<std::pmr::monotonic_buffer_resource*>(arena))
+            );
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while creating Field");
+            return NULL;
+        }
+    }
+    SwappableFieldHandler_t sista_createSwappableFieldWithArena(size_t width, size_t height, ArenaHandler_t arena) {
+        sista_clear_last_error();
+        if (arena == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_ARENA, "arena is null");
+            return NULL;
+        }
+        try {
+            return reinterpret_cast<SwappableFieldHandler_t>(
+                new SwappableField(static_cast<int>(width), static_cast<int>(height),
+                                   reinterpret_cast<std::pmr::monotonic_buffer_resource*>(arena))
+            );
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while creating SwappableField");
+            return NULL;
+        }
+    }
+
     int sista_printField(FieldHandler_t field, char border) {
         sista_clear_last_error();
         if (field == nullptr) {
@@ -362,6 +418,64 @@ extern "C" {
         }
         return SISTA_OK;
     }
+    static int sista_findFieldPath(
+        const sista::Field* field,
+        struct sista_Coordinates from, struct sista_Coordinates to,
+        enum sista_Connectivity connectivity, enum sista_Effect effect, enum sista_PathSearch search,
+        struct sista_Coordinates* path, size_t capacity, size_t* length
+    ) {
+        sista_clear_last_error();
+        if (field == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_FIELD, "field is null");
+            return SISTA_ERR_NULL_FIELD;
+        }
+        if (length == nullptr || (path == nullptr && capacity > 0)) {
+            sista_set_last_error(SISTA_ERR_NULL_PATH, "path or length is null");
+            return SISTA_ERR_NULL_PATH;
+        }
+        *length = 0;
+        sista::Coordinates start(from.y, from.x), goal(to.y, to.x);
+        if (field->isOutOfBounds(start) || field->isOutOfBounds(goal)) {
+            sista_set_last_error(SISTA_ERR_OUT_OF_BOUNDS, "path coordinates are out of bounds");
+            return SISTA_ERR_OUT_OF_BOUNDS;
+        }
+        static thread_local std::vector<sista::Coordinates> cells; // Reused by the calls of the thread
+        try {
+            if (!field->findPath(start, goal, cells, static_cast<sista::Connectivity>(connectivity),
+                                 static_cast<sista::Effect>(effect), static_cast<sista::PathSearch>(search))) {
+                sista_set_last_error(SISTA_ERR_NO_PATH, "the destination can't be reached");
+                return SISTA_ERR_NO_PATH;
+            }
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while searching a path");
+            return SISTA_ERR_BAD_ALLOC;
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_UNKNOWN, "unknown error while searching a path");
+            return SISTA_ERR_UNKNOWN;
+        }
+        *length = cells.size();
+        for (size_t i = 0; i < cells.size() && i < capacity; i++) {
+            path[i].y = cells[i].y;
+            path[i].x = cells[i].x;
+        }
+        return SISTA_OK;
+    }
+    int sista_findPath(
+        FieldHandler_t field,
+        struct sista_Coordinates from, struct sista_Coordinates to,
+        enum sista_Connectivity connectivity, enum sista_Effect effect, enum sista_PathSearch search,
+        struct sista_Coordinates* path, size_t capacity, size_t* length
+    ) {
+        return sista_findFieldPath(reinterpret_cast<sista::Field*>(field), from, to, connectivity, effect, search, path, capacity, length);
+    }
+    int sista_findSwappableFieldPath(
+        SwappableFieldHandler_t field,
+        struct sista_Coordinates from, struct sista_Coordinates to,
+        enum sista_Connectivity connectivity, enum sista_Effect effect, enum sista_PathSearch search,
+        struct sista_Coordinates* path, size_t capacity, size_t* length
+    ) {
+        return sista_findFieldPath(reinterpret_cast<sista::SwappableField*>(field), from, to, connectivity, effect, search, path, capacity, length);
+    }
     int sista_addPawnToSwap(
         SwappableFieldHandler_t field,
         PawnHandler_t pawn,
@@ -460,6 +574,304 @@ extern "C" {
         reinterpret_cast<sista::Cursor*>(cursor)->goTo(coords.y, coords.x);
         return SISTA_OK;
     }
+#ifdef SISTA_HAS_SESSION_SERVER
+    ServerHandler_t sista_createServer(size_t workers) {
+        sista_clear_last_error();
+        try {
+            return reinterpret_cast<ServerHandler_t>(
+                new SessionServer(static_cast<unsigned>(workers))
+            );
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while creating SessionServer");
+        } catch (const std::system_error&) {
+            sista_set_last_error(SISTA_ERR_SYSTEM, "epoll instance could not be created");
+        }
+        return NULL;
+    }
+    int sista_destroyServer(ServerHandler_t server) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        delete reinterpret_cast<SessionServer*>(server);
+        return SISTA_OK;
+    }
+    int sista_serverListenUnix(ServerHandler_t server, const char* path) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            reinterpret_cast<SessionServer*>(server)->listenUnix(path == nullptr ? "" : path);
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_SYSTEM, "could not listen on the Unix socket");
+            return SISTA_ERR_SYSTEM;
+        }
+        return SISTA_OK;
+    }
+    int sista_serverListenTCP(ServerHandler_t server, const char* address, unsigned short port, unsigned short* boundPort) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            unsigned short bound = reinterpret_cast<SessionServer*>(server)->listenTCP(
+                port, address == nullptr ? "127.0.0.1" : address
+            );
+            if (boundPort != nullptr)
+                *boundPort = bound;
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_SYSTEM, "could not listen on the TCP port");
+            return SISTA_ERR_SYSTEM;
+        }
+        return SISTA_OK;
+    }
+    int sista_serverEnableAsyncOutput(ServerHandler_t server, size_t bufferCount, size_t bufferSize, int* enabled) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            bool used = reinterpret_cast<SessionServer*>(server)->enableAsyncOutput(
+                bufferCount == 0 ? 256 : static_cast<unsigned>(bufferCount), bufferSize == 0 ? 16384 : bufferSize
+            );
+            if (enabled != nullptr)
+                *enabled = used ? 1 : 0;
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while creating the io_uring buffers");
+            return SISTA_ERR_BAD_ALLOC;
+        }
+        return SISTA_OK;
+    }
+    int sista_serverOnConnect(ServerHandler_t server, sista_SessionCallback callback, void* userData) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        if (callback == nullptr) {
+            reinterpret_cast<SessionServer*>(server)->onConnect(nullptr);
+        } else {
+            reinterpret_cast<SessionServer*>(server)->onConnect([callback, userData](Session& session) {
+                callback(reinterpret_cast<SessionHandler_t>(&session), userData);
+            });
+        }
+        return SISTA_OK;
+    }
+    int sista_serverOnInput(ServerHandler_t server, sista_InputCallback callback, void* userData) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        if (callback == nullptr) {
+            reinterpret_cast<SessionServer*>(server)->onInput(nullptr);
+        } else {
+            reinterpret_cast<SessionServer*>(server)->onInput([callback, userData](Session& session, const char* data, size_t length) {
+                callback(reinterpret_cast<SessionHandler_t>(&session), data, length, userData);
+            });
+        }
+        return SISTA_OK;
+    }
+    int sista_serverOnDisconnect(ServerHandler_t server, sista_SessionCallback callback, void* userData) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        if (callback == nullptr) {
+            reinterpret_cast<SessionServer*>(server)->onDisconnect(nullptr);
+        } else {
+            reinterpret_cast<SessionServer*>(server)->onDisconnect([callback, userData](Session& session) {
+                callback(reinterpret_cast<SessionHandler_t>(&session), userData);
+            });
+        }
+        return SISTA_OK;
+    }
+    int sista_serverPoll(ServerHandler_t server, int timeout) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            reinterpret_cast<SessionServer*>(server)->poll(timeout);
+        } catch (const std::system_error&) {
+            sista_set_last_error(SISTA_ERR_SYSTEM, "waiting for socket events failed");
+            return SISTA_ERR_SYSTEM;
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while handling socket events");
+            return SISTA_ERR_BAD_ALLOC;
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_UNKNOWN, "unknown error while handling socket events");
+            return SISTA_ERR_UNKNOWN;
+        }
+        return SISTA_OK;
+    }
+    int sista_serverRender(ServerHandler_t server, sista_SessionCallback callback, void* userData) {
+        sista_clear_last_error();
+        if (server == nullptr || callback == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server or callback is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            reinterpret_cast<SessionServer*>(server)->render([callback, userData](Session& session) {
+                callback(reinterpret_cast<SessionHandler_t>(&session), userData);
+            });
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while rendering the sessions");
+            return SISTA_ERR_BAD_ALLOC;
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_UNKNOWN, "unknown error while rendering the sessions");
+            return SISTA_ERR_UNKNOWN;
+        }
+        return SISTA_OK;
+    }
+    int sista_serverRenderFields(ServerHandler_t server, char border) {
+        sista_clear_last_error();
+        if (server == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SERVER, "server is null");
+            return SISTA_ERR_NULL_SERVER;
+        }
+        try {
+            reinterpret_cast<SessionServer*>(server)->render(border);
+        } catch (const std::bad_alloc&) {
+            sista_set_last_error(SISTA_ERR_BAD_ALLOC, "memory allocation failed while rendering the Fields of the sessions");
+            return SISTA_ERR_BAD_ALLOC;
+        } catch (const std::exception&) {
+            sista_set_last_error(SISTA_ERR_UNKNOWN, "unknown error while rendering the Fields of the sessions");
+            return SISTA_ERR_UNKNOWN;
+        }
+        return SISTA_OK;
+    }
+    size_t sista_serverSessionCount(ServerHandler_t server) {
+        if (server == nullptr)
+            return 0;
+        return reinterpret_cast<SessionServer*>(server)->sessionCount();
+    }
+    unsigned sista_sessionGetId(SessionHandler_t session) {
+        if (session == nullptr)
+            return 0;
+        return reinterpret_cast<Session*>(session)->getId();
+    }
+    int sista_sessionSetField(SessionHandler_t session, FieldHandler_t field) {
+        sista_clear_last_error();
+        if (session == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SESSION, "session is null");
+            return SISTA_ERR_NULL_SESSION;
+        }
+        reinterpret_cast<Session*>(session)->setField(reinterpret_cast<Field*>(field));
+        return SISTA_OK;
+    }
+    int sista_sessionSetUserData(SessionHandler_t session, void* userData) {
+        sista_clear_last_error();
+        if (session == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SESSION, "session is null");
+            return SISTA_ERR_NULL_SESSION;
+        }
+        reinterpret_cast<Session*>(session)->setUserData(userData);
+        return SISTA_OK;
+    }
+    void* sista_sessionGetUserData(SessionHandler_t session) {
+        if (session == nullptr)
+            return NULL;
+        return reinterpret_cast<Session*>(session)->getUserData();
+    }
+    int sista_sessionClose(SessionHandler_t session) {
+        sista_clear_last_error();
+        if (session == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_SESSION, "session is null");
+            return SISTA_ERR_NULL_SESSION;
+        }
+        reinterpret_cast<Session*>(session)->close();
+        return SISTA_OK;
+    }
+#else
+    static int sista_unsupported() {
+        sista_set_last_error(SISTA_ERR_UNSUPPORTED, "the session server requires epoll");
+        return SISTA_ERR_UNSUPPORTED;
+    }
+    ServerHandler_t sista_createServer(size_t) {
+        sista_unsupported();
+        return NULL;
+    }
+    int sista_destroyServer(ServerHandler_t) {
+        return sista_unsupported();
+    }
+    int sista_serverListenUnix(ServerHandler_t, const char*) {
+        return sista_unsupported();
+    }
+    int sista_serverListenTCP(ServerHandler_t, const char*, unsigned short, unsigned short*) {
+        return sista_unsupported();
+    }
+    int sista_serverEnableAsyncOutput(ServerHandler_t, size_t, size_t, int*) {
+        return sista_unsupported();
+    }
+    int sista_serverOnConnect(ServerHandler_t, sista_SessionCallback, void*) {
+        return sista_unsupported();
+    }
+    int sista_serverOnInput(ServerHandler_t, sista_InputCallback, void*) {
+        return sista_unsupported();
+    }
+    int sista_serverOnDisconnect(ServerHandler_t, sista_SessionCallback, void*) {
+        return sista_unsupported();
+    }
+    int sista_serverPoll(ServerHandler_t, int) {
+        return sista_unsupported();
+    }
+    int sista_serverRender(ServerHandler_t, sista_SessionCallback, void*) {
+        return sista_unsupported();
+    }
+    int sista_serverRenderFields(ServerHandler_t, char) {
+        return sista_unsupported();
+    }
+    size_t sista_serverSessionCount(ServerHandler_t) {
+        return 0;
+    }
+    unsigned sista_sessionGetId(SessionHandler_t) {
+        return 0;
+    }
+    int sista_sessionSetField(SessionHandler_t, FieldHandler_t) {
+        return sista_unsupported();
+    }
+    int sista_sessionSetUserData(SessionHandler_t, void*) {
+        return sista_unsupported();
+    }
+    void* sista_sessionGetUserData(SessionHandler_t) {
+        return NULL;
+    }
+    int sista_sessionClose(SessionHandler_t) {
+        return sista_unsupported();
+    }
+#endif
+    int sista_getStats(struct sista_Stats* stats) {
+        sista_clear_last_error();
+        if (stats == nullptr) {
+            sista_set_last_error(SISTA_ERR_NULL_STATS, "stats is null");
+            return SISTA_ERR_NULL_STATS;
+        }
+        sista::RenderStats snapshot = sista::getStats();
+        stats->framesPresented = snapshot.framesPresented;
+        stats->bytesEmitted = snapshot.bytesEmitted;
+        stats->styleSequences = snapshot.styleSequences;
+        stats->cursorSequences = snapshot.cursorSequences;
+        stats->eraseSequences = snapshot.eraseSequences;
+        stats->modeSequences = snapshot.modeSequences;
+        stats->cursorJumps = snapshot.cursorJumps;
+        stats->cellsRedrawn = snapshot.cellsRedrawn;
+        stats->swapsAccepted = snapshot.swapsAccepted;
+        stats->swapsRejected = snapshot.swapsRejected;
+        stats->encodeNanoseconds = snapshot.encodeNanoseconds;
+        stats->writeNanoseconds = snapshot.writeNanoseconds;
+        return SISTA_OK;
+    }
+    void sista_resetStats() {
+        sista::resetStats();
+    }
     const char* sista_getVersion() {
         return sista::getVersion();
     }
@@ -134,6 +134,60 @@ int sista_printSwappableField(SwappableFieldHandler_t, char);
  */
 int sista_destroySwappableField(SwappableFieldHandler_t);
 
+/** \struct sista_Arena
+ *  \brief Opaque struct representing a memory arena for fields.
+ *
+ *  An arena hands out memory sequentially from large blocks and releases all of
+ *  it at once when destroyed, so the fields of a session can share one arena
+ *  and be torn down together.
+ *
+ *  \see sista_createFieldWithArena
+*/
+struct sista_Arena;
+typedef struct sista_Arena* ArenaHandler_t;
+
+/** \brief Creates a memory arena.
+ *  \param initialSize The size in bytes of the first block, 0 for a default size.
+ *  \return A handler to the created arena.
+ *
+ *  \retval NULL If memory allocation fails.
+ *
+ *  \warning The arena must be destroyed after every field created with it.
+ *
+ *  \see sista_destroyArena
+*/
+ArenaHandler_t sista_createArena(size_t);
+/** \brief Releases every block of a memory arena.
+ *  \param arena The arena to destroy.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_ARENA If `arena` is `NULL`.
+*/
+int sista_destroyArena(ArenaHandler_t);
+/** \brief Creates a Field whose internal containers are allocated from an arena.
+ *  \param width The width of the Field.
+ *  \param height The height of the Field.
+ *  \param arena The arena, which must outlive the Field.
+ *  \return A handler to the created Field, destroyed with sista_destroyField.
+ *
+ *  \retval NULL If `arena` is `NULL` (`SISTA_ERR_NULL_ARENA`) or memory allocation fails.
+ *
+ *  \see sista_createField
+*/
+FieldHandler_t sista_createFieldWithArena(size_t, size_t, ArenaHandler_t);
+/** \brief Creates a SwappableField whose internal containers are allocated from an arena.
+ *  \param width The width of the SwappableField.
+ *  \param height The height of the SwappableField.
+ *  \param arena The arena, which must outlive the SwappableField.
+ *  \return A handler to the created SwappableField, destroyed with sista_destroySwappableField.
+ *
+ *  \retval NULL If `arena` is `NULL` (`SISTA_ERR_NULL_ARENA`) or memory allocation fails.
+ *
+ *  \see sista_createSwappableField
+*/
+SwappableFieldHandler_t sista_createSwappableFieldWithArena(size_t, size_t, ArenaHandler_t);
+
 /** \brief Resets ANSI settings to default.
  *  \return Status code from `enum sista_ErrorCode`.
  *
@@ -512,6 +566,14 @@ enum sista_ErrorCode {
     SISTA_ERR_NULL_BORDER = 1007,
     SISTA_ERR_NULL_CURSOR = 1008,
     SISTA_ERR_NULL_COLOR = 1009,
+    SISTA_ERR_NULL_SERVER = 1010,
+    SISTA_ERR_NULL_SESSION = 1011,
+    SISTA_ERR_SYSTEM = 1012,
+    SISTA_ERR_UNSUPPORTED = 1013,
+    SISTA_ERR_NULL_STATS = 1014,
+    SISTA_ERR_NULL_ARENA = 1015,
+    SISTA_ERR_NO_PATH = 1016,
+    SISTA_ERR_NULL_PATH = 1017,
     SISTA_ERR_UNKNOWN = 1099
 };
 
@@ -614,6 +676,74 @@ const char* sista_getLastErrorMessage();
 */
 int sista_movePawn(FieldHandler_t, PawnHandler_t, struct sista_Coordinates);
 
+/** \enum sista_Effect
+ *  \brief Behaviour of the coordinates leaving the edges of a field.
+ *
+ *  \see sista::Effect
+*/
+enum sista_Effect {
+    E_PACMAN = 0,
+    E_MATRIX = 1,
+    E_CLAMP = 2,
+    E_BOUNCE = 3
+};
+/** \enum sista_Connectivity
+ *  \brief Moves allowed from a cell to its neighbours.
+ *
+ *  \see sista::Connectivity
+*/
+enum sista_Connectivity {
+    CONNECTIVITY_FOUR = 4,
+    CONNECTIVITY_EIGHT = 8
+};
+/** \enum sista_PathSearch
+ *  \brief Algorithms searching a path.
+ *
+ *  \see sista::PathSearch
+*/
+enum sista_PathSearch {
+    PATH_ASTAR = 0,
+    PATH_JUMP_POINT = 1
+};
+
+/** \brief Searches a shortest path between two cells of a field, through the free cells.
+ *  \param field The Field to search.
+ *  \param from The start cell, which may be occupied.
+ *  \param to The goal cell, which may be occupied.
+ *  \param connectivity The moves allowed from a cell.
+ *  \param effect The topology: `E_PACMAN` wraps the path around the edges, the other effects don't.
+ *  \param search `PATH_ASTAR`, or `PATH_JUMP_POINT` for `CONNECTIVITY_EIGHT` fields.
+ *  \param path The array receiving the cells of the path, from the one after `from` to `to`.
+ *  \param capacity The number of cells `path` can hold; only the first ones are written if the path is longer.
+ *  \param length Set to the number of cells of the path, also when it is larger than `capacity`.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  The search reuses per-thread buffers, so repeated calls don't allocate.
+ *
+ *  On failure, this function also updates the per-thread last-error state
+ *  accessible with `sista_getLastErrorCode()` and `sista_getLastErrorMessage()`.
+ *
+ *  \retval SISTA_OK If a path was found.
+ *  \retval SISTA_ERR_NULL_FIELD If `field` is `NULL`.
+ *  \retval SISTA_ERR_NULL_PATH If `length` is `NULL`, or `path` is `NULL` with a non-zero `capacity`.
+ *  \retval SISTA_ERR_OUT_OF_BOUNDS If `from` or `to` is out of bounds.
+ *  \retval SISTA_ERR_NO_PATH If `to` can't be reached from `from`.
+ *  \retval SISTA_ERR_UNKNOWN If the search failed for another reason.
+ *
+ *  \see sista::Field::findPath
+*/
+int sista_findPath(FieldHandler_t, struct sista_Coordinates, struct sista_Coordinates,
+                   enum sista_Connectivity, enum sista_Effect, enum sista_PathSearch,
+                   struct sista_Coordinates*, size_t, size_t*);
+/** \brief Searches a shortest path between two cells of a swappable field, through the free cells.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista_findPath
+*/
+int sista_findSwappableFieldPath(SwappableFieldHandler_t, struct sista_Coordinates, struct sista_Coordinates,
+                                 enum sista_Connectivity, enum sista_Effect, enum sista_PathSearch,
+                                 struct sista_Coordinates*, size_t, size_t*);
+
 /** \brief Adds the Pawn to a list of pawns to be moved ("swapped") later.
  *  \param field The SwappableField containing the Pawn.
  *  \param pawn The Pawn to add to the swap list.
@@ -765,6 +895,230 @@ int sista_cursorGoToCoordinates(CursorHandler_t, struct sista_Coordinates);
 */
 int sista_destroyCursor(CursorHandler_t);
 
+/** \struct sista_Server
+ *  \brief Opaque struct representing a SessionServer object.
+ *
+ *  \see sista::SessionServer
+*/
+struct sista_Server;
+typedef struct sista_Server* ServerHandler_t;
+/** \struct sista_Session
+ *  \brief Opaque struct representing a Session object.
+ *
+ *  Sessions are owned by their server: a handler is only valid inside
+ *  the callbacks it is passed to, or until the server closes the session.
+ *
+ *  \see sista::Session
+*/
+struct sista_Session;
+typedef struct sista_Session* SessionHandler_t;
+
+/** \brief Callback receiving a session and the user data of the callback. */
+typedef void (*sista_SessionCallback)(SessionHandler_t, void*);
+/** \brief Callback receiving a session, the bytes it sent, their length and the user data of the callback. */
+typedef void (*sista_InputCallback)(SessionHandler_t, const char*, size_t, void*);
+
+/** \brief Creates a multi-session server.
+ *  \param workers Number of threads encoding frames, including the calling thread.
+ *  \return A handler to the created server.
+ *
+ *  \retval NULL If the server cannot be created.
+ *
+ *  \note On failure, call `sista_getLastErrorCode()` and
+ *        `sista_getLastErrorMessage()` for details: the code is
+ *        `SISTA_ERR_UNSUPPORTED` on platforms without `epoll`.
+ *
+ *  \see sista::SessionServer
+*/
+ServerHandler_t sista_createServer(size_t);
+/** \brief Closes every session and listening socket and deallocates the server.
+ *  \param server The server to delete.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+*/
+int sista_destroyServer(ServerHandler_t);
+/** \brief Listens on a Unix domain socket.
+ *  \param server The server.
+ *  \param path Path of the socket.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista::SessionServer::listenUnix
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+ *  \retval SISTA_ERR_SYSTEM If the socket cannot be created or bound.
+*/
+int sista_serverListenUnix(ServerHandler_t, const char*);
+/** \brief Listens on a TCP port of an IPv4 address.
+ *  \param server The server.
+ *  \param address The IPv4 address to bind, `NULL` for loopback.
+ *  \param port The port, `0` to let the system choose one.
+ *  \param boundPort If not `NULL`, receives the port the server is listening on.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista::SessionServer::listenTCP
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+ *  \retval SISTA_ERR_SYSTEM If the address is invalid or the socket cannot be bound.
+*/
+int sista_serverListenTCP(ServerHandler_t, const char*, unsigned short, unsigned short*);
+/** \brief Makes the sessions connecting from now on submit their frames through io_uring.
+ *  \param server The server.
+ *  \param bufferCount Number of registered buffers shared by the sessions, `0` for the default of 256.
+ *  \param bufferSize Size of each buffer in bytes, `0` for the default of 16384.
+ *  \param enabled If not `NULL`, receives `1` if io_uring is used, `0` if the sessions keep writing with `writev`.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  The frames of every session are then handed to the kernel with a single system call per render.
+ *  Without io_uring support the sessions fall back to `writev`, which is not an error.
+ *
+ *  \see sista::SessionServer::enableAsyncOutput
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+ *  \retval SISTA_ERR_BAD_ALLOC If the buffers cannot be allocated.
+*/
+int sista_serverEnableAsyncOutput(ServerHandler_t, size_t, size_t, int*);
+/** \brief Sets the callback invoked when a client connects.
+ *  \param server The server.
+ *  \param callback The callback, `NULL` to remove it.
+ *  \param userData Pointer passed to the callback.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+*/
+int sista_serverOnConnect(ServerHandler_t, sista_SessionCallback, void*);
+/** \brief Sets the callback invoked when a client sends bytes.
+ *  \param server The server.
+ *  \param callback The callback, `NULL` to remove it.
+ *  \param userData Pointer passed to the callback.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+*/
+int sista_serverOnInput(ServerHandler_t, sista_InputCallback, void*);
+/** \brief Sets the callback invoked before a session is closed.
+ *  \param server The server.
+ *  \param callback The callback, `NULL` to remove it.
+ *  \param userData Pointer passed to the callback.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+*/
+int sista_serverOnDisconnect(ServerHandler_t, sista_SessionCallback, void*);
+/** \brief Waits for socket events and handles them.
+ *  \param server The server.
+ *  \param timeout Maximum time to wait in milliseconds, `-1` to wait indefinitely.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista::SessionServer::poll
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+ *  \retval SISTA_ERR_SYSTEM If waiting for the events fails.
+ *  \retval SISTA_ERR_BAD_ALLOC If memory allocation fails, e.g. while accepting a session.
+ *  \retval SISTA_ERR_UNKNOWN If handling the events failed for another reason.
+*/
+int sista_serverPoll(ServerHandler_t, int);
+/** \brief Renders a frame for every session in parallel.
+ *  \param server The server.
+ *  \param callback Callback printing the frame of a session, invoked on the workers.
+ *  \param userData Pointer passed to the callback.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  Every printing function called by the callback (e.g. `sista_printField`)
+ *  writes to the session being rendered.
+ *
+ *  \see sista::SessionServer::render
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` or `callback` is `NULL`.
+ *  \retval SISTA_ERR_BAD_ALLOC If memory allocation fails while rendering a session.
+ *  \retval SISTA_ERR_UNKNOWN If rendering a session failed for another reason.
+*/
+int sista_serverRender(ServerHandler_t, sista_SessionCallback, void*);
+/** \brief Renders the Field attached to every session with the given border.
+ *  \param server The server.
+ *  \param border The border character.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista_sessionSetField
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SERVER If `server` is `NULL`.
+ *  \retval SISTA_ERR_BAD_ALLOC If memory allocation fails while rendering a session.
+ *  \retval SISTA_ERR_UNKNOWN If rendering a session failed for another reason.
+*/
+int sista_serverRenderFields(ServerHandler_t, char);
+/** \brief Returns the number of connected sessions, `0` if `server` is `NULL`. */
+size_t sista_serverSessionCount(ServerHandler_t);
+/** \brief Returns the identifier of a session, `0` if `session` is `NULL`. */
+unsigned sista_sessionGetId(SessionHandler_t);
+/** \brief Attaches the Field rendered by `sista_serverRenderFields`.
+ *  \param session The session.
+ *  \param field The Field, `NULL` to detach it.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \warning The Field is not owned by the session and must outlive it or be detached.
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SESSION If `session` is `NULL`.
+*/
+int sista_sessionSetField(SessionHandler_t, FieldHandler_t);
+/** \brief Stores a pointer reserved to the application in the session.
+ *  \param session The session.
+ *  \param userData The pointer.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SESSION If `session` is `NULL`.
+*/
+int sista_sessionSetUserData(SessionHandler_t, void*);
+/** \brief Returns the pointer stored with `sista_sessionSetUserData`, `NULL` by default. */
+void* sista_sessionGetUserData(SessionHandler_t);
+/** \brief Asks the server to close the session.
+ *  \param session The session.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_SESSION If `session` is `NULL`.
+*/
+int sista_sessionClose(SessionHandler_t);
+
+/** \struct sista_Stats
+ *  \brief Render statistics of the process, filled by `sista_getStats`.
+ *
+ *  \see sista::RenderStats
+*/
+struct sista_Stats {
+    unsigned long long framesPresented; /** Frames presented or enqueued to an output sink. */
+    unsigned long long bytesEmitted; /** Bytes handed to the operating system by the output sinks. */
+    unsigned long long styleSequences; /** SGR sequences (colors and attributes). */
+    unsigned long long cursorSequences; /** Cursor positioning and visibility sequences. */
+    unsigned long long eraseSequences; /** Screen and line erasure sequences. */
+    unsigned long long modeSequences; /** Screen mode sequences. */
+    unsigned long long cursorJumps; /** Absolute cursor movements. */
+    unsigned long long cellsRedrawn; /** Field cells printed, by full prints or by incremental updates. */
+    unsigned long long swapsAccepted; /** Moves applied by `sista_applySwaps`. */
+    unsigned long long swapsRejected; /** Moves discarded because of conflicts. */
+    unsigned long long encodeNanoseconds; /** Time spent printing fields. */
+    unsigned long long writeNanoseconds; /** Time spent in the system calls writing frames. */
+};
+
+/** \brief Reads the render statistics of the process.
+ *  \param stats The struct receiving the statistics.
+ *  \return Status code from `enum sista_ErrorCode`.
+ *
+ *  \see sista::getStats
+ *  \retval SISTA_OK On success.
+ *  \retval SISTA_ERR_NULL_STATS If `stats` is `NULL`.
+*/
+int sista_getStats(struct sista_Stats*);
+/** \brief Sets every render statistic to zero.
+ *
+ *  \see sista::resetStats
+*/
+void sista_resetStats();
+
 const char* sista_getVersion();
 int sista_getVersionMajor();
 int sista_getVersionMinor();
@@ -12,7 +12,7 @@
  *  \copyright GNU General Public License v3.0
  */
 #include "border.hpp"
-#include <iostream>
+#include "output.hpp"
 
 namespace sista {
     Border::Border(char symbol_, const ANSISettings& settings_): symbol(symbol_), settings(settings_) {}
@@ -20,6 +20,6 @@ namespace sista {
     void Border::print(bool apply_settings) const { // Print the Border
         if (apply_settings)
             settings.apply(); // Apply the settings
-        std::cout << symbol; // Print the symbol
+        getOutputStream() << symbol; // Print the symbol
     }
 };
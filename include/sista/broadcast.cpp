@@ -0,0 +1,101 @@
+/** \file broadcast.cpp
+ *  \brief Implementation of the BroadcastChannel and of encodeFrame.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see BroadcastChannel
+ *  \copyright GNU General Public License v3.0
+ */
+#include "broadcast.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <streambuf>
+#include <ostream>
+
+namespace sista {
+    /** \brief Stream buffer appending to a string, moved into the SharedFrame without copies. */
+    class FrameEncoder : public std::streambuf {
+    public:
+        std::string bytes; /** The encoded frame. */
+
+    protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                bytes.push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char* s, std::streamsize n) override {
+            bytes.append(s, n);
+            return n;
+        }
+    };
+
+    SharedFrame encodeFrame(const std::function<void()>& draw) {
+        FrameEncoder encoder;
+        std::ostream stream(&encoder);
+        {
+            OutputRedirect redirect(stream);
+            draw();
+        }
+        if (encoder.bytes.empty())
+            return nullptr;
+        return std::make_shared<const std::string>(std::move(encoder.bytes));
+    }
+
+    BroadcastChannel::BroadcastChannel(): deltaBytes(0) {}
+    BroadcastChannel::~BroadcastChannel() {
+        for (OutputSink* sink : subscribers)
+            forget(sink);
+    }
+
+    void BroadcastChannel::fanOut(const SharedFrame& frame) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [&](OutputSink* sink) {
+            if (sink->enqueue(frame))
+                return false;
+            forget(sink); // Failed sinks leave the channel
+            return true;
+        }), subscribers.end());
+    }
+    void BroadcastChannel::forget(OutputSink* sink) {
+        sink->channels.erase(std::remove(sink->channels.begin(), sink->channels.end(), this), sink->channels.end());
+    }
+
+    void BroadcastChannel::publishKeyframe(const SharedFrame& frame) {
+        keyframe = frame;
+        deltas.clear();
+        deltaBytes = 0;
+        if (frame != nullptr)
+            fanOut(frame);
+    }
+    void BroadcastChannel::publish(const SharedFrame& frame) {
+        if (frame == nullptr)
+            return;
+        SISTA_TRACE_SCOPE("BroadcastChannel::publish");
+        deltas.push_back(frame);
+        deltaBytes += frame->size();
+        fanOut(frame);
+    }
+    bool BroadcastChannel::needsKeyframe() const {
+        return keyframe == nullptr || deltaBytes > keyframe->size();
+    }
+
+    void BroadcastChannel::subscribe(OutputSink& sink) {
+        if (std::find(subscribers.begin(), subscribers.end(), &sink) != subscribers.end())
+            return;
+        if (keyframe != nullptr && !sink.enqueue(keyframe))
+            return;
+        for (const SharedFrame& delta : deltas)
+            if (!sink.enqueue(delta))
+                return;
+        subscribers.push_back(&sink);
+        sink.channels.push_back(this);
+    }
+    void BroadcastChannel::unsubscribe(OutputSink& sink) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), &sink), subscribers.end());
+        forget(&sink);
+    }
+    std::size_t BroadcastChannel::subscriberCount() const {
+        return subscribers.size();
+    }
+};
@@ -0,0 +1,93 @@
+/** \file broadcast.hpp
+ *  \brief Encode-once broadcasting of frames to many spectators.
+ *
+ *  This header declares the BroadcastChannel, which fans out the frames of one Field to
+ *  any number of OutputSink objects. Each frame is encoded once into an immutable SharedFrame
+ *  and every sink only keeps a reference to it, so the number of spectators costs bandwidth
+ *  but no encoding time.
+ *
+ *  \see BroadcastChannel
+ *  \see SharedFrame
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <vector> // std::vector
+#include <functional> // std::function
+#include "output.hpp"
+
+namespace sista {
+    /** \brief Encodes a frame once into an immutable buffer.
+     *  \param draw Function printing the frame, e.g. a call to Field::print or Field::movePawn.
+     *  \return The bytes printed by `draw`, or `nullptr` if it printed nothing.
+     *
+     *  The output stream of the calling thread is redirected to the frame while `draw` runs.
+    */
+    SharedFrame encodeFrame(const std::function<void()>&);
+
+    /** \class BroadcastChannel
+     *  \brief Fans out encoded frames to many sinks without copying them.
+     *
+     *  The producer publishes a keyframe, a frame repainting the whole screen (clearScreen
+     *  followed by Field::print), then the deltas of the following ticks (the bytes printed by
+     *  Field::movePawn and similar methods). Subscribers joining late receive the keyframe and
+     *  the deltas published since then, so their screen is up to date from the first frame.
+     *
+     *  When the deltas since the keyframe outweigh the keyframe itself, needsKeyframe() tells the
+     *  producer that publishing a new keyframe would make late joins cheaper.
+     *
+     *  \note The channel is not thread-safe: publish from the thread driving the sinks,
+     *        e.g. the thread calling SessionServer::poll.
+     *  \see encodeFrame
+     *  \see OutputSink::enqueue
+    */
+    class BroadcastChannel {
+    private:
+        std::vector<OutputSink*> subscribers; /** Sinks receiving the frames. */
+        SharedFrame keyframe; /** Last keyframe published. */
+        std::vector<SharedFrame> deltas; /** Deltas published since the keyframe. */
+        std::size_t deltaBytes; /** Total size of deltas. */
+
+        void fanOut(const SharedFrame&);
+        /** \brief Removes the channel from the channels of a sink leaving it. */
+        void forget(OutputSink*);
+
+    public:
+        /** \brief Default constructor, creates a channel without subscribers nor keyframe. */
+        BroadcastChannel();
+        /** \brief Destructor, removing the channel from the channels of its subscribers. */
+        ~BroadcastChannel();
+
+        BroadcastChannel(const BroadcastChannel&) = delete;
+        BroadcastChannel& operator=(const BroadcastChannel&) = delete;
+
+        /** \brief Publishes a keyframe to every subscriber.
+         *  \param frame The keyframe, which replaces the previous keyframe and its deltas.
+        */
+        void publishKeyframe(const SharedFrame&);
+        /** \brief Publishes a delta to every subscriber.
+         *  \param frame The delta, applied on top of the last keyframe and the previous deltas.
+        */
+        void publish(const SharedFrame&);
+        /** \brief Checks whether the deltas since the keyframe are larger than the keyframe. */
+        bool needsKeyframe() const;
+
+        /** \brief Adds a subscriber, which immediately receives the keyframe and its deltas.
+         *  \param sink The sink to subscribe; destroying it unsubscribes it, e.g. when SessionServer closes its Session.
+        */
+        void subscribe(OutputSink&);
+        /** \brief Removes a subscriber.
+         *  \param sink The sink to unsubscribe.
+        */
+        void unsubscribe(OutputSink&);
+        /** \brief Returns the number of subscribers.
+         *
+         *  Sinks that fail (e.g. because the spectator disconnected) or are destroyed are unsubscribed automatically.
+        */
+        std::size_t subscriberCount() const;
+    };
+};
@@ -1,63 +1,31 @@
 /** \file coordinates.cpp
- *  \brief Implementation of the Coordinates struct and its hash function.
+ *  \brief Implementation of the batch transforms over arrays of Coordinates.
  * 
- *  This file contains the implementation of the Coordinates struct, which represents
- *  2D coordinates with x and y values. It includes constructors, conversion methods,
- *  and overloaded operators for comparison and arithmetic operations. Additionally,
- *  it provides a specialization of std::hash for using Coordinates in hash-based containers.
+ *  The Coordinates struct and its hash function are defined inline in coordinates.hpp.
+ *  This file contains the functions working on whole arrays of coordinates, written as
+ *  plain loops without branches so that the compiler can vectorize them.
  * 
  *  \author FLAK-ZOSO
  *  \date 2022-2025
  *  \version 3.0.0
- *  \see Border
+ *  \see Coordinates
  *  \copyright GNU General Public License v3.0
  */
 #include "coordinates.hpp"
 
 namespace sista {
-    Coordinates::Coordinates(): y(0), x(0) {} // Constructor
-    Coordinates::Coordinates(unsigned short y_, unsigned short x_): y(y_), x(x_) {} // Constructor
-
-    Coordinates Coordinates::fromPair(const std::pair<unsigned short, unsigned short>& p) {
-        return Coordinates(p.first, p.second);
-    }
-    std::pair<unsigned short, unsigned short> Coordinates::toPair() const {
-        return std::make_pair(y, x);
-    }
-
-    bool Coordinates::operator==(const Coordinates& other) const {
-        return (y == other.y && x == other.x);
-    }
-    bool Coordinates::operator!=(const Coordinates& other) const {
-        return (y != other.y || x != other.x);
-    }
-    bool Coordinates::operator<(const Coordinates& other) const {
-        if (y != other.y)
-            return y < other.y;
-        return x < other.x;
+    void translate(Coordinates* coordinates, std::size_t count, short dy, short dx) {
+        for (std::size_t i = 0; i < count; i++) {
+            coordinates[i].y = static_cast<unsigned short>(coordinates[i].y + dy);
+            coordinates[i].x = static_cast<unsigned short>(coordinates[i].x + dx);
+        }
     }
-    Coordinates Coordinates::operator+(const Coordinates& other) const {
-        return Coordinates(y + other.y, x + other.x);
+    void pack(const Coordinates* coordinates, std::size_t count, std::uint32_t* packed) {
+        for (std::size_t i = 0; i < count; i++)
+            packed[i] = coordinates[i].pack();
     }
-    Coordinates Coordinates::operator-(const Coordinates& other) const {
-        return Coordinates(y - other.y, x - other.x);
-    }
-    Coordinates Coordinates::operator*(const unsigned short multiplier) const {
-        return Coordinates(y*multiplier, x*multiplier);
-    }
-    Coordinates Coordinates::operator+=(const Coordinates& other) {
-        y += other.y;
-        x += other.x;
-        return *this;
-    }
-    Coordinates Coordinates::operator-=(const Coordinates& other) {
-        y -= other.y;
-        x -= other.x;
-        return *this;
+    void unpack(const std::uint32_t* packed, std::size_t count, Coordinates* coordinates) {
+        for (std::size_t i = 0; i < count; i++)
+            coordinates[i] = Coordinates::unpack(packed[i]);
     }
 };
-
-
-std::size_t std::hash<sista::Coordinates>::operator()(const sista::Coordinates& c) const noexcept {
-    return (std::size_t(c.y) << 16) ^ std::size_t(c.x);
-} // Simple hash function for Coordinates - combines y and x into a single size_t
@@ -13,6 +13,8 @@
 
 #include <utility>
 #include <functional>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
 
 namespace sista {
     /** \struct Coordinates
@@ -25,6 +27,11 @@ namespace sista {
      *  The coordinates system in Sista is defined such that `y` represents the row (vertical position)
      *  that increases downwards, and `x` represents the column (horizontal position) that increases to the right.
      *
+     *  Every member is `constexpr` and defined inline, so comparisons and arithmetic compile to a few
+     *  instructions in the hot loops. The packed form of `pack` keeps the row in the upper 16 bits, so
+     *  it compares and hashes as a single 32-bit integer with the same ordering as `operator<`.
+     *
+     *  \see pack
      *  \see fromPair
      *  \see toPair
     */
@@ -33,12 +40,12 @@ namespace sista {
         unsigned short x; /** x coordinate */
 
         /** \brief Default constructor initializing coordinates to (0,0). */
-        Coordinates();
+        constexpr Coordinates(): y(0), x(0) {}
         /** \brief Parameterized constructor.
          *  \param y_ The y coordinate (row).
          *  \param x_ The x coordinate (column).
         */
-        Coordinates(unsigned short, unsigned short);
+        constexpr Coordinates(unsigned short y_, unsigned short x_): y(y_), x(x_) {}
         /** \brief Creates a Coordinates instance from a std::pair.
          *  \param p A std::pair where first is y and second is x.
          *  \return A Coordinates instance with the specified y and x values.
@@ -49,7 +56,9 @@ namespace sista {
          *
          *  \see toPair
         */
-        static Coordinates fromPair(const std::pair<unsigned short, unsigned short>&);
+        static constexpr Coordinates fromPair(const std::pair<unsigned short, unsigned short>& p) {
+            return Coordinates(p.first, p.second);
+        }
         /** \brief Converts the Coordinates instance to a std::pair.
          *  \return A std::pair where first is y and second is x.
          *
@@ -59,18 +68,41 @@ namespace sista {
          *
          *  \see fromPair
         */
-        std::pair<unsigned short, unsigned short> toPair() const;
+        constexpr std::pair<unsigned short, unsigned short> toPair() const {
+            return std::pair<unsigned short, unsigned short>(y, x);
+        }
+        /** \brief Packs the coordinates into a single integer.
+         *  \return `y << 16 | x`, ordered like the coordinates and unique for each cell.
+         *
+         *  \see unpack
+        */
+        constexpr std::uint32_t pack() const {
+            return static_cast<std::uint32_t>(y) << 16 | x;
+        }
+        /** \brief Creates a Coordinates instance from its packed form.
+         *  \param packed An integer returned by `pack`.
+         *  \return The coordinates that were packed.
+         *
+         *  \see pack
+        */
+        static constexpr Coordinates unpack(std::uint32_t packed) {
+            return Coordinates(static_cast<unsigned short>(packed >> 16), static_cast<unsigned short>(packed));
+        }
 
         /** \brief Equality operator.
          *  \param other The other Coordinates instance to compare with.
          *  \return True if both coordinates are equal, false otherwise.
         */
-        bool operator==(const Coordinates&) const;
+        constexpr bool operator==(const Coordinates& other) const {
+            return pack() == other.pack();
+        }
         /** \brief Inequality operator.
          *  \param other The other Coordinates instance to compare with.
          *  \return True if the coordinates are not equal, false otherwise.
         */
-        bool operator!=(const Coordinates&) const;
+        constexpr bool operator!=(const Coordinates& other) const {
+            return pack() != other.pack();
+        }
         /** \brief Less-than operator for ordering.
          *  \param other The other Coordinates instance to compare with.
          *  \return True if this coordinate is less than the other, false otherwise.
@@ -78,38 +110,106 @@ namespace sista {
          *  The ordering is first based on the y coordinate (row). If the y coordinates
          *  are equal, then the x coordinate (column) is used for comparison.
         */
-        bool operator<(const Coordinates&) const;
+        constexpr bool operator<(const Coordinates& other) const {
+            return pack() < other.pack();
+        }
         /** \brief Addition operator.
          *  \param other The other Coordinates instance to add.
          *  \return A new Coordinates instance representing the sum of the two coordinates.
          *  \note This operation does not ensure that the resulting coordinates are within any specific bounds.
         */
-        Coordinates operator+(const Coordinates&) const;
+        constexpr Coordinates operator+(const Coordinates& other) const {
+            return Coordinates(static_cast<unsigned short>(y + other.y), static_cast<unsigned short>(x + other.x));
+        }
         /** \brief Subtraction operator.
          *  \param other The other Coordinates instance to subtract.
          *  \return A new Coordinates instance representing the difference of the two coordinates.
          *  \warning This operation does not check for underflow; ensure that the result is valid.
         */
-        Coordinates operator-(const Coordinates&) const;
+        constexpr Coordinates operator-(const Coordinates& other) const {
+            return Coordinates(static_cast<unsigned short>(y - other.y), static_cast<unsigned short>(x - other.x));
+        }
         /** \brief Scalar multiplication operator.
          *  \param multiplier The scalar value to multiply both coordinates by.
          *  \return A new Coordinates instance with both coordinates multiplied by the scalar.
          *  \note This operation does not ensure that the resulting coordinates are within any specific bounds.
         */
-        Coordinates operator*(const unsigned short) const;
+        constexpr Coordinates operator*(const unsigned short multiplier) const {
+            return Coordinates(static_cast<unsigned short>(y * multiplier), static_cast<unsigned short>(x * multiplier));
+        }
         /** \brief Compound addition assignment operator.
          *  \param other The other Coordinates instance to add.
          *  \return A reference to the updated Coordinates instance.
          *  \note This operation modifies the current instance and does not ensure that the resulting coordinates are within any specific bounds.
         */
-        Coordinates operator+=(const Coordinates&);
+        constexpr Coordinates& operator+=(const Coordinates& other) {
+            y = static_cast<unsigned short>(y + other.y);
+            x = static_cast<unsigned short>(x + other.x);
+            return *this;
+        }
         /** \brief Compound subtraction assignment operator.
          *  \param other The other Coordinates instance to subtract.
          *  \return A reference to the updated Coordinates instance.
          *  \warning This operation modifies the current instance and does not check for underflow; ensure that the result is valid.
         */
-        Coordinates operator-=(const Coordinates&);
+        constexpr Coordinates& operator-=(const Coordinates& other) {
+            y = static_cast<unsigned short>(y - other.y);
+            x = static_cast<unsigned short>(x - other.x);
+            return *this;
+        }
+    };
+
+    /** \struct Rectangle
+     *  \brief Represents a rectangular area of cells, from its top-left corner.
+     *
+     *  The area covers the rows `[origin.y, origin.y + height)` and the columns `[origin.x, origin.x + width)`.
+     *
+     *  \see Field::countPawnsIn
+    */
+    struct Rectangle {
+        Coordinates origin; /** Top-left cell of the area */
+        unsigned short width; /** Number of columns */
+        unsigned short height; /** Number of rows */
+
+        /** \brief Default constructor of an empty area at (0,0). */
+        constexpr Rectangle(): origin(), width(0), height(0) {}
+        /** \brief Parameterized constructor.
+         *  \param origin_ The top-left cell of the area.
+         *  \param width_ The number of columns.
+         *  \param height_ The number of rows.
+        */
+        constexpr Rectangle(const Coordinates& origin_, unsigned short width_, unsigned short height_):
+            origin(origin_), width(width_), height(height_) {}
+
+        /** \brief Checks whether a cell is inside the area. */
+        constexpr bool contains(const Coordinates& coordinates) const {
+            return coordinates.y >= origin.y && coordinates.y - origin.y < height
+                && coordinates.x >= origin.x && coordinates.x - origin.x < width;
+        }
     };
+
+    /** \brief Moves every coordinate of an array by the same offset.
+     *  \param coordinates The array of coordinates to move in place.
+     *  \param count The number of coordinates in the array.
+     *  \param dy The offset added to each y coordinate.
+     *  \param dx The offset added to each x coordinate.
+     *  \note Like `operator+`, this does not ensure that the results are within any specific bounds.
+    */
+    void translate(Coordinates* coordinates, std::size_t count, short dy, short dx);
+    /** \brief Packs an array of coordinates, as `Coordinates::pack` does for each of them.
+     *  \param coordinates The array of coordinates to pack.
+     *  \param count The number of coordinates in the array.
+     *  \param packed The array receiving the `count` packed coordinates.
+     *  \see unpack
+    */
+    void pack(const Coordinates* coordinates, std::size_t count, std::uint32_t* packed);
+    /** \brief Unpacks an array of packed coordinates, as `Coordinates::unpack` does for each of them.
+     *  \param packed The array of packed coordinates.
+     *  \param count The number of packed coordinates in the array.
+     *  \param coordinates The array receiving the `count` coordinates.
+     *  \see pack
+    */
+    void unpack(const std::uint32_t* packed, std::size_t count, Coordinates* coordinates);
 };
 
 namespace std {
@@ -123,6 +223,8 @@ namespace std {
     */
     template<>
     struct hash<sista::Coordinates> {
-        std::size_t operator()(const sista::Coordinates&) const noexcept;
+        std::size_t operator()(const sista::Coordinates& c) const noexcept {
+            return c.pack();
+        } // The packed form is unique for each cell
     };
 };
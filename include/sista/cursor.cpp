@@ -13,7 +13,8 @@
  *  \copyright GNU General Public License v3.0
  */
 #include "cursor.hpp"
-#include <iostream>
+#include "output.hpp"
+#include "stats.hpp"
 
 namespace sista {
     const unsigned short int Cursor::offset_y = 3; // Offset for the y coordinate (empyrical)
@@ -21,43 +22,71 @@ namespace sista {
 
     void clearScreen(bool spaces) {
         if (spaces) {
-            std::cout << CLS; // Clear screen
-            std::cout << SSB; // Clear scrollback buffer
+            getOutputStream() << CLS; // Clear screen
+            getOutputStream() << SSB; // Clear scrollback buffer
+            addStat(Stat::ERASE_SEQUENCES, 2);
         }
-        std::cout << TL; // Move cursor to top-left corner
+        addStat(Stat::CURSOR_SEQUENCES);
+        getOutputStream() << TL; // Move cursor to top-left corner
     }
 
     Cursor::Cursor() {
-        std::cout << HIDE_CURSOR;
+        getOutputStream() << HIDE_CURSOR;
+        addStat(Stat::CURSOR_SEQUENCES);
     }
     Cursor::~Cursor() {
-        std::cout << SHOW_CURSOR;
+        getOutputStream() << SHOW_CURSOR;
+        addStat(Stat::CURSOR_SEQUENCES);
     }
 
     void Cursor::goTo(unsigned short int y_, unsigned short int x_) const {
-        std::cout << CSI << y_ << ";" << x_ << CHA;
+        getOutputStream() << CSI << y_ << ";" << x_ << CHA;
+        addStat(Stat::CURSOR_SEQUENCES);
+        addStat(Stat::CURSOR_JUMPS);
     }
     void Cursor::goTo(sista::Coordinates coordinates_) const {
         this->goTo(coordinates_.y + offset_y, coordinates_.x + offset_x);
     }
 
     void Cursor::eraseScreen(EraseScreen eraseScreen_) const {
-        std::cout << CSI << static_cast<int>(eraseScreen_) << "J";
+        getOutputStream() << CSI << static_cast<int>(eraseScreen_) << "J";
+        addStat(Stat::ERASE_SEQUENCES);
     }
     void Cursor::eraseLine(EraseLine eraseLine_, bool moveCursor) const {
-        std::cout << CSI << static_cast<int>(eraseLine_) << "K";
+        getOutputStream() << CSI << static_cast<int>(eraseLine_) << "K";
+        addStat(Stat::ERASE_SEQUENCES);
         if (moveCursor) {
-            std::cout << '\r'; // Move cursor to start of line
+            getOutputStream() << '\r'; // Move cursor to start of line
         }
     }
 
+    void Cursor::setScrollRegion(unsigned short int top, unsigned short int bottom) const {
+        getOutputStream() << CSI << top << ";" << bottom << "r";
+        addStat(Stat::CURSOR_SEQUENCES);
+    }
+    void Cursor::resetScrollRegion() const {
+        getOutputStream() << CSI << "r";
+        addStat(Stat::CURSOR_SEQUENCES);
+    }
+    void Cursor::scroll(ScrollScreen scrollScreen_, unsigned short int n) const {
+        getOutputStream() << CSI << n << static_cast<char>(scrollScreen_);
+        addStat(Stat::ERASE_SEQUENCES);
+    }
+    void Cursor::editLine(EditLine editLine_, unsigned short int n) const {
+        getOutputStream() << CSI << n << static_cast<char>(editLine_);
+        addStat(Stat::ERASE_SEQUENCES);
+    }
+
     void Cursor::move(MoveCursor moveCursor_, unsigned short int n=1) const {
-        std::cout << CSI << n << static_cast<char>(moveCursor_);
+        getOutputStream() << CSI << n << static_cast<char>(moveCursor_);
+        addStat(Stat::CURSOR_SEQUENCES);
     }
     void Cursor::move(MoveCursorDEC moveCursorDEC_) const {
-        std::cout << ESC << ' ' << static_cast<int>(moveCursorDEC_);
+        getOutputStream() << ESC << ' ' << static_cast<int>(moveCursorDEC_);
+        addStat(Stat::CURSOR_SEQUENCES);
     }
     void Cursor::move(MoveCursorSCO moveCursorSCO_) const {
-        std::cout << ESC << ' ' << static_cast<char>(moveCursorSCO_);
+        getOutputStream() << ESC << ' ' << static_cast<char>(moveCursorSCO_);
+        addStat(Stat::CURSOR_SEQUENCES);
     }
 };
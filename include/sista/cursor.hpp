@@ -74,6 +74,29 @@ namespace sista {
         LINE_FROM_CURSOR_TO_BEGINNING = 1, /** Erase from the cursor position to the beginning of the line. */
         ENTIRE_LINE = 2, /** Erase the entire line. */
     };
+    /** \enum ScrollScreen
+     *  \brief Enumeration for scrolling the lines of the scroll region in ANSI escape codes.
+     *
+     *  Each direction corresponds to the command character of the SU and SD escape sequences.
+     *
+     *  \see Cursor::scroll
+     *  \see Cursor::setScrollRegion
+    */
+    enum class ScrollScreen: char {
+        UP = 'S', /** Scroll the lines up, blank lines appear at the bottom (SU). */
+        DOWN = 'T' /** Scroll the lines down, blank lines appear at the top (SD). */
+    };
+    /** \enum EditLine
+     *  \brief Enumeration for inserting and deleting characters of the current line in ANSI escape codes.
+     *
+     *  Each option corresponds to the command character of the ICH and DCH escape sequences.
+     *
+     *  \see Cursor::editLine
+    */
+    enum class EditLine: char {
+        INSERT_CHARACTERS = '@', /** Shift the rest of the line right, inserting blanks at the cursor (ICH). */
+        DELETE_CHARACTERS = 'P' /** Shift the rest of the line left, removing the characters at the cursor (DCH). */
+    };
     /** \enum MoveCursor
      *  \brief Enumeration for cursor movement directions in ANSI escape codes.
      *
@@ -174,6 +197,33 @@ namespace sista {
         */
         void eraseLine(EraseLine, bool=true) const;
 
+        /** \brief Restricts scrolling to a range of rows (DECSTBM).
+         *  \param top The first row of the region, starting from 1.
+         *  \param bottom The last row of the region, starting from 1.
+         *
+         *  Scrolling, including the one caused by a line feed on the last row of the region,
+         *  only moves the lines of the region. The cursor is moved to the top-left corner.
+         *
+         *  \see resetScrollRegion
+        */
+        void setScrollRegion(unsigned short int, unsigned short int) const;
+        /** \brief Extends the scroll region to the whole screen and moves the cursor to the top-left corner. */
+        void resetScrollRegion() const;
+        /** \brief Scrolls the lines of the scroll region, without moving the cursor.
+         *  \param scrollScreen_ The direction in which the lines move.
+         *  \param n The number of lines (default is 1).
+         *
+         *  \see ScrollScreen
+        */
+        void scroll(ScrollScreen, unsigned short int=1) const;
+        /** \brief Inserts or deletes characters at the cursor, shifting the rest of the line.
+         *  \param editLine_ Whether to insert blanks or delete characters.
+         *  \param n The number of characters (default is 1).
+         *
+         *  \see EditLine
+        */
+        void editLine(EditLine, unsigned short int=1) const;
+
         /** \brief Moves the cursor in the specified direction by a given number of positions.
          *  \param moveCursor_ The MoveCursor direction to move the cursor.
          *  \param n The number of positions to move the cursor (default is 1).
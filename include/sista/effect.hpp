@@ -0,0 +1,198 @@
+/** \file effect.hpp
+ *  \brief Effect enum and wrap-around policies header file.
+ *
+ *  This file contains the Effect enum and the policies implementing each effect: PacmanEffect,
+ *  MatrixEffect, ClampEffect and BounceEffect. Each policy brings a position that left the field
+ *  back inside it with branchless arithmetic, so that applyEffect can compute the destinations
+ *  of thousands of pawns in a loop the compiler vectorizes. The runtime Effect dispatches to them.
+ *
+ *  The policies are header-only, as they are meant to be inlined in the loops using them.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see Effect
+ *  \see applyEffect
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <cstddef> // std::size_t
+#include "coordinates.hpp"
+
+namespace sista {
+    /** \enum Effect
+     *  \brief Enumeration for handling out-of-bounds coordinates.
+     *
+     *  This enum class defines different effects that can be applied when a Pawn's coordinates
+     *  go out of the bounds of the Field. The effects determine how the coordinates are adjusted
+     *  to bring them back within valid limits.
+     *
+     *  - PACMAN: Wraps around to the opposite side of the field (like in the PacMan game).
+     *  - MATRIX: Wraps to the beginning of the next line (like in classic C-style arrays).
+     *  - CLAMP: Stops at the edge of the field.
+     *  - BOUNCE: Reflects off the edge of the field, like a ball.
+     *
+     *  \see Field::movingByCoordinates
+     *  \see Field::movePawnBy
+     *  \see applyEffect
+     */
+    enum class Effect { // Effect enum - effect when a coordinate is out of bounds
+        PACMAN = 0, // Pacman effect when a coordinate overflows
+        MATRIX = 1, // Classic C style matrix effect when a coordinate overflows
+        CLAMP = 2, // The coordinate stops at the edge
+        BOUNCE = 3 // The coordinate is reflected by the edge
+    };
+
+    /** \brief Divides rounding towards negative infinity, without branches nor integer division.
+     *  \param value The dividend, also negative.
+     *  \param divisor The divisor, positive.
+     *  \return The largest integer not greater than `value / divisor`.
+     *
+     *  The quotient is estimated with a multiplication by the reciprocal, which vectorizes unlike
+     *  the integer division, and corrected by one when the estimate is truncated the wrong way.
+     *
+     *  \see floorModulo
+    */
+    constexpr int floorQuotient(int value, int divisor) {
+        int quotient = static_cast<int>(value * (1.0 / divisor)); // Truncated towards zero, off by at most one
+        int remainder = value - quotient * divisor;
+        return quotient - (remainder < 0) + (remainder >= divisor);
+    }
+    /** \brief Returns the non-negative remainder of a division, without branches.
+     *  \param value The dividend, also negative.
+     *  \param divisor The divisor, positive.
+     *  \return The remainder in `[0, divisor)`.
+     *  \see floorQuotient
+    */
+    constexpr int floorModulo(int value, int divisor) {
+        return value - floorQuotient(value, divisor) * divisor;
+    }
+
+    /** \struct PacmanEffect
+     *  \brief Wraps each coordinate around to the opposite side of the field.
+     *
+     *  Every policy has a static `apply(y, x, height, width)` bringing (y, x) inside a field of
+     *  `height` rows and `width` columns, and returning false if the position can't be brought back.
+     *
+     *  \see Effect::PACMAN
+    */
+    struct PacmanEffect {
+        static constexpr bool apply(int& y, int& x, int height, int width) {
+            y = floorModulo(y, height);
+            x = floorModulo(x, width);
+            return true;
+        }
+    };
+    /** \struct MatrixEffect
+     *  \brief Wraps the columns to the following or previous rows, like the cells of a C-style matrix.
+     *
+     *  The position is invalid when it leaves the first or the last row.
+     *
+     *  \see Effect::MATRIX
+    */
+    struct MatrixEffect {
+        static constexpr bool apply(int& y, int& x, int height, int width) {
+            y += floorQuotient(x, width); // Each row overflowed moves to the next one
+            x = floorModulo(x, width);
+            bool valid = static_cast<unsigned int>(y) < static_cast<unsigned int>(height);
+            return valid;
+        }
+    };
+    /** \struct ClampEffect
+     *  \brief Stops each coordinate at the edge of the field.
+     *
+     *  \see Effect::CLAMP
+    */
+    struct ClampEffect {
+        static constexpr int clamp(int value, int size) {
+            value = value < 0 ? 0 : value; // Compiled to conditional moves
+            return value < size ? value : size - 1;
+        }
+        static constexpr bool apply(int& y, int& x, int height, int width) {
+            y = clamp(y, height);
+            x = clamp(x, width);
+            return true;
+        }
+    };
+    /** \struct BounceEffect
+     *  \brief Reflects each coordinate off the edges of the field, without repeating the edge cell.
+     *
+     *  \see Effect::BOUNCE
+    */
+    struct BounceEffect {
+        static constexpr int reflect(int value, int size) {
+            int last = size - 1;
+            int period = last > 0 ? 2 * last : 1; // A position walks the field forth and back in a period
+            int phase = floorModulo(value, period) - last;
+            return last - (phase < 0 ? -phase : phase);
+        }
+        static constexpr bool apply(int& y, int& x, int height, int width) {
+            y = reflect(y, height);
+            x = reflect(x, width);
+            return true;
+        }
+    };
+
+    /** \brief Computes the destinations of many moves with a wrap-around policy.
+     *  \tparam Policy One of PacmanEffect, MatrixEffect, ClampEffect and BounceEffect.
+     *  \param from The coordinates the moves start from.
+     *  \param dy The row offset of each move.
+     *  \param dx The column offset of each move.
+     *  \param count The number of moves.
+     *  \param height The height of the field.
+     *  \param width The width of the field.
+     *  \param to The array receiving the `count` destinations; a destination that can't be
+     *            brought back inside the field is replaced by its starting coordinates.
+     *  \return The number of destinations that couldn't be brought back inside the field.
+     *
+     *  The loop has no branches, so it is vectorized by the compiler.
+     *
+     *  \see Effect
+    */
+    template <typename Policy>
+    std::size_t applyEffect(const Coordinates* from, const short* dy, const short* dx, std::size_t count,
+                            unsigned short height, unsigned short width, Coordinates* to) {
+        std::size_t invalid = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            int y = from[i].y + dy[i];
+            int x = from[i].x + dx[i];
+            bool valid = Policy::apply(y, x, height, width);
+            to[i].y = valid ? static_cast<unsigned short>(y) : from[i].y;
+            to[i].x = valid ? static_cast<unsigned short>(x) : from[i].x;
+            invalid += !valid;
+        }
+        return invalid;
+    }
+    /** \brief Computes the destinations of many moves with the policy of a runtime Effect.
+     *  \return The number of destinations that couldn't be brought back inside the field.
+     *  \see applyEffect(const Coordinates*, const short*, const short*, std::size_t, unsigned short, unsigned short, Coordinates*)
+    */
+    inline std::size_t applyEffect(Effect effect, const Coordinates* from, const short* dy, const short* dx, std::size_t count,
+                                   unsigned short height, unsigned short width, Coordinates* to) {
+        switch (effect) { // One dispatch for the whole batch
+            case Effect::PACMAN: return applyEffect<PacmanEffect>(from, dy, dx, count, height, width, to);
+            case Effect::MATRIX: return applyEffect<MatrixEffect>(from, dy, dx, count, height, width, to);
+            case Effect::CLAMP: return applyEffect<ClampEffect>(from, dy, dx, count, height, width, to);
+            case Effect::BOUNCE: return applyEffect<BounceEffect>(from, dy, dx, count, height, width, to);
+        }
+        return count;
+    }
+    /** \brief Brings a position back inside a field with the policy of a runtime Effect.
+     *  \param effect The effect to apply.
+     *  \param y The row, updated in place.
+     *  \param x The column, updated in place.
+     *  \param height The height of the field.
+     *  \param width The width of the field.
+     *  \return False if the position can't be brought back inside the field.
+    */
+    constexpr bool applyEffect(Effect effect, int& y, int& x, int height, int width) {
+        switch (effect) {
+            case Effect::PACMAN: return PacmanEffect::apply(y, x, height, width);
+            case Effect::MATRIX: return MatrixEffect::apply(y, x, height, width);
+            case Effect::CLAMP: return ClampEffect::apply(y, x, height, width);
+            case Effect::BOUNCE: return BounceEffect::apply(y, x, height, width);
+        }
+        return false;
+    }
+};
@@ -20,30 +20,65 @@
 #include "field.hpp"
 #include <queue>
 #include <algorithm>
-#include <iostream>
+#include "output.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "viewport.hpp"
 
 namespace sista {
     void Field::clear() {
-        for (auto& row: pawns) { // For each row
-            for (auto& pawn: row) {
-                if (pawn.get() != nullptr)
-                    pawn.reset(); // Release the shared_ptr
-            }
-        }
+        pawns.clear(); // Release every shared_ptr and keep the chunks for reuse
+    }
+    void Field::shrink() {
+        pawns.shrink();
     }
 
-    Field::Field(int width_, int height_): width(width_), height(height_) { // Constructor
-        pawns.resize(height); // Resize the vector
-        for (int i = 0; i < height; i++) // For each row
-            pawns[i].resize(width); // Resize the vector
-        this->clear(); // Clear the matrix
+    Field::Field(int width_, int height_, std::pmr::memory_resource* resource):
+        Field(width_, height_, Storage::AUTOMATIC, resource) {}
+    Field::Field(int width_, int height_, Storage storage, std::pmr::memory_resource* resource):
+        pawns(width_, height_, storage, resource, true), width(width_), height(height_), viewport(nullptr) { // Constructor
+        // A chunked grid allocates its chunks when the first Pawn is placed in them
     }
 
-    void Field::print() const { // Print the matrix
-        resetAnsi(); // Reset the settings
-        bool previousPawn = false; // If the previous element was a Pawn
-        for (auto& row: pawns) { // For each row
-            for (auto& pawn: row) { // For each pawn
+    std::pmr::memory_resource* Field::getMemoryResource() const {
+        return pawns.getMemoryResource();
+    }
+    Storage Field::getStorage() const {
+        return pawns.getStorage();
+    }
+    int Field::getWidth() const {
+        return width;
+    }
+    int Field::getHeight() const {
+        return height;
+    }
+
+    void Field::setViewport(const Viewport* viewport_) {
+        viewport = viewport_;
+    }
+    const Viewport* Field::getViewport() const {
+        return viewport;
+    }
+    bool Field::goToCell(const Coordinates& coordinates) const { // Cells outside of the viewport are culled
+        if (viewport == nullptr) {
+            cursor.goTo(coordinates);
+            return true;
+        }
+        unsigned short row, column;
+        if (!viewport->toScreen(coordinates, row, column))
+            return false;
+        cursor.goTo(row, column);
+        return true;
+    }
+
+    void Field::printRow(int y, bool& previousPawn) const {
+        std::ostream& out = getOutputStream();
+        for (int x = 0; x < width;) { // For each contiguous span of the row
+            unsigned int length;
+            const std::shared_ptr<Pawn>* cells = pawns.span(y, x, length); // nullptr if the span has no Pawn
+            int end = std::min(width, x + static_cast<int>(length));
+            for (; x < end; x++) { // For each pawn
+                Pawn* pawn = cells != nullptr ? (cells++)->get() : nullptr;
                 if (pawn != nullptr) { // If the pawn is not nullptr
                     pawn->print(); // Print the pawn
                     previousPawn = true; // Set the previousPawn to true
@@ -52,75 +87,73 @@ namespace sista {
                         resetAnsi(); // Reset the settings
                         previousPawn = false; // Set the previousPawn to false
                     }
-                    std::cout << ' ';
+                    out << ' ';
                 }
             }
-            std::cout << '\n';
+        }
+    }
+
+    void Field::print() const { // Print the matrix
+        SISTA_TRACE_SCOPE("Field::print");
+        StatTimer timer(Stat::ENCODE_NANOSECONDS);
+        addStat(Stat::CELLS_REDRAWN, static_cast<std::uint64_t>(width) * height);
+        std::ostream& out = getOutputStream();
+        resetAnsi(); // Reset the settings
+        bool previousPawn = false; // If the previous element was a Pawn
+        for (int y = 0; y < height; y++) { // For each row
+            printRow(y, previousPawn);
+            out << '\n';
         }
         resetAnsi(); // Reset the settings
-        std::cout << std::flush; // Flush the output
+        out << std::flush; // Flush the output
     }
     void Field::print(char border) const { // Prints with custom border
+        SISTA_TRACE_SCOPE("Field::print");
+        StatTimer timer(Stat::ENCODE_NANOSECONDS);
+        addStat(Stat::CELLS_REDRAWN, static_cast<std::uint64_t>(width) * height);
+        std::ostream& out = getOutputStream();
         resetAnsi(); // Reset the settings
-        std::cout << '\n';
+        out << '\n';
         for (int i=0; i<width+2; i++) // For each row
-            std::cout << border; // Print the border
-        std::cout << '\n';
+            out << border; // Print the border
+        out << '\n';
         bool previousPawn = false; // If the previous element was a Pawn
-        for (auto& row: pawns) { // For each row
-            std::cout << border; // Print the border
-            for (auto& pawn: row) { // For each pawn
-                if (pawn != nullptr) { // If the pawn is not nullptr
-                    pawn->print(); // Print the pawn
-                    previousPawn = true; // Set the previousPawn to true
-                } else { // If the pawn is nullptr
-                    if (previousPawn) { // If the previous element was a Pawn
-                        resetAnsi(); // Reset the settings
-                        previousPawn = false; // Set the previousPawn to false
-                    }
-                    std::cout << ' ';
-                }
-            }
+        for (int y = 0; y < height; y++) { // For each row
+            out << border; // Print the border
+            printRow(y, previousPawn);
             resetAnsi(); // Reset the settings
-            std::cout << border << '\n'; // Print the border and a new line
+            out << border << '\n'; // Print the border and a new line
         }
         for (int i=0; i<width+2; i++) // For each row
-            std::cout << border; // Print the border
-        std::cout << std::flush; // Flush the output
+            out << border; // Print the border
+        out << std::flush; // Flush the output
     }
     void Field::print(Border& border) const { // Prints with custom border
+        SISTA_TRACE_SCOPE("Field::print");
+        StatTimer timer(Stat::ENCODE_NANOSECONDS);
+        addStat(Stat::CELLS_REDRAWN, static_cast<std::uint64_t>(width) * height);
+        std::ostream& out = getOutputStream();
         resetAnsi(); // Reset the settings
-        std::cout << '\n';
+        out << '\n';
         border.print(); // Print the border
         for (int i=0; i<width+1; i++) // For each row
             border.print(false); // Print the border
         resetAnsi(); // Reset the settings
-        std::cout << '\n';
+        out << '\n';
         bool previousPawn = true; // If the previous element was a Pawn
-        for (auto& row: pawns) { // For each row
+        for (int y = 0; y < height; y++) { // For each row
             border.print(); // Print the border
-            for (auto& pawn: row) { // For each pawn
-                if (pawn != nullptr) { // If the pawn is not nullptr
-                    pawn->print(); // Print the pawn
-                    previousPawn = true; // Set the previousPawn to true
-                } else { // If the pawn is nullptr
-                    if (previousPawn) { // If the previous element was a Pawn
-                        resetAnsi(); // Reset the settings
-                        previousPawn = false; // Set the previousPawn to false
-                    }
-                    std::cout << ' ';
-                }
-            }
+            printRow(y, previousPawn);
             border.print();
             resetAnsi(); // Reset the settings
             previousPawn = true; // Set the previousPawn to true
-            std::cout << '\n';
+            out << '\n';
         }
         border.print(); // Print the border
         for (int i=0; i<width+1; i++) // For each row
             border.print(false); // Print the border
         resetAnsi(); // Reset the settings
-        std::cout << std::flush; // Flush the output
+        out << std::flush; // Flush the output
     }
 
     void Field::addPawn(std::shared_ptr<Pawn> pawn) { // Add a pawn to the matrix
@@ -134,19 +167,19 @@ namespace sista {
         if (isOccupied(pawn->getCoordinates())) {
             throw std::invalid_argument("Cannot add pawn: coordinates are already occupied");
         }
-        pawns[pawn->getCoordinates().y][pawn->getCoordinates().x] = pawn; // Set the pawn to the coordinates
+        pawns.set(pawn->getCoordinates().y, pawn->getCoordinates().x, pawn); // Set the pawn to the coordinates
     }
     void Field::removePawn(Pawn* pawn) { // Remove a pawn from the matrix
         if (pawn == nullptr || isOutOfBounds(pawn->getCoordinates())) {
             return;
         }
-        pawns[pawn->getCoordinates().y][pawn->getCoordinates().x].reset(); // Release the reference to the pointer
+        pawns.take(pawn->getCoordinates().y, pawn->getCoordinates().x); // Release the reference to the pointer
     }
     void Field::removePawn(const Coordinates& coordinates) { // Remove a pawn from the matrix
         if (isOutOfBounds(coordinates)) {
             return;
         }
-        pawns[coordinates.y][coordinates.x].reset(); // Release the reference to the pointer
+        pawns.take(coordinates.y, coordinates.x); // Release the reference to the pointer
     }
     void Field::erasePawn(Pawn* pawn) { // Erase a pawn from the matrix
         removePawn(pawn); // Remove the pawn from the matrix
@@ -154,14 +187,14 @@ namespace sista {
     }
     void Field::erasePawn(const Coordinates& coordinates) { // Erase a pawn from the matrix
         removePawn(coordinates);
-        cursor.goTo(coordinates); // Set the cursor to the coordinates
-        resetAnsi(); // Reset the settings for that cell
-        std::cout << ' '; // Print a space to clear the cell
+        cleanCoordinates(coordinates); // Clean the coordinates
     }
     void Field::cleanCoordinates(const Coordinates& coordinates) const { // Clean a cell from the matrix
-        cursor.goTo(coordinates); // Set the cursor to the coordinates
+        if (!goToCell(coordinates)) // Set the cursor to the coordinates, unless they are not on screen
+            return;
         resetAnsi(); // Reset the settings for that cell
-        std::cout << ' '; // Print a space to clear the cell
+        getOutputStream() << ' '; // Print a space to clear the cell
+        addStat(Stat::CELLS_REDRAWN);
     }
     void Field::cleanCoordinates(unsigned short y, unsigned short x) const { // Clean a cell from the matrix
         Coordinates coordinates(y, x);
@@ -170,12 +203,16 @@ namespace sista {
 
     void Field::addPrintPawn(std::shared_ptr<Pawn> pawn) { // Add a pawn to the matrix and print it
         addPawn(pawn); // Add the pawn to the matrix
-        this->cursor.goTo(pawn->getCoordinates()); // Set the cursor to the pawn's coordinates
+        if (!goToCell(pawn->getCoordinates())) // Set the cursor to the pawn's coordinates, unless they are not on screen
+            return;
         pawn->print(); // Print the pawn
+        addStat(Stat::CELLS_REDRAWN);
     }
     void Field::rePrintPawn(Pawn* pawn) { // Print a pawn
-        cursor.goTo(pawn->getCoordinates()); // Set the cursor to the pawn's coordinates
+        if (!goToCell(pawn->getCoordinates())) // Set the cursor to the pawn's coordinates, unless they are not on screen
+            return;
         pawn->print(); // Print the pawn
+        addStat(Stat::CELLS_REDRAWN);
     }
 
     void Field::movePawn(Pawn* pawn, const Coordinates& coordinates) { // Move a pawn to the coordinates
@@ -189,14 +226,14 @@ namespace sista {
         }
         // Cursor ANSI stuff
         cleanCoordinates(pawn->getCoordinates()); // Clean the old coordinates
-        cursor.goTo(coordinates); // Set the cursor to the coordinates
-        pawn->print(); // Print the pawn
+        if (goToCell(coordinates)) { // Set the cursor to the coordinates, unless they are not on screen
+            pawn->print(); // Print the pawn
+            addStat(Stat::CELLS_REDRAWN);
+        }
 
         // sista::Field stuff
-        std::shared_ptr<Pawn>& old_cell = pawns[pawn->getCoordinates().y][pawn->getCoordinates().x];
-        pawns[coordinates.y][coordinates.x] = std::move(old_cell); // Moving Pawn ownership away from the old cell
-        removePawn(pawn); // Releasing ownership, now pointing to the void nullptr
-        // Removal must take place *before* updating the coordinates, as it is based on these
+        std::shared_ptr<Pawn> old_cell = pawns.take(pawn->getCoordinates().y, pawn->getCoordinates().x); // Releasing ownership of the old cell
+        pawns.set(coordinates.y, coordinates.x, std::move(old_cell)); // Moving Pawn ownership to the new cell
         pawn->setCoordinates(coordinates);
     }
     void Field::movePawn(Pawn* pawn, unsigned short y, unsigned short x) { // Move a pawn to the coordinates
@@ -217,41 +254,11 @@ namespace sista {
         movePawnBy(pawn, coordinates.y, coordinates.x, effect);
     }
     void Field::movePawnBy(Pawn* pawn, short int y, short int x, Effect effect) {
-        short int y_ = pawn->getCoordinates().y + y;
-        short int x_ = pawn->getCoordinates().x + x;
-        if (!isOutOfBounds(y_, x_)) { // If the coordinates are not out of bounds...
-            movePawn(pawn, y_, x_); // ...no need to apply any effect
-        } else if (effect == Effect::PACMAN) { // If the effect is PACMAN...
-            // ...well, you know how Pac Man works
-            if (x_ < 0) {
-                x_ = width-1-(x_ % width);
-                if (x_ == width)
-                    x_ = width - 1;
-            } else if (x_ >= width) {
-                x_ %= width;
-            }
-            if (y_ < 0) {
-                y_ = height-1-(y_ % width);
-                if (y_ == height)
-                    y_ = height -1;
-            } else if (y_ >= height) {
-                y_ %= height;
-            }
-        } else if (effect == Effect::MATRIX) { // If the effect is MATRIX...
-            // ...the coordinates "wrap around" like in a classic C style matrix
-            short int y = y_;
-            short int x = x_;
-            if (x_ < 0) {
-                x_ = width+(x_ % width);
-                y_ = y + (short int)(x / width) - 1;
-            } else if (x_ >= width) {
-                x_ %= width;
-                y_ = y + (short int)(x / width);
-            }
-            // This [y_] could lead to a coordinate out of bounds...
-            validateCoordinates(y_, x_); // ...so we need to validate it
-        }
-        movePawn(pawn, y_, x_);
+        int y_ = pawn->getCoordinates().y + y;
+        int x_ = pawn->getCoordinates().x + x;
+        if (!applyEffect(effect, y_, x_, height, width)) // MATRIX can lead to a row out of bounds...
+            throw std::out_of_range("Coordinates are out of bounds"); // ...so we need to validate it
+        movePawn(pawn, Coordinates(static_cast<unsigned short>(y_), static_cast<unsigned short>(x_)));
     }
 
     void Field::movePawnFromTo(const Coordinates& coordinates, const Coordinates& newCoordinates) {
@@ -271,23 +278,23 @@ namespace sista {
         if (isOutOfBounds(coordinates)) {
             return nullptr;
         }
-        return pawns[coordinates.y][coordinates.x].get(); // Return the pawn at the coordinates
+        return pawns.get(coordinates.y, coordinates.x).get(); // Return the pawn at the coordinates
     }
     Pawn* Field::getPawn(unsigned short y, unsigned short x) const {
         if (isOutOfBounds(y, x)) {
             return nullptr;
         }
-        return pawns[y][x].get();
+        return pawns.get(y, x).get();
     }
 
     bool Field::isOccupied(const Coordinates& coordinates) const {
-        return (getPawn(coordinates) != nullptr);
+        return !isOutOfBounds(coordinates) && pawns.occupied(coordinates.y, coordinates.x); // From the occupancy bitboard
     }
     bool Field::isOccupied(unsigned short y, unsigned short x) const {
-        return (getPawn(y, x) != nullptr);
+        return !isOutOfBounds(y, x) && pawns.occupied(y, x);
     }
     bool Field::isOccupied(short int y, short int x) const {
-        return (getPawn(y, x) != nullptr);
+        return !isOutOfBounds(y, x) && pawns.occupied(y, x);
     }
 
     bool Field::isOutOfBounds(const Coordinates& coordinates) const {
@@ -310,6 +317,74 @@ namespace sista {
         return !(isOutOfBounds(y, x) || isOccupied(y, x));
     }
 
+    std::size_t Field::countPawnsIn(const Rectangle& area) const {
+        unsigned int bottom = std::min<unsigned int>(area.origin.y + area.height, height); // Clipped to the field
+        unsigned int right = std::min<unsigned int>(area.origin.x + area.width, width);
+        return pawns.countOccupied(area.origin.y, area.origin.x, bottom, right);
+    }
+    bool Field::isEmpty(const Rectangle& area) const {
+        return countPawnsIn(area) == 0;
+    }
+    std::uint64_t Field::getOccupancy(unsigned short y, unsigned short x, unsigned int& length) const {
+        std::uint64_t bits = pawns.occupancy(y, x, length);
+        length = std::min<unsigned int>(length, width - x);
+        return bits & lowBits(length);
+    }
+
+    void Field::findPawnsIn(const Rectangle& area, std::vector<Pawn*>& found) const {
+        findPawnsIn(area, found, [](const Pawn&) { return true; });
+    }
+    void Field::findPawnsNear(const Coordinates& center, unsigned short radius, std::vector<Pawn*>& found) const {
+        findPawnsNear(center, radius, found, [](const Pawn&) { return true; });
+    }
+    void Field::findNearestPawns(const Coordinates& center, std::size_t count, std::vector<Pawn*>& found) const {
+        findNearestPawns(center, count, found, [](const Pawn&) { return true; });
+    }
+
+    bool Field::findFreeCell(Coordinates& cell) const {
+        return findFreeCellIn(Rectangle(Coordinates(0, 0), static_cast<unsigned short>(width), static_cast<unsigned short>(height)), cell);
+    }
+    bool Field::findFreeCellIn(const Rectangle& area, Coordinates& cell) const {
+        unsigned int bottom = std::min<unsigned int>(area.origin.y + area.height, height); // Clipped to the field
+        unsigned int right = std::min<unsigned int>(area.origin.x + area.width, width);
+        for (unsigned int y = area.origin.y; y < bottom; y++) {
+            for (unsigned int x = area.origin.x; x < right;) { // For each word of the row
+                unsigned int length;
+                std::uint64_t free = ~pawns.occupancy(y, x, length);
+                length = std::min(length, right - x);
+                free &= lowBits(length);
+                if (free != 0) {
+                    cell = Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x + countTrailingZeros(free)));
+                    return true;
+                }
+                x += length;
+            }
+        }
+        return false;
+    }
+    void Field::freeCellsAt(const std::vector<std::uint64_t>& ranks, std::vector<Coordinates>& cells) const {
+        std::size_t next = 0; // The first rank not found yet
+        std::uint64_t before = 0; // Free cells before the current word
+        for (int y = 0; y < height && next < ranks.size(); y++) {
+            for (int x = 0; x < width && next < ranks.size();) { // For each word of the row
+                unsigned int length;
+                std::uint64_t free = ~pawns.occupancy(y, x, length);
+                length = std::min<unsigned int>(length, width - x);
+                free &= lowBits(length);
+                std::uint64_t after = before + popcount(free);
+                for (; next < ranks.size() && ranks[next] < after; next++) // The ranks falling in this word
+                    cells.push_back(Coordinates(static_cast<unsigned short>(y),
+                        static_cast<unsigned short>(x + selectBit(free, static_cast<unsigned int>(ranks[next] - before)))));
+                before = after;
+                x += length;
+            }
+        }
+    }
+    bool Field::findPath(const Coordinates& from, const Coordinates& to, std::vector<Coordinates>& path,
+                         Connectivity connectivity, Effect effect, PathSearch algorithm) const {
+        return PathFinder(*this, connectivity, effect).findPath(from, to, path, algorithm);
+    }
+
     // ⚠️ This throws an exception if the coordinates are invalid
     void Field::validateCoordinates(const Coordinates& coordinates) const { // Validate the coordinates
         if (isOutOfBounds(coordinates)) // If the coordinates are out of bounds
@@ -343,38 +418,52 @@ namespace sista {
     long long int Path::current_priority = 0; // priority - priority of the current Path
 
 
-    Coordinates SwappableField::firstInvalidCell(std::map<Coordinates, short int>& pawnsCount_) const { // lowerBound - find the first cell with a value >= value
-        for (std::pair<const Coordinates, short int>& pair : pawnsCount_) {
-            if (pair.second >= 2) // If the cell has 2 or more pawns
-                return pair.first; // Return the coordinates of the cell
+    bool SwappableField::firstInvalidCell(Coordinates& cell) const { // firstInvalidCell - find the first cell with 2 or more pawns
+        bool found = false;
+        for (const Coordinates& coordinates : endCells) { // endCells is unordered, keep the smallest
+            if (*endCount.find(coordinates.pack()) >= 2 && (!found || coordinates < cell)) {
+                cell = coordinates;
+                found = true;
+            }
         }
-        throw std::runtime_error("No invalid cells found");
+        return found;
+    }
+    std::pmr::vector<Path>::iterator SwappableField::findPathToSwap(const Path& path) {
+        std::pmr::vector<Path>::iterator it = std::lower_bound(pawnsToSwap.begin(), pawnsToSwap.end(), path);
+        if (it != pawnsToSwap.end() && !(path < *it))
+            return it;
+        return pawnsToSwap.end();
+    }
+    void SwappableField::insertPathToSwap(const Path& path) {
+        // Paths are mostly created in priority order, so this is usually an append
+        std::pmr::vector<Path>::iterator it = std::lower_bound(pawnsToSwap.begin(), pawnsToSwap.end(), path);
+        if (it == pawnsToSwap.end() || path < *it)
+            pawnsToSwap.insert(it, path);
     }
 
-    SwappableField::SwappableField(int width, int height) : Field(width, height) {
-        pawnsCount.resize(height);
-        for (int y = 0; y < height; y++) {
-            pawnsCount[y].resize(width);
-            for (int x = 0; x < width; x++) {
-                pawnsCount[y][x] = 0;
-            }
-        }
+    SwappableField::SwappableField(int width, int height, std::pmr::memory_resource* resource) :
+        SwappableField(width, height, Storage::AUTOMATIC, resource) {}
+    SwappableField::SwappableField(int width, int height, Storage storage, std::pmr::memory_resource* resource) :
+        Field(width, height, storage, resource), pawnsCount(width, height, pawns.getStorage(), resource), pawnsToSwap(resource),
+        endCount(resource), endCells(resource), rejectedPaths(resource), startingBoard(resource) {
+        // The counts use the layout of the pawns
     }
     SwappableField::~SwappableField() {
-        for (int i = 0; i < (int)pawns.size(); i++) // For each row
-            for (int j = 0; j < (int)pawns[i].size(); j++) // For each pawn
-                pawns[i][j].reset();
         pawns.clear(); // Clear the pawns
     }
+    void SwappableField::shrink() {
+        Field::shrink();
+        pawnsCount.shrink();
+    }
 
     void SwappableField::addPawn(std::shared_ptr<Pawn> pawn) { // addPawn - add a pawn to the field
         Field::addPawn(pawn); // This will throw if the cell is occupied
         // Set the count to 1 for this cell
-        pawnsCount[pawn->getCoordinates().y][pawn->getCoordinates().x] = 1;
+        pawnsCount.set(pawn->getCoordinates().y, pawn->getCoordinates().x, 1);
     }
     void SwappableField::removePawn(Pawn* pawn) { // removePawn - remove a pawn from the field
         if (pawn != nullptr)
-            pawnsCount[pawn->getCoordinates().y][pawn->getCoordinates().x]--;
+            pawnsCount.set(pawn->getCoordinates().y, pawn->getCoordinates().x, pawnsCount.get(pawn->getCoordinates().y, pawn->getCoordinates().x) - 1);
         Field::removePawn(pawn);
     }
 
@@ -386,8 +475,8 @@ namespace sista {
         Field::movePawn(pawn, coordinates);
         
         // Update pawnsCount: decrement at old position, set to 1 at new position
-        pawnsCount[oldCoordinates.y][oldCoordinates.x]--;
-        pawnsCount[coordinates.y][coordinates.x] = 1;
+        pawnsCount.set(oldCoordinates.y, oldCoordinates.x, pawnsCount.get(oldCoordinates.y, oldCoordinates.x) - 1);
+        pawnsCount.set(coordinates.y, coordinates.x, 1);
     }
     void SwappableField::movePawn(Pawn* pawn, unsigned short y, unsigned short x) { // movePawn - move a pawn to the coordinates
         Coordinates coordinates_(y, x);
@@ -405,44 +494,11 @@ namespace sista {
     }
     // ℹ️ - The following function calculates coordinates, but does not apply them to the pawns
     Coordinates Field::movingByCoordinates(Pawn* pawn, short int y, short int x, Effect effect) const {
-        short int y_ = pawn->getCoordinates().y + y;
-        short int x_ = pawn->getCoordinates().x + x;
-        if (!isOutOfBounds(y_, x_)) {
-            return Coordinates(y_, x_);
-        } else if (effect == Effect::PACMAN) {
-            if (x_ < 0) {
-                x_ = width-1-(x_ % width);
-                if (x_ == width)
-                    x_ = width - 1;
-            } else if (x_ >= width) {
-                x_ = abs(x_ % width);
-            }
-            if (y_ < 0) {
-                y_ = height-1-(y_ % width);
-                if (y_ == height)
-                    y_ = height -1;
-            } else if (y_ >= height) {
-                y_ = abs(y_ % height);
-            }
-            return Coordinates(y_, x_);
-        } else if (effect == Effect::MATRIX) {
-            short int y__ = y_;
-            short int x__ = x_;
-            if (x_ < 0) {
-                x_ = width+(x_ % width);
-                y_ = y__ + (short int)(x__ / width) - 1;
-            } else if (x_ >= width) {
-                x_ %= width;
-                y_ = y__ + (short int)(x__ / width);
-            }
-            // This [y_] could lead to a coordinate out of bounds...
-            if (!isOutOfBounds(y_, x_))
-                return Coordinates(y_, x_);
-            else
-                throw std::range_error("Invalid Coordinates, the movement is not possible");
-        } else {
+        int y_ = pawn->getCoordinates().y + y;
+        int x_ = pawn->getCoordinates().x + x;
+        if (!applyEffect(effect, y_, x_, height, width)) // The effects are branchless, see effect.hpp
             throw std::range_error("Invalid Coordinates, the movement is not possible");
-        }
+        return Coordinates(static_cast<unsigned short>(y_), static_cast<unsigned short>(x_));
     }
 
     void SwappableField::addPawnToSwap(Pawn* pawn, const Coordinates& destination) { // addPawnToSwap - add a pawn to the pawnsToSwap
@@ -455,14 +511,15 @@ namespace sista {
         // Note: destination can be occupied, as the swap will be simulated later
         Coordinates start = pawn->getCoordinates();
         Path oppositePath(destination, start, nullptr); // Create the opposite path
-        std::set<Path>::iterator it = pawnsToSwap.find(oppositePath); // Find the opposite path in the pawnsToSwap
+        std::pmr::vector<Path>::iterator it = findPathToSwap(oppositePath); // Find the opposite path in the pawnsToSwap
         if (it != pawnsToSwap.end()) { // If the opposite path is found
             swapTwoPawns(pawn, it->pawn); // Swap the two pawns
             pawnsToSwap.erase(it); // Remove the opposite path from the pawnsToSwap
+            addStat(Stat::SWAPS_ACCEPTED, 2);
             return; // Return
         }
         // If the opposite path is not found, add the path to the pawnsToSwap
-        pawnsToSwap.insert(Path(pawn->getCoordinates(), destination, pawn));
+        insertPathToSwap(Path(pawn->getCoordinates(), destination, pawn));
     }
     void SwappableField::addPawnToSwap(Path& path) { // addPawnToSwap - add a pawn to the pawnsToSwap
         if (path.pawn == nullptr) // If the pawn is nullptr...
@@ -473,78 +530,89 @@ namespace sista {
             return; // ...no need to add the pawn to the pawnsToSwap
         // Note: destination can be occupied, as the swap will be simulated later
         Path oppositePath(path.end, path.begin, nullptr); // Create the opposite path
-        std::set<Path>::iterator it = pawnsToSwap.find(oppositePath); // Find the opposite path in the pawnsToSwap
+        std::pmr::vector<Path>::iterator it = findPathToSwap(oppositePath); // Find the opposite path in the pawnsToSwap
         if (it != pawnsToSwap.end()) { // If the opposite path is found
             swapTwoPawns(path.pawn, it->pawn); // Swap the two pawns
             pawnsToSwap.erase(it); // Remove the opposite path from the pawnsToSwap
+            addStat(Stat::SWAPS_ACCEPTED, 2);
             return; // Return
         }
         // If the opposite path is not found, add the path to the pawnsToSwap
-        pawnsToSwap.insert(path);
+        insertPathToSwap(path);
     }
     void SwappableField::simulateSwaps() { // simulateSwaps - simulate all the swaps in the pawnsToSwap
-        std::map<Coordinates, short int> endCount; // Count the number of pawns at the begin of the path
+        SISTA_TRACE_SCOPE("SwappableField::simulateSwaps");
         if (pawnsToSwap.empty()) { // If there are no swaps to simulate,
             return; // ...return
         }
+        // endCount counts the pawns at each cell after the swaps, only for the cells touched by a path
         for (const Path& path : pawnsToSwap) { // Simulate all the swaps in the pawnsToSwap
-            if (endCount.count(path.begin) == 0) { // If one of the coordinates of the path is not in the map...
-                endCount[path.begin] = pawnsCount[path.begin.y][path.begin.x]; // ...add it to the map with the current number of pawns at the begin of the path
-            }
-            if (endCount.count(path.end) == 0) {
-                endCount[path.end] = pawnsCount[path.end.y][path.end.x]; // ...add it to the map with the current number of pawns at the end of the path
+            for (const Coordinates& cell : {path.begin, path.end}) {
+                if (endCount.find(cell.pack()) == nullptr) { // If the cell is not counted yet...
+                    endCount.insert(cell.pack(), pawnsCount.get(cell.y, cell.x)); // ...start from the current number of pawns there
+                    endCells.push_back(cell);
+                }
             }
-            endCount[path.begin]--; // Decrease the number of pawns at the begin of the path (because the pawn will be removed from there)
-            endCount[path.end]++; // Increase the number of pawns at the end of the path (because the pawn will be added there)
+            (*endCount.find(path.begin.pack()))--; // Decrease the number of pawns at the begin of the path (because the pawn will be removed from there)
+            (*endCount.find(path.end.pack()))++; // Increase the number of pawns at the end of the path (because the pawn will be added there)
         }
 
-        // Paths are stored in a std::set, so they are automatically sorted by priority
-        std::set<Path>::iterator it = pawnsToSwap.begin();
+        // Paths are sorted by priority, rejected ones are marked and removed at the end
+        rejectedPaths.assign(pawnsToSwap.size(), 0);
         Coordinates arrive_; // Coordinates of the cell with 2 or more pawns (so where a certain pawn arrived and should never be arrived at)
-        try {
-            while (true) {
-                // Find the first cell with 2 or more pawns heading there
-                arrive_ = firstInvalidCell(endCount); // Coordinates of the cell with 2 or more pawns (so where a certain pawn arrived and should never be arrived at)
-
-
-                // Find a pawn that arrived at the cell with 2 or more pawns
-                // Pawn* pawn = getPawn(arrive_); // NO! Swap weren't applied yet, so the pawn is still at the begin of the path
-                for (it = pawnsToSwap.begin(); it != pawnsToSwap.end();) {
-                    if (it->end == arrive_) { // If the pawn arrived at the cell with 2 or more pawns
-                        endCount[arrive_]--; // Increase the number of pawns at the begin of the path (because the pawn will be added there)
-                        endCount[it->begin]++; // Decrease the number of pawns at the cell with 2 or more pawns (because the pawn will be removed from there)
-                        it = pawnsToSwap.erase(it); // Remove the path from the pawnsToSwap (this movement can't be applied anymore)
-                    } else {
-                        ++it;
-                    }
-                    if (endCount[arrive_] < 2) { // If the cell with 2 or more pawns is now valid...
-                        break; // ...break the loop and find another cell with 2 or more pawns
-                    }
+        bool rejected = false;
+        while (firstInvalidCell(arrive_)) { // Find the first cell with 2 or more pawns heading there
+            short int& arriveCount = *endCount.find(arrive_.pack());
+            // Find a pawn that arrived at the cell with 2 or more pawns
+            // Pawn* pawn = getPawn(arrive_); // NO! Swap weren't applied yet, so the pawn is still at the begin of the path
+            for (std::size_t i = 0; i < pawnsToSwap.size(); i++) {
+                const Path& path = pawnsToSwap[i];
+                if (rejectedPaths[i] || path.end != arrive_)
+                    continue;
+                arriveCount--; // Decrease the number of pawns at the cell with 2 or more pawns (because the pawn stays where it is)
+                (*endCount.find(path.begin.pack()))++; // Increase the number of pawns at the begin of the path (because the pawn stays there)
+                rejectedPaths[i] = 1; // This movement can't be applied anymore
+                rejected = true;
+                addStat(Stat::SWAPS_REJECTED);
+                if (arriveCount < 2) { // If the cell with 2 or more pawns is now valid...
+                    break; // ...break the loop and find another cell with 2 or more pawns
                 }
-            } // This loop will be broken when the firstInvalidCell throws an exception
-        } catch (std::runtime_error& e) {
-            // No more invalid cells found
+            }
+        }
+        endCount.clear(); // Leave endCount clean for the next tick, keeping its slots
+        endCells.clear();
+        if (rejected) { // Remove the rejected paths, keeping the priority order
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < pawnsToSwap.size(); i++)
+                if (!rejectedPaths[i])
+                    pawnsToSwap[kept++] = pawnsToSwap[i];
+            pawnsToSwap.erase(pawnsToSwap.begin() + kept, pawnsToSwap.end());
         }
     }
     void SwappableField::applySwaps() {
+        SISTA_TRACE_SCOPE("SwappableField::applySwaps");
         simulateSwaps(); // This assures that the pawnsToSwap is valid
+        addStat(Stat::SWAPS_ACCEPTED, pawnsToSwap.size());
         
         // Store the starting positions of the pawns to swap
-        std::unordered_map<Coordinates, std::shared_ptr<Pawn>> startingBoard;
-        for (const Path& path : pawnsToSwap) {
-            startingBoard[path.begin] = std::move(pawns[path.begin.y][path.begin.x]); // Remove the pawn from the begin of the path
+        startingBoard.resize(pawnsToSwap.size());
+        for (std::size_t i = 0; i < pawnsToSwap.size(); i++) {
+            const Path& path = pawnsToSwap[i];
+            startingBoard[i] = pawns.take(path.begin.y, path.begin.x); // Remove the pawn from the begin of the path
         }
         // The swaps can be applied as it stands
-        for (const Path& path : pawnsToSwap) {
-            pawnsCount[path.begin.y][path.begin.x]--; // Decrease the number of pawns at the begin of the path (because the pawn will be removed from there)
-            pawnsCount[path.end.y][path.end.x]++; // Increase the number of pawns at the end of the path (because the pawn will be added there)
-            pawns[path.end.y][path.end.x] = startingBoard[path.begin]; // Move the pawn to the end of the path
+        for (std::size_t i = 0; i < pawnsToSwap.size(); i++) {
+            const Path& path = pawnsToSwap[i];
+            pawnsCount.set(path.begin.y, path.begin.x, pawnsCount.get(path.begin.y, path.begin.x) - 1); // Decrease the number of pawns at the begin of the path (because the pawn will be removed from there)
+            pawnsCount.set(path.end.y, path.end.x, pawnsCount.get(path.end.y, path.end.x) + 1); // Increase the number of pawns at the end of the path (because the pawn will be added there)
+            pawns.set(path.end.y, path.end.x, std::move(startingBoard[i])); // Move the pawn to the end of the path
             if (isFree(path.begin)) {
                 cleanCoordinates(path.begin); // Clean the cell at the begin of the path
             }
             path.pawn->setCoordinates(path.end); // Update the coordinates of the pawn
             rePrintPawn(path.pawn); // Reprint the pawn at the new coordinates
         }
+        startingBoard.clear(); // Keeps the capacity for the next tick
         clearPawnsToSwap();
     }
 
@@ -558,11 +626,8 @@ namespace sista {
         if (second_ != nullptr) {
             second_->setCoordinates(first);
         }
-        // std::swap the pointers Pawn* in the pawns 2D-std::vector
-        std::swap(
-            pawns[first.y][first.x],
-            pawns[second.y][second.x]
-        );
+        // Swap the pointers Pawn* in the pawns grid
+        pawns.swap(first.y, first.x, second.y, second.x);
         if (first_ != nullptr) {
             rePrintPawn(first_);
         }
@@ -576,11 +641,8 @@ namespace sista {
         Coordinates app = second->getCoordinates();
         first->setCoordinates(app);
         second->setCoordinates(temp);
-        // std::swap the pointers Pawn* in the pawns 2D-std::vector
-        std::swap(
-            pawns[temp.y][temp.x],
-            pawns[app.y][app.x]
-        );
+        // Swap the pointers Pawn* in the pawns grid
+        pawns.swap(temp.y, temp.x, app.y, app.x);
         rePrintPawn(first);
         rePrintPawn(second);
     }
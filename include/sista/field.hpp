@@ -27,35 +27,26 @@
 
 #include <vector> // std::vector
 #include <memory> // std::shared_ptr, std::move
-#include <map> // std::map
-#include <set> // std::set
+#include <random> // std::uniform_int_distribution
+#include <algorithm> // std::min, std::sort, std::push_heap, std::pop_heap, std::sort_heap
+#include <cstdlib> // std::abs
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::vector
 #include "pawn.hpp"
 #include "border.hpp"
 #include "cursor.hpp"
+#include "effect.hpp"
+#include "grid.hpp"
+#include "pathfinder.hpp"
 
 namespace sista {
-    /** \enum Effect
-     *  \brief Enumeration for handling out-of-bounds coordinates.
-     *
-     *  This enum class defines different effects that can be applied when a Pawn's coordinates
-     *  go out of the bounds of the Field. The effects determine how the coordinates are adjusted
-     *  to bring them back within valid limits.
-     *
-     *  - PACMAN: Wraps around to the opposite side of the field (like in the PacMan game).
-     *  - MATRIX: Wraps to the beginning of the next line (like in classic C-style arrays).
-     * 
-     *  \see Field::movingByCoordinates
-     *  \see Field::movePawnBy
-     */
-    enum class Effect { // Effect enum - effect when a coordinate is out of bounds
-        PACMAN = 0, // Pacman effect when a coordinate overflows
-        MATRIX = 1 // Classic C style matrix effect when a coordinate overflows
-    };
+    class Viewport;
 
     /** \class Field
      *  \brief Represents a 2D grid where Pawns can be placed, moved, and managed.
      *
-     *  The Field class encapsulates a 2D grid structure using a vector of vectors to hold shared pointers to Pawn objects.
+     *  The Field class encapsulates a 2D grid structure using a CellGrid to hold shared pointers to Pawn objects:
+     *  small fields store every cell in an array, large ones only the chunks holding Pawns, so that fields up to
+     *  65535x65535 cells are practical.
      *  It provides methods to add, remove, move, and print Pawns on the field. The class also includes functionality
      *  to check if specific coordinates are occupied, free, or out of bounds, and to validate coordinates.
      *
@@ -70,11 +61,18 @@ namespace sista {
      */
     class Field { // Field class - represents the field [parent class]
     protected:
-        /** \brief 2D grid of shared pointers to Pawn objects. */
-        std::vector<std::vector<std::shared_ptr<Pawn>>> pawns;
+        /** \brief 2D grid of shared pointers to Pawn objects, allocated from the memory resource of the field. */
+        CellGrid<std::shared_ptr<Pawn>> pawns;
         Cursor cursor; /** Cursor object for terminal operations. */
         int width; /** Width of the matrix */
         int height; /** Height of the matrix */
+        const Viewport* viewport; /** Viewport the incremental updates are rendered through, `nullptr` for the whole field. */
+
+        /** \brief Moves the cursor to the screen position of a cell.
+         *  \param coordinates The Coordinates of the cell.
+         *  \return `false` if a Viewport is attached and the cell is outside of it, without moving the cursor.
+        */
+        bool goToCell(const Coordinates&) const;
 
         /** \brief Cleans the coordinates on screen by printing spaces.
          *  \param coordinates The Coordinates to clean.
@@ -85,27 +83,78 @@ namespace sista {
          *  \param x The x coordinate (column).
         */
         void cleanCoordinates(unsigned short, unsigned short) const;
+        /** \brief Prints the cells of a row, as Field::print does.
+         *  \param y The row.
+         *  \param previousPawn Whether the last printed cell was a Pawn, updated for the next one.
+        */
+        void printRow(int, bool&) const;
+        /** \brief Appends the free cells of the given ranks in row-major order, in a single scan.
+         *  \param ranks The ranks among the free cells, sorted and distinct.
+         *  \param cells The vector receiving the cells.
+        */
+        void freeCellsAt(const std::vector<std::uint64_t>&, std::vector<Coordinates>&) const;
 
     public:
         /** \brief Clears the field by removing all Pawns and resetting the grid.
          *  \note This does not delete the Pawn objects, it only removes them from the field.
          */
         void clear();
+        /** \brief Frees the empty chunks that a CHUNKED field keeps for reuse.
+         *
+         *  A chunk emptied by moving or removing its last Pawn is kept to hold the next Pawn placed
+         *  in an empty chunk, so that Pawns crossing the edges of chunks don't allocate. Calling this
+         *  after many Pawns left for good returns their memory to the resource of the field.
+         */
+        virtual void shrink();
 
         /** \brief Constructor to initialize the field with specified width and height.
          *  \param width_ The width of the field (number of columns).
          *  \param height_ The height of the field (number of rows).
+         *  \param resource The memory resource of the internal containers, the default resource if omitted.
          *
          *  This constructor initializes a Field object with the given dimensions.
-         *  It sets up a 2D grid (vector of vectors) to hold shared pointers to Pawn objects,
-         *  and initializes the Cursor for terminal operations.
+         *  It sets up a 2D grid to hold shared pointers to Pawn objects, with the Storage::AUTOMATIC
+         *  layout, and initializes the Cursor for terminal operations.
+         *
+         *  Passing an arena (e.g. `std::pmr::monotonic_buffer_resource`) keeps the memory of a field
+         *  together and releases it at once with the arena, which must outlive the field.
+         *  The Pawn objects are not allocated by the field, so they don't use the resource.
          *
          *  \see Cursor
         */
-        Field(int, int);
+        Field(int, int, std::pmr::memory_resource* = std::pmr::get_default_resource());
+        /** \brief Constructor to initialize the field with specified width, height and layout.
+         *  \param width_ The width of the field (number of columns).
+         *  \param height_ The height of the field (number of rows).
+         *  \param storage The layout of the cells: DENSE allocates every cell at once, CHUNKED only
+         *  the chunks where Pawns are placed, AUTOMATIC picks DENSE for small fields.
+         *  \param resource The memory resource of the internal containers, the default resource if omitted.
+         *
+         *  \see Storage
+        */
+        Field(int, int, Storage, std::pmr::memory_resource* = std::pmr::get_default_resource());
         /** \brief Destructor to clean up resources. */
         virtual ~Field() = default;
 
+        /** \brief Returns the memory resource of the internal containers. */
+        std::pmr::memory_resource* getMemoryResource() const;
+        /** \brief Returns the layout of the cells, Storage::DENSE or Storage::CHUNKED. */
+        Storage getStorage() const;
+        /** \brief Returns the width of the field (number of columns). */
+        int getWidth() const;
+        /** \brief Returns the height of the field (number of rows). */
+        int getHeight() const;
+
+        /** \brief Sets the Viewport the incremental updates are rendered through.
+         *  \param viewport The Viewport, or `nullptr` to render at the field coordinates again.
+         *
+         *  Viewport attaches and detaches itself, this is rarely called directly.
+         *  \see Viewport
+        */
+        void setViewport(const Viewport*);
+        /** \brief Returns the attached Viewport, `nullptr` if none. */
+        const Viewport* getViewport() const;
+
         /** \brief Prints the entire field to the terminal.
          *
          *  This method iterates through the 2D grid of Pawns and prints each Pawn's symbol
@@ -567,6 +616,258 @@ namespace sista {
         */
         bool isFree(short int, short int) const;
 
+        /** \brief Counts the Pawns inside an area of the field.
+         *  \param area The Rectangle to count in, clipped to the field.
+         *  \return The number of occupied cells in the area.
+         *
+         *  This method reads the occupancy bitboard of the field, a bit per cell, counting 64 cells
+         *  at a time with popcount instead of testing each cell.
+         *
+         *  \see isEmpty
+         *  \see Rectangle
+        */
+        std::size_t countPawnsIn(const Rectangle&) const;
+        /** \brief Checks whether an area of the field has no Pawns.
+         *  \param area The Rectangle to test, clipped to the field.
+         *  \return True if no cell of the area is occupied.
+         *
+         *  \see countPawnsIn
+        */
+        bool isEmpty(const Rectangle&) const;
+        /** \brief Reads the occupancy bits of a row, up to 64 cells at a time.
+         *  \param y The row.
+         *  \param x The first column, inside the field.
+         *  \param length Set to the number of cells read, at least one and at most 64.
+         *  \return The bits of the cells, bit `i` set if column `x + i` is occupied; the bits past `length` are zero.
+         *
+         *  Scanning a row with `x += length` reads the occupancy bitboard a word at a time.
+         *
+         *  \see isOccupied
+        */
+        std::uint64_t getOccupancy(unsigned short, unsigned short, unsigned int&) const;
+
+        /** \brief Finds the first free cell of the field, row by row.
+         *  \param cell Set to the free cell, if found.
+         *  \return False if every cell is occupied.
+         *
+         *  The occupancy bitboard is scanned a word at a time, so full rows are skipped with a
+         *  comparison per 64 cells.
+         *
+         *  \see findFreeCellIn
+         *  \see sampleFreeCells
+        */
+        bool findFreeCell(Coordinates&) const;
+        /** \brief Finds the first free cell of an area, row by row.
+         *  \param area The Rectangle to search, clipped to the field.
+         *  \param cell Set to the free cell, if found.
+         *  \return False if every cell of the area is occupied.
+         *
+         *  \see findFreeCell
+        */
+        bool findFreeCellIn(const Rectangle&, Coordinates&) const;
+        /** \brief Picks distinct free cells uniformly at random, e.g. to spawn Pawns.
+         *  \param count The number of cells to pick.
+         *  \param generator A uniform random bit generator, like `std::mt19937`.
+         *  \return `count` distinct free cells in no particular order, or every free cell if there are fewer.
+         *
+         *  On a mostly free field, random cells are drawn and the occupied ones redrawn. Otherwise,
+         *  distinct ranks among the free cells are drawn and found in a single scan of the
+         *  occupancy bitboard, selecting the ranked bit within each word: the cost doesn't grow
+         *  with the number of Pawns, unlike drawing cells until a free one comes up.
+         *
+         *  \see findFreeCell
+        */
+        template <typename Generator>
+        std::vector<Coordinates> sampleFreeCells(std::size_t count, Generator& generator) const {
+            std::uint64_t area = static_cast<std::uint64_t>(width) * height;
+            std::uint64_t free = area - countPawnsIn(Rectangle(Coordinates(0, 0), static_cast<unsigned short>(width), static_cast<unsigned short>(height)));
+            count = static_cast<std::size_t>(std::min<std::uint64_t>(count, free));
+            std::vector<Coordinates> cells;
+            if (count == 0) // Nothing to draw, and no distribution over an empty field
+                return cells;
+            cells.reserve(count);
+            FlatMap<bool> chosen; // Packed cells or ranks already drawn
+            if (free * 2 >= area && count * 2 <= free) { // Few redraws: at least half of the draws are accepted
+                std::uniform_int_distribution<int> row(0, height - 1), column(0, width - 1);
+                while (cells.size() < count) {
+                    Coordinates cell(static_cast<unsigned short>(row(generator)), static_cast<unsigned short>(column(generator)));
+                    if (!pawns.occupied(cell.y, cell.x) && chosen.find(cell.pack()) == nullptr) {
+                        chosen.insert(cell.pack(), true);
+                        cells.push_back(cell);
+                    }
+                }
+                return cells;
+            }
+            std::vector<std::uint64_t> ranks; // Floyd's algorithm: `count` distinct ranks in [0, free)
+            ranks.reserve(count);
+            for (std::uint64_t last = free - count; last < free; last++) {
+                std::uint64_t rank = std::uniform_int_distribution<std::uint64_t>(0, last)(generator);
+                if (chosen.find(static_cast<std::uint32_t>(rank)) != nullptr)
+                    rank = last; // Not drawn yet, as it is the largest so far
+                chosen.insert(static_cast<std::uint32_t>(rank), true);
+                ranks.push_back(rank);
+            }
+            std::sort(ranks.begin(), ranks.end());
+            freeCellsAt(ranks, cells);
+            return cells;
+        }
+
+        /** \brief Lists the Pawns inside an area of the field.
+         *  \param area The Rectangle to search, clipped to the field.
+         *  \param found Set to the Pawns of the area, in no particular order; its capacity is reused.
+         *
+         *  The field counts its Pawns in tiles of 64x64 cells, kept up to date by every move, swap,
+         *  addition and removal: the empty tiles are skipped, and the occupied ones are read from
+         *  the occupancy bitboard, so the cost grows with the Pawns and tiles of the area, not with it.
+         *
+         *  \see findPawnsNear
+         *  \see findNearestPawns
+        */
+        void findPawnsIn(const Rectangle&, std::vector<Pawn*>&) const;
+        /** \brief Lists the Pawns inside an area of the field that satisfy a predicate.
+         *  \param area The Rectangle to search, clipped to the field.
+         *  \param found Set to the Pawns found, in no particular order; its capacity is reused.
+         *  \param accept A predicate called with each Pawn of the area, like the Pawns of the other team.
+        */
+        template <typename Predicate>
+        void findPawnsIn(const Rectangle& area, std::vector<Pawn*>& found, Predicate accept) const {
+            found.clear();
+            unsigned int bottom = std::min<unsigned int>(area.origin.y + area.height, height); // Clipped to the field
+            unsigned int right = std::min<unsigned int>(area.origin.x + area.width, width);
+            pawns.forEachOccupied(area.origin.y, area.origin.x, bottom, right, [&](unsigned int y, unsigned int x) {
+                Pawn* pawn = pawns.get(y, x).get();
+                if (accept(*pawn))
+                    found.push_back(pawn);
+            });
+        }
+        /** \brief Lists the Pawns within a distance of a cell.
+         *  \param center The cell to measure from.
+         *  \param radius The largest Euclidean distance from `center`, in cells.
+         *  \param found Set to the Pawns found, in no particular order; its capacity is reused.
+         *
+         *  \see findPawnsIn
+        */
+        void findPawnsNear(const Coordinates&, unsigned short, std::vector<Pawn*>&) const;
+        /** \brief Lists the Pawns within a distance of a cell that satisfy a predicate.
+         *  \param center The cell to measure from.
+         *  \param radius The largest Euclidean distance from `center`, in cells.
+         *  \param found Set to the Pawns found, in no particular order; its capacity is reused.
+         *  \param accept A predicate called with each Pawn in the square around the circle.
+        */
+        template <typename Predicate>
+        void findPawnsNear(const Coordinates& center, unsigned short radius, std::vector<Pawn*>& found, Predicate accept) const {
+            long long limit = static_cast<long long>(radius) * radius;
+            int top = std::max(0, center.y - radius), bottom = std::min(height, center.y + radius + 1);
+            int left = std::max(0, center.x - radius), right = std::min(width, center.x + radius + 1);
+            found.clear();
+            if (top >= bottom || left >= right)
+                return;
+            Rectangle square(Coordinates(static_cast<unsigned short>(top), static_cast<unsigned short>(left)),
+                             static_cast<unsigned short>(right - left), static_cast<unsigned short>(bottom - top));
+            findPawnsIn(square, found, [&](const Pawn& pawn) {
+                long long dy = pawn.getCoordinates().y - center.y, dx = pawn.getCoordinates().x - center.x;
+                return dy * dy + dx * dx <= limit && accept(pawn);
+            });
+        }
+        /** \brief Lists the Pawns nearest to a cell.
+         *  \param center The cell to measure from.
+         *  \param count The number of Pawns to find.
+         *  \param found Set to the `count` Pawns nearest to `center` by Euclidean distance, or to all of them if
+         *               there are fewer, from the nearest; ties go to the lower row, then column. Its capacity is reused.
+         *
+         *  The tiles are visited in rings around `center`, stopping as soon as no farther tile may hold a
+         *  nearer Pawn, or visiting the occupied tiles directly when a ring has more tiles than them.
+         *
+         *  \see findPawnsNear
+        */
+        void findNearestPawns(const Coordinates&, std::size_t, std::vector<Pawn*>&) const;
+        /** \brief Lists the Pawns nearest to a cell among those satisfying a predicate.
+         *  \param center The cell to measure from.
+         *  \param count The number of Pawns to find.
+         *  \param found Set to the Pawns found, from the nearest; its capacity is reused.
+         *  \param accept A predicate called with the Pawns of the tiles visited.
+        */
+        template <typename Predicate>
+        void findNearestPawns(const Coordinates& center, std::size_t count, std::vector<Pawn*>& found, Predicate accept) const {
+            using Candidate = std::pair<std::pair<std::uint64_t, std::uint32_t>, Pawn*>; // (squared distance, packed cell), Pawn
+            static thread_local std::vector<Candidate> nearest; // Max-heap of the nearest Pawns so far, reused by every query
+            found.clear();
+            if (count == 0 || isOutOfBounds(center))
+                return;
+            nearest.clear();
+            auto consider = [&](unsigned int y, unsigned int x) {
+                Pawn* pawn = pawns.get(y, x).get();
+                if (!accept(*pawn))
+                    return;
+                long long dy = static_cast<long long>(y) - center.y, dx = static_cast<long long>(x) - center.x;
+                Candidate candidate{{static_cast<std::uint64_t>(dy * dy + dx * dx), Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x)).pack()}, pawn};
+                if (nearest.size() < count) {
+                    nearest.push_back(candidate);
+                    std::push_heap(nearest.begin(), nearest.end());
+                } else if (candidate < nearest.front()) {
+                    std::pop_heap(nearest.begin(), nearest.end());
+                    nearest.back() = candidate;
+                    std::push_heap(nearest.begin(), nearest.end());
+                }
+            };
+            const int shift = static_cast<int>(CellGrid<std::shared_ptr<Pawn>>::TILE_SHIFT);
+            int tileY = center.y >> shift, tileX = center.x >> shift;
+            int tilesHigh = ((height - 1) >> shift) + 1, tilesWide = ((width - 1) >> shift) + 1;
+            int rings = std::max(std::max(tileY, tilesHigh - 1 - tileY), std::max(tileX, tilesWide - 1 - tileX));
+            auto scan = [&](int y, int x) { // The Pawns of a tile, unless it is farther than the Pawns found
+                long long dy = std::max({0LL, (static_cast<long long>(y) << shift) - center.y, center.y - ((static_cast<long long>(y) << shift) + (1 << shift) - 1)});
+                long long dx = std::max({0LL, (static_cast<long long>(x) << shift) - center.x, center.x - ((static_cast<long long>(x) << shift) + (1 << shift) - 1)});
+                if (nearest.size() == count && static_cast<std::uint64_t>(dy * dy + dx * dx) > nearest.front().first.first)
+                    return;
+                pawns.forEachOccupied(static_cast<unsigned int>(y << shift), static_cast<unsigned int>(x << shift),
+                    std::min<unsigned int>((y + 1) << shift, height), std::min<unsigned int>((x + 1) << shift, width), consider);
+            };
+            for (int ring = 0; ring <= rings; ring++) {
+                if (ring > 0 && nearest.size() == count) { // The cells of the ring are at least this far along an axis
+                    std::uint64_t closest = static_cast<std::uint64_t>(ring - 1) * (1 << shift) + 1;
+                    if (nearest.front().first.first < closest * closest)
+                        break;
+                }
+                if (static_cast<std::size_t>(ring) * 8 > pawns.occupiedTiles()) { // Fewer occupied tiles than tiles in the ring
+                    pawns.forEachTile([&](unsigned int y, unsigned int x, std::uint32_t) {
+                        if (std::max(std::abs(static_cast<int>(y) - tileY), std::abs(static_cast<int>(x) - tileX)) >= ring)
+                            scan(static_cast<int>(y), static_cast<int>(x));
+                    });
+                    break;
+                }
+                for (int y = tileY - ring; y <= tileY + ring; y++) {
+                    if (y < 0 || y >= tilesHigh)
+                        continue;
+                    bool edge = y == tileY - ring || y == tileY + ring; // Whole rows on the edges, two tiles in between
+                    for (int x = tileX - ring; x <= tileX + ring; x += edge || ring == 0 ? 1 : 2 * ring) {
+                        if (x >= 0 && x < tilesWide && pawns.tileCount(y, x) > 0)
+                            scan(y, x);
+                    }
+                }
+            }
+            std::sort_heap(nearest.begin(), nearest.end());
+            for (const Candidate& candidate : nearest)
+                found.push_back(candidate.second);
+        }
+
+        /** \brief Searches a shortest path between two cells, through the free cells.
+         *  \param from The start cell, which may be occupied, like the cell of the Pawn to move.
+         *  \param to The goal cell, which may be occupied, like the cell of a Pawn to reach.
+         *  \param path Set to the cells of the path, from the one after `from` to `to`;
+         *              empty if there is no path. Its capacity is reused.
+         *  \param connectivity The moves allowed from a cell, FOUR or EIGHT.
+         *  \param effect The topology: PACMAN wraps the path around the edges, the other effects don't.
+         *  \param algorithm ASTAR, or JUMP_POINT to skip the symmetric paths of EIGHT-connected fields.
+         *  \return False if `to` can't be reached or a cell is out of bounds.
+         *
+         *  The search reuses the buffers of the calling thread, so it doesn't allocate once they
+         *  are as large as the explored area.
+         *
+         *  \see PathFinder
+        */
+        bool findPath(const Coordinates&, const Coordinates&, std::vector<Coordinates>&,
+                      Connectivity=Connectivity::FOUR, Effect=Effect::CLAMP, PathSearch=PathSearch::ASTAR) const;
+
         /** \brief Validates that the given coordinates are within bounds and not occupied.
          *  \param coordinates The Coordinates to validate.
          *
@@ -693,7 +994,8 @@ namespace sista {
      *  \brief A specialized Field that handles Pawn swaps without conflicts.
      *
      *  The SwappableField class extends the Field class to manage scenarios where multiple Pawns may need to swap positions.
-     *  It maintains a count of Pawns at each position and a set of paths representing Pawns that need to be moved.
+     *  It maintains a count of Pawns at each position and a list of paths representing Pawns that need to be moved.
+     *  Steady-state ticks of addPawnToSwap and applySwaps reuse the storage of the previous ones and don't allocate.
      *  The class provides methods to add and remove Pawns, manage the swap paths, and simulate or apply the swaps.
      *  This class is designed to ensure that Pawn movements are handled correctly, even when multiple Pawns are
      *  attempting to move to the same position.
@@ -705,16 +1007,35 @@ namespace sista {
      */
     class SwappableField final : public Field {
     private:
-        /** \brief 2D grid [y][x] to track the number of Pawns at each position. */
-        std::vector<std::vector<short int>> pawnsCount;
-        /** \brief Set of Paths representing Pawns that need to be swapped. */
-        std::set<Path> pawnsToSwap;
-        
-        Coordinates firstInvalidCell(std::map<Coordinates, short int>&) const; // firstInvalidCell - find the first cell with 2 or more pawns
+        /** \brief 2D grid to track the number of Pawns at each position, with the layout of the pawns. */
+        CellGrid<short int> pawnsCount;
+        /** \brief Paths representing Pawns that need to be swapped, sorted by priority. */
+        std::pmr::vector<Path> pawnsToSwap;
+
+        // Scratch storage of simulateSwaps and applySwaps, kept between ticks so that they don't allocate
+        FlatMap<short int> endCount; /** Pawns at each cell (Coordinates::pack) touched by a path, after the swaps. */
+        std::pmr::vector<Coordinates> endCells; /** Cells whose endCount is set. */
+        std::pmr::vector<unsigned char> rejectedPaths; /** Whether each path of pawnsToSwap was rejected by simulateSwaps. */
+        std::pmr::vector<std::shared_ptr<Pawn>> startingBoard; /** Pawn leaving the begin of each path of pawnsToSwap. */
+
+        /** \brief Finds the first cell, in Coordinates order, with 2 or more pawns heading there.
+         *  \param cell Set to the cell if one is found.
+         *  \return `false` if no such cell exists.
+        */
+        bool firstInvalidCell(Coordinates&) const; // firstInvalidCell - find the first cell with 2 or more pawns
+        /** \brief Finds a path with the same priority, as an ordered set would.
+         *  \param path The path to look for.
+         *  \return An iterator to the path, or `pawnsToSwap.end()`.
+        */
+        std::pmr::vector<Path>::iterator findPathToSwap(const Path&);
+        /** \brief Inserts a path at its priority, unless a path with the same priority is queued.
+         *  \param path The path to insert.
+        */
+        void insertPathToSwap(const Path&);
 
         /** \brief Cleans the internal state of pawnsToSwap.
          *
-         *  This method clears the set of paths representing Pawns that need to be swapped.
+         *  This method clears the list of paths representing Pawns that need to be swapped.
          *  It is useful for resetting the state before simulating or applying new swaps.
          *
          *  \see pawnsToSwap
@@ -725,6 +1046,7 @@ namespace sista {
         /** \brief Constructor to initialize the SwappableField with specified width and height.
          *  \param width The width of the field (number of columns).
          *  \param height The height of the field (number of rows).
+         *  \param resource The memory resource of the internal containers, including the swap paths and scratch storage.
          *
          *  This constructor initializes a SwappableField object with the given dimensions.
          *  It sets up a 2D grid to track the number of Pawns at each position and initializes
@@ -732,10 +1054,22 @@ namespace sista {
          *
          *  \see Field
         */
-        SwappableField(int, int);
+        SwappableField(int, int, std::pmr::memory_resource* = std::pmr::get_default_resource());
+        /** \brief Constructor to initialize the SwappableField with specified width, height and layout.
+         *  \param width The width of the field (number of columns).
+         *  \param height The height of the field (number of rows).
+         *  \param storage The layout of the cells and of the counts of Pawns.
+         *  \param resource The memory resource of the internal containers, including the swap paths and scratch storage.
+         *
+         *  \see Storage
+        */
+        SwappableField(int, int, Storage, std::pmr::memory_resource* = std::pmr::get_default_resource());
         /** \brief Destructor to clean up resources. */
         ~SwappableField();
 
+        /** \brief Frees the empty chunks kept for reuse, of the Pawns and of the pawnsCount grid. */
+        void shrink() override;
+
         /** \brief Adds a Pawn to the field and updates the pawnsCount grid.
          *  \param pawn A shared pointer to the Pawn to add.
          *
@@ -0,0 +1,194 @@
+/** \file fieldofview.cpp
+ *  \brief Implementation of the FieldOfView class.
+ *
+ *  The shadowcasting scans the four quadrants around the viewer row by row, each row between
+ *  a start and an end slope kept as exact fractions. An opaque cell ends the current span of a
+ *  row and starts a narrower row behind it; the rows still to scan wait on a stack instead of
+ *  the recursion, so a view only grows the stack the first times.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see FieldOfView
+ *  \copyright GNU General Public License v3.0
+ */
+#include "fieldofview.hpp"
+#include <algorithm> // std::fill, std::min, std::max, std::swap
+#include <cstdlib> // std::abs
+#include <stdexcept> // std::out_of_range
+
+namespace sista {
+    /** \brief Divides rounding towards negative infinity, with a positive divisor. */
+    static long long floorDivide(long long numerator, long long denominator) {
+        return numerator >= 0 ? numerator / denominator : -((-numerator + denominator - 1) / denominator);
+    }
+    /** \brief Divides rounding towards positive infinity, with a positive divisor. */
+    static long long ceilDivide(long long numerator, long long denominator) {
+        return -floorDivide(-numerator, denominator);
+    }
+
+    // How the depth and the column of each quadrant move a cell: {dy per depth, dx per depth, dy per column, dx per column}
+    static constexpr int QUADRANTS[4][4] = {{-1, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}};
+
+    FieldOfView::FieldOfView(const Field& field_):
+        field(&field_), width(field_.getWidth()), height(field_.getHeight()),
+        words((static_cast<std::size_t>(field_.getWidth()) + 63) / 64),
+        opaque(words * field_.getHeight(), 0), visible(words * field_.getHeight(), 0),
+        top(field_.getHeight()), bottom(-1) {
+        refresh();
+    }
+
+    void FieldOfView::refresh() {
+        std::fill(opaque.begin(), opaque.end(), 0);
+        for (int y = 0; y < height; y++) {
+            std::uint64_t* row = &opaque[y * words];
+            for (int x = 0; x < width;) { // A word of occupancy at a time
+                unsigned int length;
+                std::uint64_t bits = field->getOccupancy(static_cast<unsigned short>(y), static_cast<unsigned short>(x), length);
+                unsigned int shift = x & 63;
+                row[x >> 6] |= bits << shift;
+                if (shift + length > 64) // The bits read straddle two words of the bitmap
+                    row[(x >> 6) + 1] |= bits >> (64 - shift);
+                x += length;
+            }
+        }
+    }
+    void FieldOfView::setOpaque(const Coordinates& coordinates, bool opaque_) {
+        if (coordinates.y >= height || coordinates.x >= width)
+            return;
+        std::uint64_t& word = opaque[coordinates.y * words + (coordinates.x >> 6)];
+        std::uint64_t bit = 1ULL << (coordinates.x & 63);
+        word = opaque_ ? word | bit : word & ~bit;
+    }
+    void FieldOfView::update(const Coordinates& coordinates) {
+        setOpaque(coordinates, field->isOccupied(coordinates));
+    }
+    bool FieldOfView::isOpaque(const Coordinates& coordinates) const {
+        return coordinates.y < height && coordinates.x < width && test(opaque, coordinates.y, coordinates.x);
+    }
+
+    bool FieldOfView::lineOfSight(const Coordinates& from, const Coordinates& to) const {
+        if (from.y >= height || from.x >= width || to.y >= height || to.x >= width)
+            return false;
+        Coordinates first = from, last = to;
+        if (first.pack() > last.pack()) // The same line both ways
+            std::swap(first, last);
+        int y = first.y, x = first.x;
+        int dx = std::abs(last.x - x), dy = -std::abs(last.y - y);
+        int stepX = x < last.x ? 1 : -1, stepY = y < last.y ? 1 : -1;
+        int error = dx + dy;
+        while (y != last.y || x != last.x) { // A cell sees itself, without a step
+            int doubled = 2 * error;
+            if (doubled >= dy) {
+                error += dy;
+                x += stepX;
+            }
+            if (doubled <= dx) {
+                error += dx;
+                y += stepY;
+            }
+            if (y == last.y && x == last.x)
+                break;
+            if (y < 0 || y >= height || x < 0 || x >= width) // Never past the segment, but never out of the bitmap either
+                return false;
+            if (test(opaque, y, x))
+                return false;
+        }
+        return true;
+    }
+
+    void FieldOfView::clear() {
+        for (int y = top; y <= bottom; y++)
+            std::fill(visible.begin() + y * words, visible.begin() + (y + 1) * words, 0);
+        top = height;
+        bottom = -1;
+    }
+    void FieldOfView::reveal(int y, int x, std::vector<Coordinates>* cells) {
+        std::uint64_t& word = visible[y * words + (x >> 6)];
+        std::uint64_t bit = 1ULL << (x & 63);
+        if (word & bit)
+            return; // The cells on the diagonals are scanned by two quadrants
+        word |= bit;
+        top = std::min(top, y);
+        bottom = std::max(bottom, y);
+        if (cells != nullptr)
+            cells->push_back(Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x)));
+    }
+    void FieldOfView::cast(const Coordinates& viewer, unsigned int radius, std::vector<Coordinates>* cells) {
+        if (viewer.y >= height || viewer.x >= width)
+            throw std::out_of_range("Viewer coordinates are out of bounds");
+        reveal(viewer.y, viewer.x, cells);
+        long long reach = std::min<long long>(radius, static_cast<long long>(width) + height); // No view goes farther
+        long long limit = reach * reach;
+        for (const auto& quadrant : QUADRANTS) {
+            rows.clear();
+            rows.push_back(ScanRow{1, -1, 1, 1, 1});
+            while (!rows.empty()) {
+                ScanRow row = rows.back();
+                rows.pop_back();
+                long long depth = row.depth;
+                if (depth > reach)
+                    continue;
+                // The columns whose centre lies between the slopes, the ties rounded inwards
+                long long first = floorDivide(2 * depth * row.startNumerator + row.startDenominator, 2 * row.startDenominator);
+                long long last = ceilDivide(2 * depth * row.endNumerator - row.endDenominator, 2 * row.endDenominator);
+                int previous = -1; // Whether the previous cell of the row blocked the view, -1 for none
+                for (long long column = first; column <= last; column++) {
+                    int y = viewer.y + static_cast<int>(depth * quadrant[0] + column * quadrant[2]);
+                    int x = viewer.x + static_cast<int>(depth * quadrant[1] + column * quadrant[3]);
+                    bool wall = blocks(y, x);
+                    bool symmetric = column * row.startDenominator >= depth * row.startNumerator
+                        && column * row.endDenominator <= depth * row.endNumerator; // The centre is strictly in view
+                    bool inside = static_cast<unsigned int>(y) < static_cast<unsigned int>(height)
+                        && static_cast<unsigned int>(x) < static_cast<unsigned int>(width);
+                    if ((wall || symmetric) && inside && depth * depth + column * column <= limit)
+                        reveal(y, x, cells);
+                    if (previous == 1 && !wall) { // The view resumes past a wall
+                        row.startNumerator = 2 * column - 1;
+                        row.startDenominator = 2 * depth;
+                    }
+                    if (previous == 0 && wall) // The span before the wall goes on in the next row
+                        rows.push_back(ScanRow{row.depth + 1, row.startNumerator, row.startDenominator, 2 * column - 1, 2 * depth});
+                    previous = wall;
+                }
+                if (previous == 0)
+                    rows.push_back(ScanRow{row.depth + 1, row.startNumerator, row.startDenominator, row.endNumerator, row.endDenominator});
+            }
+        }
+    }
+
+    void FieldOfView::compute(const Coordinates& viewer, unsigned int radius) {
+        clear();
+        cast(viewer, radius, nullptr);
+    }
+    void FieldOfView::compute(const std::vector<Coordinates>& viewers, unsigned int radius) {
+        clear();
+        for (const Coordinates& viewer : viewers)
+            cast(viewer, radius, nullptr);
+    }
+    void FieldOfView::compute(const std::vector<Coordinates>& viewers, unsigned int radius,
+                              std::vector<Coordinates>& cells, std::vector<std::size_t>& offsets) {
+        cells.clear();
+        offsets.clear();
+        for (const Coordinates& viewer : viewers) {
+            offsets.push_back(cells.size());
+            clear();
+            cast(viewer, radius, &cells);
+        }
+        offsets.push_back(cells.size());
+    }
+
+    bool FieldOfView::isVisible(const Coordinates& coordinates) const {
+        return coordinates.y < height && coordinates.x < width && test(visible, coordinates.y, coordinates.x);
+    }
+    const std::uint64_t* FieldOfView::getVisibleRow(unsigned short y) const {
+        return &visible[y * words];
+    }
+    std::size_t FieldOfView::countVisible() const {
+        std::size_t count = 0;
+        for (int y = top; y <= bottom; y++)
+            for (std::size_t word = 0; word < words; word++)
+                count += popcount(visible[y * words + word]);
+        return count;
+    }
+};
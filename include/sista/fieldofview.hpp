@@ -0,0 +1,148 @@
+/** \file fieldofview.hpp
+ *  \brief FieldOfView class header file.
+ *
+ *  This file contains the FieldOfView class, computing which cells of a Field a viewer sees
+ *  with symmetric shadowcasting, and whether two cells see each other with Bresenham lines.
+ *  Both read an opacity bitmap of the field, a bit per cell, instead of the Pawns: the bitmap
+ *  is loaded from the occupancy a word at a time and then kept up to date cell by cell.
+ *
+ *  The visible cells are written into a bitmap of the same layout, cleared only on the rows a
+ *  viewer can reach, so that the views of many viewers per tick don't allocate.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see FieldOfView
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <vector> // std::vector
+#include "field.hpp"
+
+namespace sista {
+    /** \class FieldOfView
+     *  \brief The cells seen from a viewer, through the cells that aren't opaque.
+     *
+     *  The opaque cells are the occupied ones, or those whose Pawn satisfies a predicate. An
+     *  opaque cell is seen but hides the cells behind it. The view is symmetric: a viewer sees
+     *  a cell if and only if a viewer in that cell sees it, and so is lineOfSight.
+     *
+     *  The views stop at the edges of the field, whatever its Effect, and at a radius measured
+     *  as the Euclidean distance. The field must keep its dimensions and outlive the FieldOfView.
+     *
+     *  \see Field::getOccupancy
+    */
+    class FieldOfView {
+        /** \brief A row of a quadrant still to scan, between two slopes. */
+        struct ScanRow {
+            int depth; /** Distance of the row from the viewer. */
+            long long startNumerator; /** Slope where the row starts, as a fraction. */
+            long long startDenominator;
+            long long endNumerator; /** Slope where the row ends, as a fraction. */
+            long long endDenominator;
+        };
+
+        const Field* field; /** The field the views are computed on. */
+        int width; /** Width of the field. */
+        int height; /** Height of the field. */
+        std::size_t words; /** Words of a row of the bitmaps. */
+        std::vector<std::uint64_t> opaque; /** A bit per cell, set for the opaque ones. */
+        std::vector<std::uint64_t> visible; /** A bit per cell, set for the cells of the current view. */
+        int top; /** First row of `visible` that may have bits set. */
+        int bottom; /** Last row of `visible` that may have bits set. */
+        std::vector<ScanRow> rows; /** Scratch stack of the rows to scan, reused by every view. */
+
+        /** \brief Tests the bit of a cell in a bitmap. */
+        bool test(const std::vector<std::uint64_t>& bitmap, int y, int x) const {
+            return bitmap[y * words + (x >> 6)] >> (x & 63) & 1;
+        }
+        /** \brief Checks whether a cell blocks the view, the cells out of bounds included. */
+        bool blocks(int y, int x) const {
+            return static_cast<unsigned int>(y) >= static_cast<unsigned int>(height)
+                || static_cast<unsigned int>(x) >= static_cast<unsigned int>(width) || test(opaque, y, x);
+        }
+        /** \brief Clears the rows of `visible` set by the previous views. */
+        void clear();
+        /** \brief Marks a cell as visible, appending it to `cells` the first time if given. */
+        void reveal(int y, int x, std::vector<Coordinates>* cells);
+        /** \brief Adds the view of a viewer to `visible`, with symmetric shadowcasting. */
+        void cast(const Coordinates& viewer, unsigned int radius, std::vector<Coordinates>* cells);
+
+    public:
+        /** \brief Constructor of the view of a field, reading the occupied cells as opaque.
+         *  \param field The field, which must outlive the FieldOfView.
+        */
+        FieldOfView(const Field&);
+
+        /** \brief Reads the opaque cells again from the occupancy of the field. */
+        void refresh();
+        /** \brief Reads the opaque cells again, as those whose Pawn satisfies a predicate.
+         *  \param isOpaque A predicate called with each Pawn, like the walls but not the other viewers.
+        */
+        template <typename Predicate>
+        void refresh(Predicate isOpaque) {
+            refresh();
+            for (int y = 0; y < height; y++) {
+                for (std::size_t word = 0; word < words; word++) {
+                    for (std::uint64_t bits = opaque[y * words + word]; bits != 0; bits &= bits - 1) {
+                        int x = static_cast<int>(word * 64 + countTrailingZeros(bits));
+                        if (!isOpaque(*field->getPawn(static_cast<unsigned short>(y), static_cast<unsigned short>(x))))
+                            opaque[y * words + word] &= ~(1ULL << (x & 63));
+                    }
+                }
+            }
+        }
+        /** \brief Sets whether a cell is opaque, ignoring the cells out of bounds. */
+        void setOpaque(const Coordinates&, bool);
+        /** \brief Reads whether a cell is occupied after it changed, like setOpaque with its occupancy. */
+        void update(const Coordinates&);
+        /** \brief Checks whether a cell is opaque, false if it is out of bounds. */
+        bool isOpaque(const Coordinates&) const;
+
+        /** \brief Checks whether two cells see each other along a Bresenham line.
+         *  \param from The first cell, which may be opaque.
+         *  \param to The second cell, which may be opaque.
+         *  \return True if no cell strictly between the two is opaque, as for a cell and itself; false if a cell is out of bounds.
+         *
+         *  The line is always drawn from the same end, so the result doesn't depend on the order of the cells.
+        */
+        bool lineOfSight(const Coordinates&, const Coordinates&) const;
+
+        /** \brief Computes the cells seen by a viewer, replacing the current view.
+         *  \param viewer The cell of the viewer, which may be opaque.
+         *  \param radius The farthest distance seen.
+         *  \throws `std::out_of_range` if the viewer is out of bounds.
+        */
+        void compute(const Coordinates&, unsigned int);
+        /** \brief Computes the cells seen by any of several viewers, replacing the current view.
+         *  \param viewers The cells of the viewers, like the Pawns of a team sharing their sight.
+         *  \param radius The farthest distance seen by each viewer.
+         *  \throws `std::out_of_range` if a viewer is out of bounds.
+        */
+        void compute(const std::vector<Coordinates>&, unsigned int);
+        /** \brief Lists the cells seen by each of several viewers.
+         *  \param viewers The cells of the viewers.
+         *  \param radius The farthest distance seen by each viewer.
+         *  \param cells Set to the cells seen by every viewer, one after the other; its capacity is reused.
+         *  \param offsets Set to the index in `cells` of the first cell of each viewer, followed by the size of `cells`.
+         *  \throws `std::out_of_range` if a viewer is out of bounds.
+         *
+         *  The cells seen by the viewer `i` are those from `cells[offsets[i]]` to `cells[offsets[i + 1]]` excluded.
+         *  The current view is left as the one of the last viewer.
+        */
+        void compute(const std::vector<Coordinates>&, unsigned int, std::vector<Coordinates>&, std::vector<std::size_t>&);
+
+        /** \brief Checks whether a cell is in the current view, false if it is out of bounds. */
+        bool isVisible(const Coordinates&) const;
+        /** \brief Returns the bits of a row of the current view, one per cell from the first column.
+         *  \param y The row, which must be in bounds.
+         *  \return A pointer to the (width + 63) / 64 words of the row.
+        */
+        const std::uint64_t* getVisibleRow(unsigned short) const;
+        /** \brief Returns the number of cells in the current view. */
+        std::size_t countVisible() const;
+    };
+};
@@ -0,0 +1,259 @@
+/** \file flowfield.cpp
+ *  \brief Implementation of the FlowField class.
+ *
+ *  The distances are computed with a breadth-first search seeded with every goal. A new
+ *  obstacle first invalidates the cells that lost every neighbour one step nearer to a goal,
+ *  in order of distance, then those cells and the cells around a removed obstacle are
+ *  relaxed from their neighbours and the lower distances spread with Dijkstra's algorithm.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see FlowField
+ *  \copyright GNU General Public License v3.0
+ */
+#include "flowfield.hpp"
+#include <algorithm> // std::fill, std::push_heap, std::pop_heap
+#include <functional> // std::greater
+#include <stdexcept> // std::out_of_range
+
+namespace sista {
+    static constexpr int DIRECTIONS[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+    FlowField::FlowField(const Field& field_, Connectivity connectivity_, Effect effect):
+        field(&field_), width(field_.getWidth()), height(field_.getHeight()),
+        connectivity(connectivity_), wrap(effect == Effect::PACMAN),
+        words((static_cast<std::size_t>(field_.getWidth()) + 63) / 64),
+        distances(static_cast<std::size_t>(field_.getWidth()) * field_.getHeight(), UNREACHABLE),
+        obstacles(words * field_.getHeight(), 0), goalBits(words * field_.getHeight(), 0) {}
+
+    bool FlowField::step(int& y, int& x, int dy, int dx) const {
+        y += dy;
+        x += dx;
+        if (wrap) { // A single step leaves the field by one cell at most
+            y += y < 0 ? height : (y >= height ? -height : 0);
+            x += x < 0 ? width : (x >= width ? -width : 0);
+            return true;
+        }
+        return static_cast<unsigned int>(y) < static_cast<unsigned int>(height)
+            && static_cast<unsigned int>(x) < static_cast<unsigned int>(width);
+    }
+    bool FlowField::move(int& y, int& x, int dy, int dx) const {
+        if (dy != 0 && dx != 0) { // No corner cutting
+            int row = y, column = x;
+            if (!step(row, column, dy, 0) || test(obstacles, row, column))
+                return false;
+            row = y, column = x;
+            if (!step(row, column, 0, dx) || test(obstacles, row, column))
+                return false;
+        }
+        return step(y, x, dy, dx) && !test(obstacles, y, x);
+    }
+
+    void FlowField::setGoals(const std::vector<Coordinates>& goals_) {
+        std::fill(goalBits.begin(), goalBits.end(), 0);
+        goals.clear();
+        for (const Coordinates& goal : goals_) {
+            if (goal.y >= height || goal.x >= width)
+                throw std::out_of_range("Goal coordinates are out of bounds");
+            if (!test(goalBits, goal.y, goal.x))
+                goals.push_back(static_cast<std::uint32_t>(index(goal.y, goal.x)));
+            goalBits[goal.y * words + (goal.x >> 6)] |= 1ULL << (goal.x & 63);
+        }
+    }
+    void FlowField::loadObstacles() {
+        std::fill(obstacles.begin(), obstacles.end(), 0);
+        for (int y = 0; y < height; y++) {
+            std::uint64_t* row = &obstacles[y * words];
+            for (int x = 0; x < width;) { // A word of occupancy at a time
+                unsigned int length;
+                std::uint64_t bits = field->getOccupancy(static_cast<unsigned short>(y), static_cast<unsigned short>(x), length);
+                unsigned int shift = x & 63;
+                row[x >> 6] |= bits << shift;
+                if (shift + length > 64) // The bits read straddle two words of the bitmap
+                    row[(x >> 6) + 1] |= bits >> (64 - shift);
+                x += length;
+            }
+            for (std::size_t word = 0; word < words; word++)
+                row[word] &= ~goalBits[y * words + word]; // The goals are reached even if occupied
+        }
+    }
+    void FlowField::search() {
+        std::fill(distances.begin(), distances.end(), UNREACHABLE);
+        frontier.assign(goals.begin(), goals.end());
+        for (std::uint32_t goal : goals)
+            distances[goal] = 0;
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        for (std::size_t head = 0; head < frontier.size(); head++) { // The frontier is the queue of the search
+            int y = static_cast<int>(frontier[head] / width), x = static_cast<int>(frontier[head] % width);
+            std::uint32_t distance = distances[frontier[head]] + 1;
+            for (int i = 0; i < count; i++) {
+                int row = y, column = x;
+                if (!move(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]))
+                    continue;
+                std::uint32_t& next = distances[index(row, column)];
+                if (next == UNREACHABLE) {
+                    next = distance;
+                    frontier.push_back(static_cast<std::uint32_t>(index(row, column)));
+                }
+            }
+        }
+    }
+
+    void FlowField::compute(const std::vector<Coordinates>& goals_) {
+        setGoals(goals_);
+        loadObstacles();
+        search();
+    }
+
+    void FlowField::invalidate(int y, int x) {
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        std::greater<std::pair<std::uint32_t, std::uint32_t>> later;
+        heap.clear();
+        auto candidates = [&](int row, int column, std::uint32_t distance) { // The neighbours that may have walked through the cell
+            for (int i = 0; i < count; i++) {
+                int y_ = row, x_ = column;
+                if (step(y_, x_, DIRECTIONS[i][0], DIRECTIONS[i][1]) && distances[index(y_, x_)] == distance + 1) {
+                    heap.emplace_back(distance + 1, static_cast<std::uint32_t>(index(y_, x_)));
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        };
+        std::uint32_t old = distances[index(y, x)];
+        distances[index(y, x)] = UNREACHABLE;
+        frontier.push_back(static_cast<std::uint32_t>(index(y, x)));
+        if (old == UNREACHABLE)
+            return;
+        candidates(y, x, old);
+        if (connectivity == Connectivity::EIGHT) { // The diagonals cutting the corner of the obstacle are gone too
+            for (int i = 0; i < 4; i++) {
+                int row = y, column = x;
+                if (step(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]) && distances[index(row, column)] != UNREACHABLE) {
+                    heap.emplace_back(distances[index(row, column)], static_cast<std::uint32_t>(index(row, column)));
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+        // In order of distance, so the cells nearer to the goals are final when a cell is checked
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [distance, cell] = heap.back();
+            heap.pop_back();
+            if (distances[cell] != distance || distance == 0)
+                continue; // Already invalidated, or a goal
+            int row = static_cast<int>(cell / width), column = static_cast<int>(cell % width);
+            bool supported = false; // Whether a neighbour one step nearer is still valid
+            for (int i = 0; i < count && !supported; i++) {
+                int y_ = row, x_ = column;
+                supported = move(y_, x_, DIRECTIONS[i][0], DIRECTIONS[i][1]) && distances[index(y_, x_)] == distance - 1;
+            }
+            if (supported)
+                continue;
+            distances[cell] = UNREACHABLE;
+            frontier.push_back(cell);
+            candidates(row, column, distance);
+        }
+    }
+    void FlowField::relax(int y, int x) {
+        if (test(obstacles, y, x))
+            return;
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        std::uint32_t& distance = distances[index(y, x)];
+        for (int i = 0; i < count; i++) {
+            int row = y, column = x;
+            if (!move(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]))
+                continue;
+            std::uint32_t neighbour = distances[index(row, column)];
+            if (neighbour != UNREACHABLE && neighbour + 1 < distance)
+                distance = neighbour + 1;
+        }
+        if (distance != UNREACHABLE) {
+            heap.emplace_back(distance, static_cast<std::uint32_t>(index(y, x)));
+            std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<std::uint32_t, std::uint32_t>>());
+        }
+    }
+    void FlowField::propagate() {
+        std::greater<std::pair<std::uint32_t, std::uint32_t>> later;
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [distance, cell] = heap.back();
+            heap.pop_back();
+            if (distances[cell] != distance)
+                continue; // Lowered again since
+            int y = static_cast<int>(cell / width), x = static_cast<int>(cell % width);
+            for (int i = 0; i < count; i++) {
+                int row = y, column = x;
+                if (!move(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]) || distances[index(row, column)] <= distance + 1)
+                    continue;
+                distances[index(row, column)] = distance + 1;
+                heap.emplace_back(distance + 1, static_cast<std::uint32_t>(index(row, column)));
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+
+    void FlowField::setObstacle(const Coordinates& coordinates, bool obstacle) {
+        int y = coordinates.y, x = coordinates.x;
+        if (y >= height || x >= width || test(goalBits, y, x) || test(obstacles, y, x) == obstacle)
+            return;
+        std::uint64_t& word = obstacles[y * words + (x >> 6)];
+        word = obstacle ? word | 1ULL << (x & 63) : word & ~(1ULL << (x & 63));
+        frontier.clear();
+        if (obstacle) {
+            invalidate(y, x); // Lists the cells whose distance was lost
+        } else {
+            frontier.push_back(static_cast<std::uint32_t>(index(y, x)));
+        }
+        heap.clear();
+        for (std::uint32_t cell : frontier)
+            relax(static_cast<int>(cell / width), static_cast<int>(cell % width));
+        if (connectivity == Connectivity::EIGHT) { // The diagonals around the cell changed too
+            for (int i = 0; i < 4; i++) {
+                int row = y, column = x;
+                if (step(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]))
+                    relax(row, column);
+            }
+        }
+        propagate();
+    }
+    void FlowField::update(const Coordinates& coordinates) {
+        setObstacle(coordinates, field->isOccupied(coordinates));
+    }
+
+    std::uint32_t FlowField::getDistance(const Coordinates& coordinates) const {
+        if (coordinates.y >= height || coordinates.x >= width)
+            return UNREACHABLE;
+        return distances[index(coordinates.y, coordinates.x)];
+    }
+    bool FlowField::isObstacle(const Coordinates& coordinates) const {
+        return coordinates.y < height && coordinates.x < width && test(obstacles, coordinates.y, coordinates.x);
+    }
+    bool FlowField::nextStep(const Coordinates& from, Coordinates& next) const {
+        if (from.y >= height || from.x >= width)
+            return false;
+        std::uint32_t best = distances[index(from.y, from.x)];
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        bool found = false;
+        for (int i = 0; i < count; i++) {
+            int row = from.y, column = from.x;
+            if (move(row, column, DIRECTIONS[i][0], DIRECTIONS[i][1]) && distances[index(row, column)] < best) {
+                best = distances[index(row, column)];
+                next = Coordinates(static_cast<unsigned short>(row), static_cast<unsigned short>(column));
+                found = true;
+            }
+        }
+        return found;
+    }
+    std::size_t FlowField::steer(SwappableField& target, const std::vector<std::shared_ptr<Pawn>>& pawns) const {
+        std::size_t steps = 0;
+        Coordinates next;
+        for (const std::shared_ptr<Pawn>& pawn : pawns) {
+            if (pawn != nullptr && nextStep(pawn->getCoordinates(), next)) {
+                target.addPawnToSwap(pawn.get(), next);
+                steps++;
+            }
+        }
+        return steps;
+    }
+};
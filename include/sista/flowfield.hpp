@@ -0,0 +1,148 @@
+/** \file flowfield.hpp
+ *  \brief FlowField class header file.
+ *
+ *  This file contains the FlowField class, a distance map of a Field towards a set of goal
+ *  cells. It is computed with a single breadth-first search from every goal at once, and then
+ *  read by any number of Pawns, each finding its next step among the neighbours of its cell:
+ *  thousands of Pawns chasing the same goals cost one search instead of one search each.
+ *
+ *  When an obstacle appears or disappears, only the distances that change are recomputed.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see FlowField
+ *  \see PathFinder
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <memory> // std::shared_ptr
+#include <utility> // std::pair
+#include <vector> // std::vector
+#include "field.hpp"
+
+namespace sista {
+    /** \class FlowField
+     *  \brief Distances from every cell of a Field to the nearest of a set of goals.
+     *
+     *  A distance is the number of steps of the shortest walk through the cells that aren't
+     *  obstacles, with the moves of a Connectivity: with EIGHT a diagonal step counts as one,
+     *  and isn't allowed if it cuts the corner of an obstacle, as in PathFinder. The obstacles are
+     *  the occupied cells, or those whose Pawn satisfies a predicate, except the goals.
+     *
+     *  The distances are stored for every cell of the field, so a FlowField is meant for fields
+     *  of up to a few million cells. The field must keep its dimensions and outlive the FlowField.
+     *
+     *  \see PathFinder
+     *  \see SwappableField::addPawnToSwap
+    */
+    class FlowField {
+    public:
+        static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFF; /** Distance of the cells with no walk to a goal. */
+
+    private:
+        const Field* field; /** The field the distances are computed on. */
+        int width; /** Width of the field. */
+        int height; /** Height of the field. */
+        Connectivity connectivity; /** Moves allowed from a cell. */
+        bool wrap; /** Whether the walks wrap around the edges (PACMAN). */
+        std::size_t words; /** Words of a row of the bitmaps. */
+        std::vector<std::uint32_t> distances; /** Distance of each cell, row by row. */
+        std::vector<std::uint64_t> obstacles; /** A bit per cell, set for the obstacles. */
+        std::vector<std::uint64_t> goalBits; /** A bit per cell, set for the goals. */
+        std::vector<std::uint32_t> goals; /** Index of each goal. */
+        std::vector<std::uint32_t> frontier; /** Scratch list of cells, reused by every search and update. */
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> heap; /** Scratch heap of (distance, cell), reused by every update. */
+
+        /** \brief Returns the index of a cell in the row-major storage. */
+        std::size_t index(int y, int x) const {
+            return static_cast<std::size_t>(y) * width + x;
+        }
+        /** \brief Tests the bit of a cell in a bitmap. */
+        bool test(const std::vector<std::uint64_t>& bitmap, int y, int x) const {
+            return bitmap[y * words + (x >> 6)] >> (x & 63) & 1;
+        }
+        /** \brief Moves a position by one step, wrapping it or returning false at the edges. */
+        bool step(int& y, int& x, int dy, int dx) const;
+        /** \brief Checks whether a move from (y, x) to the cell one step away is allowed, setting (y, x) to it. */
+        bool move(int& y, int& x, int dy, int dx) const;
+        /** \brief Sets the goals, checking their bounds, and clears the distances. */
+        void setGoals(const std::vector<Coordinates>&);
+        /** \brief Reads the obstacles from the occupancy of the field, excluding the goals. */
+        void loadObstacles();
+        /** \brief Computes every distance with a breadth-first search from all goals. */
+        void search();
+        /** \brief Sets the cells depending on a new obstacle to UNREACHABLE, listing them in `frontier`. */
+        void invalidate(int y, int x);
+        /** \brief Lowers the distance of a cell to one more than its nearest neighbour, queueing it if it changed. */
+        void relax(int y, int x);
+        /** \brief Lowers the distances reachable from the queued cells, in order of distance. */
+        void propagate();
+
+    public:
+        /** \brief Constructor of an empty flow field, with every cell UNREACHABLE.
+         *  \param field The field, which must outlive the flow field.
+         *  \param connectivity The moves allowed from a cell.
+         *  \param effect The topology of the field: PACMAN wraps around the edges, the other effects don't.
+        */
+        FlowField(const Field&, Connectivity=Connectivity::FOUR, Effect=Effect::CLAMP);
+
+        /** \brief Computes the distances to a set of goals, with the occupied cells as obstacles.
+         *  \param goals The goal cells, which may be occupied.
+         *  \throws `std::out_of_range` if a goal is out of bounds.
+        */
+        void compute(const std::vector<Coordinates>&);
+        /** \brief Computes the distances to a set of goals, with the cells of some Pawns as obstacles.
+         *  \param goals The goal cells, which may be occupied.
+         *  \param isObstacle A predicate called with each Pawn, like the walls of a maze but not the Pawns steered by the flow field.
+         *  \throws `std::out_of_range` if a goal is out of bounds.
+        */
+        template <typename Predicate>
+        void compute(const std::vector<Coordinates>& goals_, Predicate isObstacle) {
+            setGoals(goals_);
+            loadObstacles();
+            for (int y = 0; y < height; y++) {
+                for (std::size_t word = 0; word < words; word++) {
+                    for (std::uint64_t bits = obstacles[y * words + word]; bits != 0; bits &= bits - 1) {
+                        int x = static_cast<int>(word * 64 + countTrailingZeros(bits));
+                        if (!isObstacle(*field->getPawn(static_cast<unsigned short>(y), static_cast<unsigned short>(x))))
+                            obstacles[y * words + word] &= ~(1ULL << (x & 63));
+                    }
+                }
+            }
+            search();
+        }
+
+        /** \brief Adds or removes an obstacle, recomputing only the distances that change.
+         *  \param coordinates The cell; the goals are never obstacles.
+         *  \param obstacle Whether the cell is an obstacle.
+         *
+         *  The cost grows with the number of cells whose distance changes, not with the field.
+        */
+        void setObstacle(const Coordinates&, bool);
+        /** \brief Reads whether a cell is occupied after it changed, like setObstacle with its occupancy. */
+        void update(const Coordinates&);
+
+        /** \brief Returns the distance of a cell to the nearest goal, UNREACHABLE if there is no walk or it is out of bounds. */
+        std::uint32_t getDistance(const Coordinates&) const;
+        /** \brief Checks whether a cell is an obstacle of the flow field. */
+        bool isObstacle(const Coordinates&) const;
+        /** \brief Finds the step towards the nearest goal, in constant time.
+         *  \param from The cell to step from, which may be occupied.
+         *  \param next Set to the neighbour of `from` nearest to a goal.
+         *  \return False if `from` is a goal, has no neighbour nearer to a goal, or is out of bounds.
+        */
+        bool nextStep(const Coordinates&, Coordinates&) const;
+        /** \brief Queues the next step of each Pawn as a swap of a SwappableField.
+         *  \param field The SwappableField holding the Pawns, often the field of the flow field.
+         *  \param pawns The Pawns to steer; those without a next step stay.
+         *  \return The number of steps queued with SwappableField::addPawnToSwap.
+         *
+         *  SwappableField::applySwaps then moves every Pawn at once, resolving the conflicts.
+        */
+        std::size_t steer(SwappableField&, const std::vector<std::shared_ptr<Pawn>>&) const;
+    };
+};
@@ -0,0 +1,788 @@
+/** \file grid.hpp
+ *  \brief Sparse storage of the cells of a Field.
+ *
+ *  This header declares FlatMap, an open-addressing hash table with 32-bit keys, and
+ *  ChunkedGrid, a 2D grid split in square chunks that are allocated when a cell of theirs
+ *  becomes non-empty and set aside for reuse when all of their cells are empty again. The chunks are
+ *  found through a FlatMap, so the memory of a grid scales with the occupied area and not
+ *  with its size: a 60000x60000 Field with a few thousand pawns takes a few megabytes.
+ *
+ *  DenseGrid stores every cell in a single array instead, which is smaller and faster for
+ *  boards of a few thousand cells, and CellGrid holds either layout, chosen by a Storage policy
+ *  when the Field is constructed.
+ *
+ *  Both layouts keep an occupancy bitboard next to the cells, one bit per non-empty cell, so
+ *  that emptiness tests and counts over rectangles work on 64 cells at a time with popcount:
+ *  a 64-bit word per chunk for ChunkedGrid, and row-aligned 64-bit words for DenseGrid.
+ *
+ *  The containers allocate from a `std::pmr::memory_resource`, like the Field owning them.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see ChunkedGrid
+ *  \see DenseGrid
+ *  \see CellGrid
+ *  \see Field
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::vector
+#include <vector> // std::pmr::vector
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+#include <utility> // std::move, std::swap
+#include <new> // placement new
+#include <algorithm> // std::min, std::max
+
+namespace sista {
+    /** \brief Returns the number of set bits of a word. */
+    inline unsigned int popcount(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_popcountll(bits));
+#else
+        bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+        bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+        bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned int>((bits * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+    /** \brief Returns a word with the lowest `count` bits set, for `count` up to 64. */
+    inline std::uint64_t lowBits(unsigned int count) {
+        return count >= 64 ? ~0ULL : (1ULL << count) - 1;
+    }
+    /** \brief Returns the index of the lowest set bit of a non-zero word. */
+    inline unsigned int countTrailingZeros(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctzll(bits));
+#else
+        return popcount((bits & (0 - bits)) - 1);
+#endif
+    }
+    /** \brief Returns the index of the set bit of rank `rank` of a word, counting from the lowest.
+     *  \param bits The word, with more than `rank` set bits.
+     *  \param rank The number of set bits below the one to find.
+    */
+    inline unsigned int selectBit(std::uint64_t bits, unsigned int rank) {
+        unsigned int base = 0;
+        for (unsigned int width = 32; width >= 8; width /= 2) { // Halves the word by popcount, down to a byte
+            unsigned int low = popcount(bits & lowBits(width));
+            if (rank >= low) {
+                rank -= low;
+                bits >>= width;
+                base += width;
+            }
+        }
+        for (; rank > 0; rank--) // Then drops the lowest set bits of the byte
+            bits &= bits - 1;
+        return base + countTrailingZeros(bits);
+    }
+
+    /** \enum Storage
+     *  \brief Layout of the cells of a Field.
+     *
+     *  \see CellGrid
+     *  \see Field
+    */
+    enum class Storage {
+        AUTOMATIC = 0, /** DENSE up to CellGrid::DENSE_CELLS cells, CHUNKED for larger fields. */
+        DENSE = 1, /** Every cell in a single array, allocated with the field. */
+        CHUNKED = 2 /** Only the chunks with non-empty cells, for large and mostly empty fields. */
+    };
+
+    /** \class FlatMap
+     *  \brief Hash table from 32-bit keys to values, with linear probing.
+     *
+     *  The slots live in a single `std::pmr::vector` whose capacity is kept by clear(), so a
+     *  table refilled with the same number of keys every frame stops allocating. Erasing shifts
+     *  the following slots back instead of leaving tombstones.
+     *
+     *  \tparam V The type of the values, default constructible.
+    */
+    template <typename V>
+    class FlatMap {
+    private:
+        /** \brief A slot of the table. */
+        struct Slot {
+            std::uint32_t key = 0; /** Key of the entry. */
+            bool used = false; /** Whether the slot holds an entry. */
+            V value{}; /** Value of the entry. */
+        };
+
+        std::pmr::vector<Slot> slots; /** Slots of the table, a power of two of them or none. */
+        std::size_t count; /** Number of entries. */
+
+        /** \brief Returns the slot where the search of a key starts. */
+        std::size_t home(std::uint32_t key) const {
+            key ^= key >> 16; // Mixes the bits, as keys often differ only in the low ones
+            key *= 0x7feb352dU;
+            key ^= key >> 15;
+            key *= 0x846ca68bU;
+            key ^= key >> 16;
+            return key & (slots.size() - 1);
+        }
+        /** \brief Returns the slot holding a key, or `slots.size()` if the key is absent. */
+        std::size_t locate(std::uint32_t key) const {
+            if (slots.empty())
+                return 0;
+            for (std::size_t i = home(key);; i = (i + 1) & (slots.size() - 1)) {
+                if (!slots[i].used)
+                    return slots.size();
+                if (slots[i].key == key)
+                    return i;
+            }
+        }
+        /** \brief Moves the entries into a table with the given number of slots. */
+        void rehash(std::size_t capacity) {
+            std::pmr::vector<Slot> old(capacity, slots.get_allocator());
+            old.swap(slots);
+            for (Slot& slot : old) {
+                if (!slot.used)
+                    continue;
+                std::size_t i = home(slot.key);
+                while (slots[i].used)
+                    i = (i + 1) & (slots.size() - 1);
+                slots[i] = std::move(slot);
+            }
+        }
+
+    public:
+        /** \brief Constructor of an empty table, which allocates nothing until the first insert.
+         *  \param resource The memory resource of the slots.
+        */
+        explicit FlatMap(std::pmr::memory_resource* resource=std::pmr::get_default_resource()):
+            slots(resource), count(0) {}
+
+        /** \brief Returns the value of a key, or `nullptr` if the key is absent. */
+        V* find(std::uint32_t key) {
+            std::size_t i = locate(key);
+            return i < slots.size() ? &slots[i].value : nullptr;
+        }
+        /** \brief Returns the value of a key, or `nullptr` if the key is absent. */
+        const V* find(std::uint32_t key) const {
+            std::size_t i = locate(key);
+            return i < slots.size() ? &slots[i].value : nullptr;
+        }
+        /** \brief Adds a key that is not in the table yet.
+         *  \param key The key, which must be absent.
+         *  \param value The value of the key.
+         *  \return A reference to the stored value, valid until the next insert or erase.
+        */
+        V& insert(std::uint32_t key, V value) {
+            if ((count + 1) * 2 > slots.size()) // At most half full, so probes stay short
+                rehash(slots.empty() ? 16 : slots.size() * 2);
+            std::size_t i = home(key);
+            while (slots[i].used)
+                i = (i + 1) & (slots.size() - 1);
+            slots[i].key = key;
+            slots[i].used = true;
+            slots[i].value = std::move(value);
+            count++;
+            return slots[i].value;
+        }
+        /** \brief Removes a key, if present. */
+        void erase(std::uint32_t key) {
+            std::size_t hole = locate(key);
+            if (hole >= slots.size())
+                return;
+            std::size_t mask = slots.size() - 1;
+            for (std::size_t i = (hole + 1) & mask; slots[i].used; i = (i + 1) & mask) {
+                std::size_t start = home(slots[i].key);
+                // The entry can fill the hole only if its probe sequence passes through the hole
+                if (((i - start) & mask) >= ((i - hole) & mask)) {
+                    slots[hole] = std::move(slots[i]);
+                    hole = i;
+                }
+            }
+            slots[hole].used = false;
+            slots[hole].value = V();
+            count--;
+        }
+        /** \brief Removes every entry, keeping the slots allocated. */
+        void clear() {
+            if (count == 0)
+                return;
+            for (Slot& slot : slots) {
+                slot.used = false;
+                slot.value = V();
+            }
+            count = 0;
+        }
+        /** \brief Calls a function with the key and the value of each entry, in no particular order. */
+        template <typename Function>
+        void forEach(Function function) {
+            for (Slot& slot : slots)
+                if (slot.used)
+                    function(slot.key, slot.value);
+        }
+        /** \brief Calls a function with the key and the value of each entry, in no particular order. */
+        template <typename Function>
+        void forEach(Function function) const {
+            for (const Slot& slot : slots)
+                if (slot.used)
+                    function(slot.key, slot.value);
+        }
+
+        /** \brief Returns the number of entries. */
+        std::size_t size() const {
+            return count;
+        }
+        /** \brief Returns the memory resource of the slots. */
+        std::pmr::memory_resource* getMemoryResource() const {
+            return slots.get_allocator().resource();
+        }
+    };
+
+    /** \class ChunkedGrid
+     *  \brief 2D grid storing only the chunks with non-empty cells.
+     *
+     *  The grid is split in chunks of SIZE x SIZE cells. A chunk is allocated when one of its
+     *  cells is set to a non-empty value and moved to a free list of the grid when its last
+     *  non-empty cell is emptied, so cells are modified through set() and take() only, which
+     *  keep their occupancy bits. A cell is empty when it equals `T()`, e.g. a null
+     *  `std::shared_ptr` or a zero counter.
+     *
+     *  The chunks of the free list are reused before new ones are allocated, so a pawn going
+     *  back and forth across the edge of a chunk doesn't allocate, which matters with a
+     *  monotonic arena that never reuses what is freed. They are freed by shrink().
+     *
+     *  As a chunk has 64 cells, its occupancy is a single word: bit `row * SIZE + column`.
+     *
+     *  Positions are not checked: the Field owning the grid checks its bounds.
+     *
+     *  \tparam T The type of the cells, default constructible and comparable with `==`.
+     *  \see FlatMap
+     *  \see Field
+    */
+    template <typename T>
+    class ChunkedGrid {
+    public:
+        static constexpr unsigned int SHIFT = 3; /** Log2 of the side of a chunk. */
+        static constexpr unsigned int SIZE = 1U << SHIFT; /** Side of a chunk, in cells. */
+
+    private:
+        static constexpr unsigned int MASK = SIZE - 1;
+
+        /** \brief A chunk of cells, row by row. */
+        struct Chunk {
+            T cells[SIZE * SIZE]; /** Cells of the chunk. */
+            std::uint64_t occupied = 0; /** Bit of each non-empty cell, set aside when none is left. */
+            Chunk* next = nullptr; /** Next chunk of the free list, while the chunk is on it. */
+        };
+
+        FlatMap<Chunk*> directory; /** Chunks by (chunk row << 16 | chunk column). */
+        Chunk* spare = nullptr; /** Free list of empty chunks, linked through `next`. */
+        std::size_t spares = 0; /** Number of chunks on the free list. */
+
+        static std::uint32_t key(unsigned int y, unsigned int x) {
+            return (static_cast<std::uint32_t>(y >> SHIFT) << 16) | (x >> SHIFT);
+        }
+        static unsigned int offset(unsigned int y, unsigned int x) {
+            return ((y & MASK) << SHIFT) | (x & MASK);
+        }
+        static bool isEmpty(const T& value) {
+            return value == T();
+        }
+        /** \brief Returns the bits of the cells of a chunk inside a rectangle, see countOccupied. */
+        static std::uint64_t chunkMask(unsigned int chunkY, unsigned int chunkX,
+                                       unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) {
+            unsigned int y0 = chunkY << SHIFT, x0 = chunkX << SHIFT;
+            unsigned int fromY = top > y0 ? top - y0 : 0, toY = bottom - y0 < SIZE ? bottom - y0 : SIZE;
+            unsigned int fromX = left > x0 ? left - x0 : 0, toX = right - x0 < SIZE ? right - x0 : SIZE;
+            std::uint64_t row = lowBits(toX) & ~lowBits(fromX); // The columns of a row of the chunk
+            std::uint64_t columns = row * 0x0101010101010101ULL; // ...repeated on every row
+            return columns & lowBits(toY * SIZE) & ~lowBits(fromY * SIZE);
+        }
+        static const T& empty() {
+            static const T value{};
+            return value;
+        }
+        void destroy(Chunk* chunk) {
+            std::pmr::polymorphic_allocator<Chunk> allocator(directory.getMemoryResource());
+            chunk->~Chunk();
+            allocator.deallocate(chunk, 1);
+        }
+        /** \brief Returns an empty chunk, from the free list if it has any. */
+        Chunk* acquire() {
+            if (spare == nullptr) {
+                std::pmr::polymorphic_allocator<Chunk> allocator(directory.getMemoryResource());
+                Chunk* chunk = allocator.allocate(1);
+                return new (chunk) Chunk();
+            }
+            Chunk* chunk = spare;
+            spare = chunk->next;
+            chunk->next = nullptr;
+            spares--;
+            return chunk;
+        }
+        /** \brief Puts a chunk whose cells are all empty on the free list. */
+        void release(Chunk* chunk) {
+            chunk->next = spare;
+            spare = chunk;
+            spares++;
+        }
+
+    public:
+        /** \brief Constructor of an empty grid, which allocates nothing until a cell is set.
+         *  \param resource The memory resource of the chunks and of the directory.
+        */
+        explicit ChunkedGrid(std::pmr::memory_resource* resource=std::pmr::get_default_resource()):
+            directory(resource) {}
+        /** \brief Destructor freeing every chunk. */
+        ~ChunkedGrid() {
+            clear();
+            shrink();
+        }
+
+        ChunkedGrid(const ChunkedGrid&) = delete;
+        ChunkedGrid& operator=(const ChunkedGrid&) = delete;
+
+        /** \brief Returns a cell, or an empty value if its chunk is not allocated. */
+        const T& get(unsigned int y, unsigned int x) const {
+            Chunk* const* chunk = directory.find(key(y, x));
+            return chunk != nullptr ? (*chunk)->cells[offset(y, x)] : empty();
+        }
+        /** \brief Returns the cells of a row from a position to the end of its chunk.
+         *  \param y The row.
+         *  \param x The first column.
+         *  \param length Set to the number of contiguous cells, up to the next multiple of SIZE.
+         *  \return A pointer to the contiguous cells, or `nullptr` if they are all empty.
+        */
+        const T* span(unsigned int y, unsigned int x, unsigned int& length) const {
+            length = SIZE - (x & MASK);
+            Chunk* const* chunk = directory.find(key(y, x));
+            return chunk != nullptr ? &(*chunk)->cells[offset(y, x)] : nullptr;
+        }
+        /** \brief Sets a cell, allocating or setting aside its chunk when needed.
+         *  \param y The row.
+         *  \param x The column.
+         *  \param value The new value of the cell.
+        */
+        void set(unsigned int y, unsigned int x, T value) {
+            bool emptying = isEmpty(value);
+            Chunk** found = directory.find(key(y, x));
+            Chunk* chunk;
+            if (found != nullptr) {
+                chunk = *found;
+            } else if (emptying) { // The cell is already empty
+                return;
+            } else {
+                chunk = acquire();
+                directory.insert(key(y, x), chunk);
+            }
+            chunk->cells[offset(y, x)] = std::move(value);
+            std::uint64_t bit = 1ULL << offset(y, x);
+            if (!emptying) {
+                chunk->occupied |= bit;
+            } else if ((chunk->occupied &= ~bit) == 0) {
+                directory.erase(key(y, x));
+                release(chunk);
+            }
+        }
+        /** \brief Empties a cell and returns its previous value. */
+        T take(unsigned int y, unsigned int x) {
+            Chunk** found = directory.find(key(y, x));
+            if (found == nullptr)
+                return T();
+            Chunk* chunk = *found;
+            T& cell = chunk->cells[offset(y, x)];
+            T value = std::move(cell);
+            cell = T();
+            if (!isEmpty(value) && (chunk->occupied &= ~(1ULL << offset(y, x))) == 0) {
+                directory.erase(key(y, x));
+                release(chunk);
+            }
+            return value;
+        }
+        /** \brief Exchanges the values of two cells. */
+        void swap(unsigned int y1, unsigned int x1, unsigned int y2, unsigned int x2) {
+            T first = take(y1, x1);
+            T second = take(y2, x2);
+            set(y1, x1, std::move(second));
+            set(y2, x2, std::move(first));
+        }
+        /** \brief Empties every cell, moving every chunk to the free list. */
+        void clear() {
+            directory.forEach([this](std::uint32_t, Chunk*& chunk) {
+                for (std::uint64_t bits = chunk->occupied; bits != 0; bits &= bits - 1)
+                    chunk->cells[countTrailingZeros(bits)] = T();
+                chunk->occupied = 0;
+                release(chunk);
+            });
+            directory.clear();
+        }
+        /** \brief Frees the chunks of the free list, returning their memory to the resource. */
+        void shrink() {
+            while (spare != nullptr) {
+                Chunk* chunk = spare;
+                spare = chunk->next;
+                destroy(chunk);
+            }
+            spares = 0;
+        }
+
+        /** \brief Checks whether a cell is non-empty, from its occupancy bit. */
+        bool occupied(unsigned int y, unsigned int x) const {
+            Chunk* const* chunk = directory.find(key(y, x));
+            return chunk != nullptr && ((*chunk)->occupied >> offset(y, x) & 1);
+        }
+        /** \brief Returns the occupancy bits of a row from a position to the end of its chunk.
+         *  \param y The row.
+         *  \param x The first column.
+         *  \param length Set to the number of cells, up to the next multiple of SIZE.
+         *  \return The bits of the cells, bit `i` for column `x + i`; the bits past `length` are zero.
+        */
+        std::uint64_t occupancy(unsigned int y, unsigned int x, unsigned int& length) const {
+            length = SIZE - (x & MASK);
+            Chunk* const* chunk = directory.find(key(y, x));
+            if (chunk == nullptr)
+                return 0;
+            return (((*chunk)->occupied >> ((y & MASK) * SIZE)) & lowBits(SIZE)) >> (x & MASK);
+        }
+        /** \brief Counts the non-empty cells of the rectangle [top, bottom) x [left, right).
+         *
+         *  Each chunk takes a popcount; if the rectangle covers more chunks than are allocated,
+         *  the allocated chunks are visited instead of the rectangle.
+        */
+        std::size_t countOccupied(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const {
+            if (top >= bottom || left >= right)
+                return 0;
+            unsigned int fromY = top >> SHIFT, toY = (bottom - 1) >> SHIFT;
+            unsigned int fromX = left >> SHIFT, toX = (right - 1) >> SHIFT;
+            std::size_t count = 0;
+            if (static_cast<std::size_t>(toY - fromY + 1) * (toX - fromX + 1) > directory.size()) {
+                directory.forEach([&](std::uint32_t chunkKey, Chunk* const& chunk) {
+                    unsigned int chunkY = chunkKey >> 16, chunkX = chunkKey & 0xffff;
+                    if (chunkY >= fromY && chunkY <= toY && chunkX >= fromX && chunkX <= toX)
+                        count += popcount(chunk->occupied & chunkMask(chunkY, chunkX, top, left, bottom, right));
+                });
+                return count;
+            }
+            for (unsigned int chunkY = fromY; chunkY <= toY; chunkY++) {
+                for (unsigned int chunkX = fromX; chunkX <= toX; chunkX++) {
+                    Chunk* const* chunk = directory.find(chunkY << 16 | chunkX);
+                    if (chunk != nullptr)
+                        count += popcount((*chunk)->occupied & chunkMask(chunkY, chunkX, top, left, bottom, right));
+                }
+            }
+            return count;
+        }
+
+        /** \brief Returns the number of chunks with non-empty cells. */
+        std::size_t chunkCount() const {
+            return directory.size();
+        }
+        /** \brief Returns the number of empty chunks kept on the free list. */
+        std::size_t spareCount() const {
+            return spares;
+        }
+        /** \brief Returns the memory resource of the chunks and of the directory. */
+        std::pmr::memory_resource* getMemoryResource() const {
+            return directory.getMemoryResource();
+        }
+    };
+
+    /** \class DenseGrid
+     *  \brief 2D grid storing every cell, row by row, in a single array.
+     *
+     *  Same interface as ChunkedGrid. The array is allocated by the constructor and is never
+     *  resized, so a DenseGrid doesn't allocate after its construction. The occupancy bits
+     *  start a new word on each row, so that a row is scanned without shifting across words.
+     *
+     *  \tparam T The type of the cells, default constructible and comparable with `==`.
+     *  \see ChunkedGrid
+    */
+    template <typename T>
+    class DenseGrid {
+    private:
+        std::pmr::vector<T> cells; /** Cells of the grid [y * width + x]. */
+        std::pmr::vector<std::uint64_t> bits; /** Occupancy of the cells, bit x % 64 of [y * words + x / 64]. */
+        unsigned int width; /** Number of columns. */
+        unsigned int words; /** Number of occupancy words of each row. */
+
+        void mark(unsigned int y, unsigned int x, bool occupied_) {
+            std::uint64_t& word = bits[static_cast<std::size_t>(y) * words + (x >> 6)];
+            std::uint64_t bit = 1ULL << (x & 63);
+            word = occupied_ ? word | bit : word & ~bit;
+        }
+
+    public:
+        /** \brief Constructor allocating every cell, empty.
+         *  \param width The number of columns, 0 to allocate nothing.
+         *  \param height The number of rows.
+         *  \param resource The memory resource of the cells.
+        */
+        DenseGrid(unsigned int width_, unsigned int height, std::pmr::memory_resource* resource=std::pmr::get_default_resource()):
+            cells(static_cast<std::size_t>(width_) * height, resource),
+            bits(static_cast<std::size_t>((width_ + 63) / 64) * height, resource),
+            width(width_), words((width_ + 63) / 64) {}
+
+        /** \brief Returns a cell. */
+        const T& get(unsigned int y, unsigned int x) const {
+            return cells[static_cast<std::size_t>(y) * width + x];
+        }
+        /** \brief Returns the cells of a row from a position to the end of the row.
+         *  \param length Set to the number of contiguous cells.
+        */
+        const T* span(unsigned int y, unsigned int x, unsigned int& length) const {
+            length = width - x;
+            return &cells[static_cast<std::size_t>(y) * width + x];
+        }
+        /** \brief Sets a cell. */
+        void set(unsigned int y, unsigned int x, T value) {
+            mark(y, x, !(value == T()));
+            cells[static_cast<std::size_t>(y) * width + x] = std::move(value);
+        }
+        /** \brief Empties a cell and returns its previous value. */
+        T take(unsigned int y, unsigned int x) {
+            T& cell = cells[static_cast<std::size_t>(y) * width + x];
+            T value = std::move(cell);
+            cell = T();
+            mark(y, x, false);
+            return value;
+        }
+        /** \brief Exchanges the values of two cells. */
+        void swap(unsigned int y1, unsigned int x1, unsigned int y2, unsigned int x2) {
+            bool first = occupied(y1, x1), second = occupied(y2, x2);
+            std::swap(cells[static_cast<std::size_t>(y1) * width + x1], cells[static_cast<std::size_t>(y2) * width + x2]);
+            mark(y1, x1, second);
+            mark(y2, x2, first);
+        }
+        /** \brief Empties every cell, keeping the array. */
+        void clear() {
+            for (T& cell : cells)
+                cell = T();
+            for (std::uint64_t& word : bits)
+                word = 0;
+        }
+
+        /** \brief Checks whether a cell is non-empty, from its occupancy bit. */
+        bool occupied(unsigned int y, unsigned int x) const {
+            return bits[static_cast<std::size_t>(y) * words + (x >> 6)] >> (x & 63) & 1;
+        }
+        /** \brief Returns the occupancy bits of a row from a position to the end of its word.
+         *  \param length Set to the number of cells, up to the next multiple of 64 or the end of the row.
+         *  \return The bits of the cells, bit `i` for column `x + i`; the bits past `length` are zero.
+        */
+        std::uint64_t occupancy(unsigned int y, unsigned int x, unsigned int& length) const {
+            length = 64 - (x & 63);
+            length = length < width - x ? length : width - x;
+            return bits[static_cast<std::size_t>(y) * words + (x >> 6)] >> (x & 63);
+        }
+        /** \brief Counts the non-empty cells of the rectangle [top, bottom) x [left, right), a word at a time. */
+        std::size_t countOccupied(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const {
+            if (top >= bottom || left >= right)
+                return 0;
+            unsigned int first = left >> 6, last = (right - 1) >> 6;
+            std::uint64_t firstMask = ~lowBits(left & 63), lastMask = lowBits(((right - 1) & 63) + 1);
+            std::size_t count = 0;
+            for (unsigned int y = top; y < bottom; y++) {
+                const std::uint64_t* row = &bits[static_cast<std::size_t>(y) * words];
+                if (first == last) {
+                    count += popcount(row[first] & firstMask & lastMask);
+                    continue;
+                }
+                count += popcount(row[first] & firstMask) + popcount(row[last] & lastMask);
+                for (unsigned int word = first + 1; word < last; word++)
+                    count += popcount(row[word]);
+            }
+            return count;
+        }
+
+        /** \brief Returns the memory resource of the cells. */
+        std::pmr::memory_resource* getMemoryResource() const {
+            return cells.get_allocator().resource();
+        }
+    };
+
+    /** \class CellGrid
+     *  \brief 2D grid with the layout chosen at construction, a DenseGrid or a ChunkedGrid.
+     *
+     *  Every access tests the layout first: the branch always goes the same way for a grid,
+     *  so it is predicted and costs far less than the cache misses a wrong layout would.
+     *
+     *  A tiled grid also counts the non-empty cells of each tile of TILE x TILE cells in a
+     *  FlatMap holding only the tiles with any, updated when a cell becomes empty or non-empty:
+     *  forEachOccupied skips the empty tiles, so a query costs about the occupied area it covers.
+     *
+     *  \tparam T The type of the cells, default constructible and comparable with `==`.
+     *  \see Storage
+    */
+    template <typename T>
+    class CellGrid {
+    public:
+        /** \brief Largest number of cells of a grid that Storage::AUTOMATIC stores densely. */
+        static constexpr unsigned long DENSE_CELLS = 1UL << 16;
+        static constexpr unsigned int TILE_SHIFT = 6; /** Log2 of the side of a tile. */
+        static constexpr unsigned int TILE = 1U << TILE_SHIFT; /** Side of a tile, in cells. */
+
+    private:
+        Storage storage; /** DENSE or CHUNKED, never AUTOMATIC. */
+        DenseGrid<T> dense; /** The cells if `storage` is DENSE, empty otherwise. */
+        ChunkedGrid<T> chunked; /** The cells if `storage` is CHUNKED, empty otherwise. */
+        bool tiled; /** Whether `tiles` is kept. */
+        FlatMap<std::uint32_t> tiles; /** Non-empty cells of each tile with any, by `tileY << 16 | tileX`. */
+
+        /** \brief Counts a cell that became non-empty, or empty, in its tile. */
+        void retile(unsigned int y, unsigned int x, bool occupied_) {
+            std::uint32_t key = (y >> TILE_SHIFT) << 16 | (x >> TILE_SHIFT);
+            std::uint32_t* count = tiles.find(key);
+            if (occupied_) {
+                if (count != nullptr)
+                    ++*count;
+                else
+                    tiles.insert(key, 1);
+            } else if (--*count == 0) {
+                tiles.erase(key);
+            }
+        }
+        /** \brief Visits the non-empty cells of a tile inside the rectangle [top, bottom) x [left, right). */
+        template <typename Function>
+        void scanTile(unsigned int tileY, unsigned int tileX, unsigned int top, unsigned int left,
+                      unsigned int bottom, unsigned int right, Function& visit) const {
+            unsigned int fromY = std::max(top, tileY << TILE_SHIFT), toY = std::min(bottom, (tileY + 1) << TILE_SHIFT);
+            unsigned int fromX = std::max(left, tileX << TILE_SHIFT), toX = std::min(right, (tileX + 1) << TILE_SHIFT);
+            for (unsigned int y = fromY; y < toY; y++) {
+                for (unsigned int x = fromX; x < toX;) { // A word of occupancy at a time
+                    unsigned int length;
+                    std::uint64_t bits = occupancy(y, x, length);
+                    length = std::min(length, toX - x);
+                    for (bits &= lowBits(length); bits != 0; bits &= bits - 1)
+                        visit(y, x + countTrailingZeros(bits));
+                    x += length;
+                }
+            }
+        }
+
+        static Storage resolve(Storage storage_, unsigned int width, unsigned int height) {
+            if (storage_ != Storage::AUTOMATIC)
+                return storage_;
+            return static_cast<unsigned long>(width) * height <= DENSE_CELLS ? Storage::DENSE : Storage::CHUNKED;
+        }
+
+    public:
+        /** \brief Constructor of an empty grid.
+         *  \param width The number of columns.
+         *  \param height The number of rows.
+         *  \param storage The layout of the cells.
+         *  \param resource The memory resource of the cells.
+         *  \param tiled Whether to count the non-empty cells of each tile, for forEachOccupied.
+        */
+        CellGrid(unsigned int width, unsigned int height, Storage storage_, std::pmr::memory_resource* resource=std::pmr::get_default_resource(), bool tiled_=false):
+            storage(resolve(storage_, width, height)),
+            dense(storage == Storage::DENSE ? width : 0, storage == Storage::DENSE ? height : 0, resource),
+            chunked(resource), tiled(tiled_), tiles(resource) {}
+
+        /** \brief Returns a cell. */
+        const T& get(unsigned int y, unsigned int x) const {
+            return storage == Storage::DENSE ? dense.get(y, x) : chunked.get(y, x);
+        }
+        /** \brief Returns contiguous cells of a row, see DenseGrid::span and ChunkedGrid::span. */
+        const T* span(unsigned int y, unsigned int x, unsigned int& length) const {
+            return storage == Storage::DENSE ? dense.span(y, x, length) : chunked.span(y, x, length);
+        }
+        /** \brief Sets a cell. */
+        void set(unsigned int y, unsigned int x, T value) {
+            bool before = tiled && occupied(y, x);
+            if (storage == Storage::DENSE)
+                dense.set(y, x, std::move(value));
+            else
+                chunked.set(y, x, std::move(value));
+            if (tiled && before != occupied(y, x))
+                retile(y, x, !before);
+        }
+        /** \brief Empties a cell and returns its previous value. */
+        T take(unsigned int y, unsigned int x) {
+            if (tiled && occupied(y, x))
+                retile(y, x, false);
+            return storage == Storage::DENSE ? dense.take(y, x) : chunked.take(y, x);
+        }
+        /** \brief Exchanges the values of two cells. */
+        void swap(unsigned int y1, unsigned int x1, unsigned int y2, unsigned int x2) {
+            if (tiled && occupied(y1, x1) != occupied(y2, x2)) { // The non-empty cell changes tile, or stays
+                bool first = occupied(y1, x1);
+                retile(y1, x1, !first);
+                retile(y2, x2, first);
+            }
+            if (storage == Storage::DENSE)
+                dense.swap(y1, x1, y2, x2);
+            else
+                chunked.swap(y1, x1, y2, x2);
+        }
+        /** \brief Empties every cell, keeping the chunks of a chunked grid for reuse. */
+        void clear() {
+            dense.clear();
+            chunked.clear();
+            tiles.clear();
+        }
+        /** \brief Frees the empty chunks kept for reuse by a chunked grid. */
+        void shrink() {
+            chunked.shrink();
+        }
+
+        /** \brief Checks whether a cell is non-empty, from its occupancy bit. */
+        bool occupied(unsigned int y, unsigned int x) const {
+            return storage == Storage::DENSE ? dense.occupied(y, x) : chunked.occupied(y, x);
+        }
+        /** \brief Returns occupancy bits of a row, see DenseGrid::occupancy and ChunkedGrid::occupancy. */
+        std::uint64_t occupancy(unsigned int y, unsigned int x, unsigned int& length) const {
+            return storage == Storage::DENSE ? dense.occupancy(y, x, length) : chunked.occupancy(y, x, length);
+        }
+        /** \brief Counts the non-empty cells of the rectangle [top, bottom) x [left, right). */
+        std::size_t countOccupied(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const {
+            return storage == Storage::DENSE ? dense.countOccupied(top, left, bottom, right) : chunked.countOccupied(top, left, bottom, right);
+        }
+
+        /** \brief Calls a function with the row and the column of each non-empty cell of the rectangle [top, bottom) x [left, right).
+         *
+         *  The cells are visited tile by tile, skipping the empty tiles; if the rectangle covers more
+         *  tiles than are non-empty, the non-empty tiles are visited instead of the rectangle.
+         *  Only for tiled grids.
+        */
+        template <typename Function>
+        void forEachOccupied(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right, Function visit) const {
+            if (top >= bottom || left >= right)
+                return;
+            unsigned int fromY = top >> TILE_SHIFT, toY = (bottom - 1) >> TILE_SHIFT;
+            unsigned int fromX = left >> TILE_SHIFT, toX = (right - 1) >> TILE_SHIFT;
+            if (static_cast<std::size_t>(toY - fromY + 1) * (toX - fromX + 1) > tiles.size()) {
+                tiles.forEach([&](std::uint32_t key, const std::uint32_t&) {
+                    unsigned int tileY = key >> 16, tileX = key & 0xffff;
+                    if (tileY >= fromY && tileY <= toY && tileX >= fromX && tileX <= toX)
+                        scanTile(tileY, tileX, top, left, bottom, right, visit);
+                });
+                return;
+            }
+            for (unsigned int tileY = fromY; tileY <= toY; tileY++)
+                for (unsigned int tileX = fromX; tileX <= toX; tileX++)
+                    if (tiles.find(tileY << 16 | tileX) != nullptr)
+                        scanTile(tileY, tileX, top, left, bottom, right, visit);
+        }
+        /** \brief Calls a function with the row, the column and the count of each tile with non-empty cells, in no particular order. */
+        template <typename Function>
+        void forEachTile(Function visit) const {
+            tiles.forEach([&](std::uint32_t key, const std::uint32_t& count) {
+                visit(key >> 16, key & 0xffff, count);
+            });
+        }
+        /** \brief Returns the number of non-empty cells of a tile, of a tiled grid. */
+        std::uint32_t tileCount(unsigned int tileY, unsigned int tileX) const {
+            const std::uint32_t* count = tiles.find(tileY << 16 | tileX);
+            return count != nullptr ? *count : 0;
+        }
+        /** \brief Returns the number of tiles with non-empty cells, of a tiled grid. */
+        std::size_t occupiedTiles() const {
+            return tiles.size();
+        }
+
+        /** \brief Returns the layout of the cells, DENSE or CHUNKED. */
+        Storage getStorage() const {
+            return storage;
+        }
+        /** \brief Returns the memory resource of the cells. */
+        std::pmr::memory_resource* getMemoryResource() const {
+            return chunked.getMemoryResource();
+        }
+    };
+};
@@ -0,0 +1,566 @@
+/** \file output.cpp
+ *  \brief Implementation of the output streams and output sinks of the Sista library.
+ *
+ *  This file contains the per-thread output stream selection and the implementation of
+ *  the OutputSink family: the portable `writev` sink and, on Linux, the io_uring sink
+ *  with its shared submission context. The io_uring backend talks to the kernel through
+ *  the raw system calls, so it does not depend on liburing.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see OutputSink
+ *  \see UringContext
+ *  \copyright GNU General Public License v3.0
+ */
+#include "output.hpp"
+#include "broadcast.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include <iostream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef SISTA_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace sista {
+    static thread_local std::ostream* currentOutputStream = nullptr; // nullptr stands for std::cout
+
+    std::ostream& getOutputStream() {
+        return (currentOutputStream != nullptr) ? *currentOutputStream : std::cout;
+    }
+    void setOutputStream(std::ostream& stream) {
+        currentOutputStream = &stream;
+    }
+    void resetOutputStream() {
+        currentOutputStream = nullptr;
+    }
+
+    OutputRedirect::OutputRedirect(std::ostream& stream): previous(currentOutputStream) {
+        currentOutputStream = &stream;
+    }
+    OutputRedirect::~OutputRedirect() {
+        currentOutputStream = previous;
+    }
+
+    OutputSink::OutputSink(): outputStream(this), bytesDelivered(0), failed(false) {}
+    OutputSink::~OutputSink() {
+        while (!channels.empty()) // A spectator leaving, e.g. a closed Session, must not leave a dangling subscriber
+            channels.back()->unsubscribe(*this);
+    }
+
+    std::ostream& OutputSink::stream() {
+        return outputStream;
+    }
+    bool OutputSink::present() {
+        addStat(Stat::FRAMES_PRESENTED);
+        outputStream.flush(); // Calls sync() through pubsync()
+        return !failed;
+    }
+    bool OutputSink::enqueue(const SharedFrame& shared) {
+        if (shared != nullptr)
+            outputStream.write(shared->data(), shared->size());
+        return present(); // Counts the frame
+    }
+    std::size_t OutputSink::delivered() const {
+        return bytesDelivered;
+    }
+    bool OutputSink::hasFailed() const {
+        return failed;
+    }
+
+#if !defined(_WIN32)
+    FileDescriptorSink::FileDescriptorSink(int fd, std::size_t capacity): descriptor(fd), backlogOffset(0) {
+        frame.resize(capacity > 0 ? capacity : 1);
+        setp(frame.data(), frame.data() + frame.size());
+    }
+    FileDescriptorSink::~FileDescriptorSink() {
+        deliver(); // Best effort, errors can't be reported from here
+    }
+
+    FileDescriptorSink::int_type FileDescriptorSink::overflow(int_type c) {
+        std::size_t used = pptr() - pbase();
+        frame.resize(frame.size() * 2); // The put area is full, double it
+        setp(frame.data(), frame.data() + frame.size());
+        pbump(static_cast<int>(used));
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+    std::streamsize FileDescriptorSink::xsputn(const char* s, std::streamsize n) {
+        std::size_t used = pptr() - pbase();
+        if (static_cast<std::size_t>(n) > frame.size() - used) { // Grow once for the whole write
+            std::size_t capacity = frame.size();
+            while (capacity - used < static_cast<std::size_t>(n))
+                capacity *= 2;
+            frame.resize(capacity);
+            setp(frame.data(), frame.data() + frame.size());
+            pbump(static_cast<int>(used));
+        }
+        std::memcpy(pptr(), s, n);
+        pbump(static_cast<int>(n));
+        return n;
+    }
+    int FileDescriptorSink::sync() {
+        deliver();
+        return failed ? -1 : 0;
+    }
+
+    void FileDescriptorSink::deliver() {
+        std::size_t used = pptr() - pbase();
+        std::size_t frameOffset = 0;
+        if (backlog.empty() && used == 0)
+            return;
+        SISTA_TRACE_SCOPE("FileDescriptorSink::flush");
+        StatTimer timer(Stat::WRITE_NANOSECONDS);
+        while (!failed && (!backlog.empty() || frameOffset < used)) {
+            struct iovec iov[16];
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < backlog.size() && count < 15; i++, count++) {
+                std::size_t skip = (i == 0) ? backlogOffset : 0;
+                iov[count].iov_base = const_cast<char*>(backlog[i]->data()) + skip;
+                iov[count].iov_len = backlog[i]->size() - skip;
+            }
+            if (count == backlog.size() && frameOffset < used) {
+                iov[count].iov_base = frame.data() + frameOffset;
+                iov[count].iov_len = used - frameOffset;
+                count++;
+            }
+            ssize_t written = ::writev(descriptor, iov, static_cast<int>(count));
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue; // Interrupted before writing anything, retry
+                if (errno != EAGAIN && errno != EWOULDBLOCK) { // The descriptor is unusable
+                    failed = true;
+                    backlog.clear();
+                    backlogOffset = 0;
+                    frameOffset = used;
+                }
+                break; // Non-blocking descriptor is full, keep the bytes for later
+            }
+            if (written == 0)
+                break;
+            bytesDelivered += written;
+            addStat(Stat::BYTES_EMITTED, static_cast<std::uint64_t>(written));
+            std::size_t remaining = written;
+            std::size_t released = 0;
+            while (remaining > 0 && released < backlog.size()) { // Release the frames written completely
+                std::size_t left = backlog[released]->size() - backlogOffset;
+                if (remaining < left) {
+                    backlogOffset += remaining;
+                    remaining = 0;
+                } else {
+                    remaining -= left;
+                    released++;
+                    backlogOffset = 0;
+                }
+            }
+            backlog.erase(backlog.begin(), backlog.begin() + released); // Keeps the capacity
+            frameOffset += remaining;
+        }
+        if (frameOffset < used) // Whatever is left waits behind the backlog
+            backlog.push_back(std::make_shared<const std::string>(frame.data() + frameOffset, used - frameOffset));
+        setp(frame.data(), frame.data() + frame.size());
+    }
+
+    bool FileDescriptorSink::flush() {
+        deliver();
+        return !pending();
+    }
+    bool FileDescriptorSink::enqueue(const SharedFrame& shared) {
+        addStat(Stat::FRAMES_PRESENTED);
+        if (pptr() > pbase())
+            deliver(); // The collected bytes go first
+        if (!failed && shared != nullptr && !shared->empty())
+            backlog.push_back(shared); // Referenced, not copied
+        deliver();
+        return !failed;
+    }
+    bool FileDescriptorSink::pending() const {
+        return !backlog.empty() || pptr() > pbase();
+    }
+    int FileDescriptorSink::fileDescriptor() const {
+        return descriptor;
+    }
+#endif
+
+#ifdef SISTA_HAS_IO_URING
+    UringContext::UringContext(unsigned bufferCount, std::size_t bufferSize_) :
+        ringDescriptor(-1), registeredBuffers(false),
+        submissionRing(MAP_FAILED), completionRing(MAP_FAILED), submissionEntries(MAP_FAILED),
+        submissionRingSize(0), completionRingSize(0), submissionEntriesSize(0),
+        sqHead(nullptr), sqTail(nullptr), sqMask(nullptr), sqArray(nullptr), sqEntries(0),
+        cqHead(nullptr), cqTail(nullptr), cqMask(nullptr), cqes(nullptr),
+        unsubmitted(0), inFlight(0), bufferSize(bufferSize_), bufferPool(nullptr) {
+        if (bufferCount == 0 || bufferSize == 0)
+            return;
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        // Every buffer may be in flight at once, so the submission ring must hold all of them
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, bufferCount, &params));
+        if (fd < 0)
+            return; // io_uring is not supported or not allowed, available() stays false
+
+        submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMapping)
+            submissionRingSize = completionRingSize = std::max(submissionRingSize, completionRingSize);
+        submissionRing = mmap(nullptr, submissionRingSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (submissionRing == MAP_FAILED) {
+            close(fd);
+            return;
+        }
+        if (singleMapping) {
+            completionRing = submissionRing;
+        } else {
+            completionRing = mmap(nullptr, completionRingSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        }
+        submissionEntriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        submissionEntries = mmap(nullptr, submissionEntriesSize, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (completionRing == MAP_FAILED || submissionEntries == MAP_FAILED) {
+            if (submissionEntries != MAP_FAILED)
+                munmap(submissionEntries, submissionEntriesSize);
+            if (completionRing != MAP_FAILED && !singleMapping)
+                munmap(completionRing, completionRingSize);
+            munmap(submissionRing, submissionRingSize);
+            submissionRing = completionRing = submissionEntries = MAP_FAILED;
+            close(fd);
+            return;
+        }
+
+        char* sq = static_cast<char*>(submissionRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqEntries = params.sq_entries;
+        char* cq = static_cast<char*>(completionRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = cq + params.cq_off.cqes;
+
+        bufferPool = new char[bufferCount * bufferSize];
+        std::vector<struct iovec> iovecs(bufferCount);
+        freeBuffers.reserve(bufferCount);
+        for (unsigned i = 0; i < bufferCount; i++) {
+            iovecs[i].iov_base = bufferAddress(i);
+            iovecs[i].iov_len = bufferSize;
+            freeBuffers.push_back(bufferCount - 1 - i); // Lower indices are acquired first
+        }
+        // Registration may fail (e.g. RLIMIT_MEMLOCK), plain writes are used in that case
+        registeredBuffers = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS,
+                                    iovecs.data(), bufferCount) == 0;
+        ringDescriptor = fd;
+    }
+    UringContext::~UringContext() {
+        if (ringDescriptor < 0)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (unsubmitted > 0 || inFlight > 0) { // Let the kernel finish with our buffers
+                unsigned before = unsubmitted + inFlight;
+                enter(unsubmitted, inFlight > 0 ? 1 : 0);
+                drainCompletions();
+                if (unsubmitted + inFlight >= before && inFlight == 0)
+                    break; // The kernel refuses the submissions, nothing will complete
+            }
+        }
+        munmap(submissionEntries, submissionEntriesSize);
+        if (completionRing != submissionRing)
+            munmap(completionRing, completionRingSize);
+        munmap(submissionRing, submissionRingSize);
+        close(ringDescriptor);
+        delete[] bufferPool;
+    }
+
+    bool UringContext::available() const {
+        return ringDescriptor >= 0;
+    }
+    int UringContext::fileDescriptor() const {
+        return ringDescriptor;
+    }
+    unsigned UringContext::writesInFlight() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return inFlight;
+    }
+
+    char* UringContext::bufferAddress(int buffer) const {
+        return bufferPool + static_cast<std::size_t>(buffer) * bufferSize;
+    }
+    int UringContext::acquire() {
+        if (freeBuffers.empty())
+            return -1; // Would block: the caller keeps its bytes until reap() recycles a buffer
+        int buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        return buffer;
+    }
+    void UringContext::release(int buffer) {
+        freeBuffers.push_back(buffer);
+    }
+
+    int UringContext::attach(UringSink* sink) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeSlots.empty()) {
+            int slot = freeSlots.back();
+            freeSlots.pop_back();
+            sinks[slot] = sink;
+            return slot;
+        }
+        sinks.push_back(sink);
+        return static_cast<int>(sinks.size()) - 1;
+    }
+    void UringContext::detach(UringSink* sink) {
+        if (sink->waiting)
+            blocked.erase(std::find(blocked.begin(), blocked.end(), sink));
+        sinks[sink->slot] = nullptr;
+        freeSlots.push_back(sink->slot);
+    }
+
+    void UringContext::block(UringSink* sink) {
+        if (sink->waiting)
+            return;
+        sink->waiting = true;
+        blocked.push_back(sink);
+    }
+    void UringContext::resume() {
+        std::size_t resumed = 0; // The sinks blocked again go back to the end of the list
+        for (std::size_t count = blocked.size(); resumed < count && !freeBuffers.empty(); resumed++) {
+            UringSink* sink = blocked[resumed];
+            sink->waiting = false;
+            sink->drainBacklog();
+            schedule(sink);
+        }
+        blocked.erase(blocked.begin(), blocked.begin() + resumed); // Keeps the capacity
+    }
+
+    void UringContext::schedule(UringSink* sink) {
+        if (sink->writing || sink->queueHead >= sink->queue.size())
+            return;
+        if (pushWrite(sink->slot, static_cast<unsigned>(sink->descriptor), sink->queue[sink->queueHead]))
+            sink->writing = true;
+    }
+    bool UringContext::pushWrite(int slot, unsigned fd, const Segment& segment) {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            enter(unsubmitted, 0); // The ring is full, hand the queued entries to the kernel
+            if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+                return false; // Still full, the sink will be scheduled again by the next completion
+        }
+        unsigned index = tail & *sqMask;
+        struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(submissionEntries) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = registeredBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd = static_cast<int>(fd);
+        sqe->addr = reinterpret_cast<unsigned long long>(bufferAddress(segment.buffer) + segment.offset);
+        sqe->len = segment.length - segment.offset;
+        sqe->off = static_cast<unsigned long long>(-1); // Current position, ignored by pipes and sockets
+        if (registeredBuffers)
+            sqe->buf_index = static_cast<unsigned short>(segment.buffer);
+        sqe->user_data = (static_cast<unsigned long long>(slot) << 32) | static_cast<unsigned>(segment.buffer);
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        unsubmitted++;
+        return true;
+    }
+    unsigned UringContext::enter(unsigned toSubmit, unsigned minComplete) {
+        unsigned flags = (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+        SISTA_TRACE_SCOPE("io_uring_enter");
+        StatTimer timer(Stat::WRITE_NANOSECONDS);
+        long submitted = syscall(__NR_io_uring_enter, ringDescriptor, toSubmit, minComplete, flags, nullptr, 0);
+        if (submitted < 0)
+            return 0; // EINTR, EAGAIN or EBUSY: the entries stay queued for the next call
+        unsubmitted -= static_cast<unsigned>(submitted);
+        inFlight += static_cast<unsigned>(submitted);
+        return static_cast<unsigned>(submitted);
+    }
+    unsigned UringContext::drainCompletions() {
+        unsigned head = *cqHead;
+        unsigned count = 0;
+        while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            const struct io_uring_cqe* cqe = static_cast<const struct io_uring_cqe*>(cqes) + (head & *cqMask);
+            unsigned long long userData = cqe->user_data;
+            int result = cqe->res;
+            head++;
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE); // Free the slot before scheduling more writes
+            inFlight--;
+            count++;
+            std::size_t slot = static_cast<std::size_t>(userData >> 32);
+            UringSink* sink = (slot < sinks.size()) ? sinks[slot] : nullptr;
+            if (sink != nullptr)
+                sink->complete(result);
+            else
+                release(static_cast<int>(userData & 0xffffffffu));
+        }
+        if (!blocked.empty())
+            resume(); // Hand the recycled buffers to the sinks waiting for them
+        return count;
+    }
+
+    unsigned UringContext::submit() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ringDescriptor < 0 || unsubmitted == 0)
+            return 0;
+        return enter(unsubmitted, 0);
+    }
+    unsigned UringContext::reap(bool wait) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ringDescriptor < 0)
+            return 0;
+        if (wait && inFlight > 0 && __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) == *cqHead)
+            enter(0, 1);
+        return drainCompletions();
+    }
+
+    UringSink::UringSink(UringContext& context_, int fd) :
+        context(context_), descriptor(fd), slot(-1), current(-1), queueHead(0), writing(false),
+        backlogHead(0), backlogUsed(0), spilling(false), waiting(false) {
+        if (!context.available())
+            throw std::invalid_argument("UringSink: the io_uring context is not available");
+        queue.reserve(8);
+        slot = context.attach(this);
+        setp(nullptr, nullptr); // A registered buffer is acquired upon the first write
+    }
+    UringSink::~UringSink() {
+        std::unique_lock<std::mutex> lock(context.mutex);
+        enqueueCurrent();
+        if (current >= 0)
+            context.release(current);
+        while (queueHead < queue.size() || backlogHead < backlogUsed) { // Wait for the queued frames, or for an error
+            drainBacklog();
+            context.schedule(this);
+            if (queueHead == queue.size() && context.unsubmitted + context.inFlight == 0)
+                break; // Every buffer is held by sinks that are not writing, the backlog can't be delivered
+            context.enter(context.unsubmitted, (context.unsubmitted + context.inFlight > 0) ? 1 : 0);
+            context.drainCompletions();
+        }
+        context.detach(this);
+    }
+
+    void UringSink::enqueueCurrent() {
+        if (spilling) { // The bytes written to the backlog follow the ones already there
+            backlogUsed = static_cast<std::size_t>(pptr() - backlog.data());
+            spilling = false;
+            setp(nullptr, nullptr);
+            drainBacklog();
+            return;
+        }
+        if (current < 0 || pptr() == pbase())
+            return; // Nothing to write, an empty buffer is kept for the next frame
+        unsigned length = static_cast<unsigned>(pptr() - pbase());
+        if (failed) {
+            context.release(current); // Nobody will ever read these bytes
+        } else {
+            queue.push_back(UringContext::Segment{current, 0, length});
+        }
+        current = -1;
+        setp(nullptr, nullptr);
+    }
+    void UringSink::drainBacklog() {
+        if (failed) { // Nobody will ever read these bytes
+            backlogHead = backlogUsed = 0;
+            return;
+        }
+        while (backlogHead < backlogUsed) {
+            int buffer = context.acquire();
+            if (buffer < 0) {
+                context.block(this);
+                return;
+            }
+            unsigned length = static_cast<unsigned>(std::min(context.bufferSize, backlogUsed - backlogHead));
+            std::memcpy(context.bufferAddress(buffer), backlog.data() + backlogHead, length);
+            queue.push_back(UringContext::Segment{buffer, 0, length});
+            backlogHead += length;
+        }
+        if (!spilling) // The put area may follow the copied bytes, which can only be dropped once it is gone
+            backlogHead = backlogUsed = 0;
+    }
+    void UringSink::complete(int result) {
+        writing = false;
+        UringContext::Segment& segment = queue[queueHead];
+        if (result == -EINTR || result == -EAGAIN) {
+            // Nothing was written, the segment is submitted again below
+        } else if (result < 0) { // The descriptor is unusable, drop every queued frame
+            failed = true;
+            for (std::size_t i = queueHead; i < queue.size(); i++)
+                context.release(queue[i].buffer);
+            queue.clear();
+            queueHead = 0;
+            drainBacklog(); // Drops it
+            return;
+        } else {
+            bytesDelivered += result;
+            addStat(Stat::BYTES_EMITTED, static_cast<std::uint64_t>(result));
+            segment.offset += static_cast<unsigned>(result);
+            if (segment.offset >= segment.length) { // Short writes keep the segment at the front
+                context.release(segment.buffer);
+                if (++queueHead == queue.size()) {
+                    queue.clear(); // Keeps the capacity, no allocation in steady state
+                    queueHead = 0;
+                }
+            }
+        }
+        context.schedule(this);
+    }
+
+    UringSink::int_type UringSink::overflow(int_type c) {
+        std::unique_lock<std::mutex> lock(context.mutex);
+        enqueueCurrent(); // The current buffer is full, it becomes part of the queue
+        context.schedule(this);
+        if (current < 0 && backlogHead == backlogUsed) // A new buffer only after the backlog, to keep the bytes in order
+            current = context.acquire();
+        if (current >= 0) {
+            char* buffer = context.bufferAddress(current);
+            setp(buffer, buffer + context.bufferSize);
+        } else { // Would block: the frame goes on in the backlog
+            if (backlog.size() - backlogUsed < context.bufferSize)
+                backlog.resize(std::max(backlog.size() * 2, backlogUsed + context.bufferSize));
+            setp(backlog.data() + backlogUsed, backlog.data() + backlog.size());
+            spilling = true;
+            context.block(this);
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+    int UringSink::sync() {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        enqueueCurrent();
+        context.schedule(this);
+        return failed ? -1 : 0;
+    }
+
+    bool UringSink::pending() const {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        return queueHead < queue.size() || backlogHead < backlogUsed || pptr() > pbase();
+    }
+    int UringSink::fileDescriptor() const {
+        return descriptor;
+    }
+
+    std::unique_ptr<OutputSink> makeAsyncSink(UringContext& context, int fd) {
+        if (context.available())
+            return std::unique_ptr<OutputSink>(new UringSink(context, fd));
+        return std::unique_ptr<OutputSink>(new FileDescriptorSink(fd)); // writev fallback
+    }
+#endif
+};
@@ -0,0 +1,397 @@
+/** \file output.hpp
+ *  \brief Output streams and output sinks of the Sista library.
+ *
+ *  Every escape sequence and symbol printed by Sista goes through the output stream
+ *  of the calling thread, which is `std::cout` unless redirected with setOutputStream
+ *  or OutputRedirect. Redirecting the stream per thread allows many fields to render
+ *  concurrently towards different terminals, ptys or sockets.
+ *
+ *  This header also declares the output sinks, `std::streambuf` implementations that
+ *  collect the bytes of a frame and hand them to the operating system:
+ *  - FileDescriptorSink writes frames to a file descriptor with `writev`;
+ *  - UringSink (Linux only) submits frames asynchronously through an UringContext,
+ *    which batches the submissions of many sinks and recycles registered buffers.
+ *
+ *  \see OutputSink
+ *  \see FileDescriptorSink
+ *  \see UringContext
+ *  \see UringSink
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <ostream> // std::ostream
+#include <streambuf> // std::streambuf
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr, std::shared_ptr
+#include <string> // std::string
+#include <mutex> // std::mutex
+#include <cstddef> // std::size_t
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+/** \def SISTA_HAS_IO_URING
+ *  \brief Defined when the io_uring output backend is compiled in.
+ *
+ *  The io_uring backend is only available on Linux and requires the kernel headers.
+ *  Even when it is compiled in, the kernel may refuse to create a ring at runtime,
+ *  in which case UringContext::available returns `false` and makeAsyncSink falls back
+ *  to a FileDescriptorSink.
+*/
+#define SISTA_HAS_IO_URING 1
+#endif
+#endif
+
+namespace sista {
+    /** \brief An encoded frame shared, immutable, between many sinks.
+     *
+     *  Sinks keep a reference to the frame until it has been written, so the same bytes
+     *  can be fanned out to any number of sinks without copying them.
+     *
+     *  \see OutputSink::enqueue
+     *  \see BroadcastChannel
+    */
+    using SharedFrame = std::shared_ptr<const std::string>;
+
+    /** \brief Returns the output stream of the calling thread.
+     *  \return A reference to the stream Sista is writing to on this thread.
+     *
+     *  All the printing functions of the library write to this stream.
+     *  It defaults to `std::cout` on every thread.
+     *
+     *  \see setOutputStream
+     *  \see OutputRedirect
+    */
+    std::ostream& getOutputStream();
+    /** \brief Sets the output stream of the calling thread.
+     *  \param stream The stream Sista should write to on this thread.
+     *
+     *  \warning The stream must outlive its usage as output stream.
+     *  \see getOutputStream
+     *  \see resetOutputStream
+    */
+    void setOutputStream(std::ostream&);
+    /** \brief Restores `std::cout` as the output stream of the calling thread. */
+    void resetOutputStream();
+
+    /** \class OutputRedirect
+     *  \brief Redirects the output stream of the calling thread for its lifetime.
+     *
+     *  The previous output stream is restored upon destruction, so redirections can be nested.
+     *
+     *  \see setOutputStream
+    */
+    class OutputRedirect {
+    private:
+        std::ostream* previous; /** The output stream to restore on destruction. */
+
+    public:
+        /** \brief Redirects the output stream of the calling thread.
+         *  \param stream The stream Sista should write to until destruction.
+        */
+        explicit OutputRedirect(std::ostream&);
+        /** \brief Restores the previous output stream. */
+        ~OutputRedirect();
+
+        OutputRedirect(const OutputRedirect&) = delete;
+        OutputRedirect& operator=(const OutputRedirect&) = delete;
+    };
+
+    class BroadcastChannel; // Declared in broadcast.hpp
+
+    /** \class OutputSink
+     *  \brief Base class of the stream buffers that deliver frames to the operating system.
+     *
+     *  An OutputSink collects the bytes written to its stream() and delivers them when the
+     *  stream is flushed (`std::flush`) or present() is called, so that a frame is handed to
+     *  the operating system as a whole instead of one escape sequence at a time.
+     *
+     *  \see FileDescriptorSink
+     *  \see UringSink
+     *  \see OutputRedirect
+    */
+    class OutputSink : public std::streambuf {
+    private:
+        friend class BroadcastChannel;
+        std::vector<BroadcastChannel*> channels; /** Channels the sink is subscribed to, left when it is destroyed. */
+
+    protected:
+        std::ostream outputStream; /** Stream writing into this sink. */
+        std::size_t bytesDelivered; /** Number of bytes handed to the operating system so far. */
+        bool failed; /** Whether a write error occurred. */
+
+    public:
+        /** \brief Constructor binding stream() to this sink. */
+        OutputSink();
+        /** \brief Destructor, unsubscribing the sink from every BroadcastChannel it joined. */
+        virtual ~OutputSink();
+
+        OutputSink(const OutputSink&) = delete;
+        OutputSink& operator=(const OutputSink&) = delete;
+
+        /** \brief Returns a stream writing into this sink.
+         *  \return A reference to the stream owned by the sink.
+         *
+         *  The stream is meant to be installed with OutputRedirect or setOutputStream.
+        */
+        std::ostream& stream();
+        /** \brief Delivers the frame collected so far.
+         *  \return `true` unless a write error occurred.
+         *
+         *  This is equivalent to flushing stream().
+        */
+        bool present();
+        /** \brief Delivers the frame collected so far, followed by a shared frame.
+         *  \param frame The shared frame to write after the collected bytes.
+         *  \return `true` unless a write error occurred.
+         *
+         *  The default implementation copies the frame into the sink; sinks that can write
+         *  from the shared memory directly (FileDescriptorSink) keep a reference instead.
+        */
+        virtual bool enqueue(const SharedFrame&);
+        /** \brief Checks whether some bytes are still waiting to be written.
+         *  \return `true` if the sink has undelivered bytes.
+        */
+        virtual bool pending() const = 0;
+        /** \brief Returns the number of bytes handed to the operating system so far. */
+        std::size_t delivered() const;
+        /** \brief Checks whether a write error occurred.
+         *  \return `true` if the sink failed, e.g. because the peer closed the connection.
+        */
+        bool hasFailed() const;
+    };
+
+#if !defined(_WIN32)
+    /** \class FileDescriptorSink
+     *  \brief OutputSink writing frames to a file descriptor with `writev`.
+     *
+     *  Frames are accumulated in a reusable buffer and written with a single `writev` call,
+     *  together with any bytes left over by a previous short write. Non-blocking descriptors
+     *  are supported: bytes that could not be written are kept until the next flush() call.
+     *  Shared frames passed to enqueue() are written from their own memory, without copies.
+     *
+     *  \note The sink does not own the file descriptor, which is not closed on destruction.
+    */
+    class FileDescriptorSink final : public OutputSink {
+    private:
+        int descriptor; /** The file descriptor frames are written to. */
+        std::vector<char> frame; /** Bytes of the frame being collected (put area). */
+        std::vector<SharedFrame> backlog; /** Frames that could not be written yet, oldest first. */
+        std::size_t backlogOffset; /** Offset of the first unwritten byte in the oldest frame of backlog. */
+
+        /** \brief Writes the backlog followed by the collected frame, as much as possible. */
+        void deliver();
+
+    protected:
+        int_type overflow(int_type) override;
+        std::streamsize xsputn(const char*, std::streamsize) override;
+        int sync() override;
+
+    public:
+        /** \brief Constructor.
+         *  \param fd The file descriptor to write to.
+         *  \param capacity The initial capacity of the frame buffer in bytes.
+        */
+        explicit FileDescriptorSink(int, std::size_t=65536);
+        /** \brief Destructor, writes the remaining bytes if possible. */
+        ~FileDescriptorSink();
+
+        /** \brief Retries writing the bytes left over by previous short writes.
+         *  \return `true` if every byte has been written.
+        */
+        bool flush();
+        bool enqueue(const SharedFrame&) override;
+        bool pending() const override;
+        /** \brief Returns the file descriptor of the sink. */
+        int fileDescriptor() const;
+    };
+#endif
+
+#ifdef SISTA_HAS_IO_URING
+    class UringSink;
+
+    /** \class UringContext
+     *  \brief An io_uring instance shared by many UringSink objects.
+     *
+     *  The context owns a pool of buffers registered with the kernel once: sinks write their
+     *  frames directly into those buffers, which are written with `IORING_OP_WRITE_FIXED` and
+     *  recycled as soon as their completion is reaped. Writes queued by every sink are handed
+     *  to the kernel with a single `io_uring_enter` call by submit(), so a server serving many
+     *  sessions pays one system call per tick instead of one per session.
+     *
+     *  A typical tick renders every session, calls present() on each sink, then submit()
+     *  and reap() once.
+     *
+     *  When every buffer is in use, a sink doesn't wait for a write to complete: it keeps
+     *  encoding into a backlog of its own, which is copied into buffers as reap() recycles
+     *  them. A slow client thus delays only its own frames, never the other sessions.
+     *
+     *  \note The context is thread-safe: sinks owned by different threads may share it.
+     *  \see UringSink
+     *  \see makeAsyncSink
+    */
+    class UringContext {
+    private:
+        /** \brief A write queued by a sink: a slice of a registered buffer. */
+        struct Segment {
+            int buffer; /** Index of the registered buffer. */
+            unsigned offset; /** Offset of the first byte still to write. */
+            unsigned length; /** Offset past the last byte to write. */
+        };
+
+        mutable std::mutex mutex; /** Guards the rings, the free list and the sinks' queues. */
+        int ringDescriptor; /** File descriptor of the ring, -1 if unavailable. */
+        bool registeredBuffers; /** Whether the buffers are registered (WRITE_FIXED) or not (WRITE). */
+        void* submissionRing; /** Mapping of the submission ring. */
+        void* completionRing; /** Mapping of the completion ring. */
+        void* submissionEntries; /** Mapping of the submission queue entries. */
+        std::size_t submissionRingSize; /** Size of the submission ring mapping. */
+        std::size_t completionRingSize; /** Size of the completion ring mapping. */
+        std::size_t submissionEntriesSize; /** Size of the submission queue entries mapping. */
+        unsigned* sqHead; /** Submission ring head (written by the kernel). */
+        unsigned* sqTail; /** Submission ring tail (written by the context). */
+        unsigned* sqMask; /** Submission ring mask. */
+        unsigned* sqArray; /** Submission ring indirection array. */
+        unsigned sqEntries; /** Number of submission queue entries. */
+        unsigned* cqHead; /** Completion ring head (written by the context). */
+        unsigned* cqTail; /** Completion ring tail (written by the kernel). */
+        unsigned* cqMask; /** Completion ring mask. */
+        void* cqes; /** Completion queue entries. */
+        unsigned unsubmitted; /** Entries queued since the last io_uring_enter. */
+        unsigned inFlight; /** Entries submitted and not yet completed. */
+
+        std::size_t bufferSize; /** Size of each registered buffer. */
+        char* bufferPool; /** Memory of all the registered buffers. */
+        std::vector<int> freeBuffers; /** Indices of the buffers that can be acquired. */
+        std::vector<UringSink*> sinks; /** Sinks attached to the context, indexed by slot. */
+        std::vector<int> freeSlots; /** Slots of sinks that were detached. */
+        std::vector<UringSink*> blocked; /** Sinks with a backlog waiting for free buffers, oldest first. */
+
+        int acquire();
+        void release(int);
+        char* bufferAddress(int) const;
+        void schedule(UringSink*);
+        void block(UringSink*);
+        void resume();
+        bool pushWrite(int, unsigned, const Segment&);
+        unsigned enter(unsigned, unsigned);
+        unsigned drainCompletions();
+        int attach(UringSink*);
+        void detach(UringSink*);
+
+        friend class UringSink;
+
+    public:
+        /** \brief Creates the ring and registers the buffer pool.
+         *  \param bufferCount Number of buffers in the pool, also the maximum number of writes in flight.
+         *         Sinks finding no free buffer keep their bytes in a backlog until some are recycled.
+         *  \param bufferSize Size of each buffer in bytes.
+         *
+         *  If the kernel does not support io_uring (or forbids it, e.g. in a sandbox), the context is
+         *  created anyway but available() returns `false`.
+        */
+        explicit UringContext(unsigned=256, std::size_t=16384);
+        /** \brief Waits for the writes in flight and releases the ring. */
+        ~UringContext();
+
+        UringContext(const UringContext&) = delete;
+        UringContext& operator=(const UringContext&) = delete;
+
+        /** \brief Checks whether the ring was created successfully. */
+        bool available() const;
+        /** \brief Returns the file descriptor of the ring, -1 if it is not available.
+         *
+         *  The descriptor becomes readable when completions can be reaped, so it can be
+         *  watched with `epoll` next to the sockets the sinks write to.
+        */
+        int fileDescriptor() const;
+        /** \brief Hands every queued write to the kernel with a single system call.
+         *  \return The number of writes submitted.
+        */
+        unsigned submit();
+        /** \brief Processes the completed writes, recycling their buffers.
+         *  \param wait If `true`, blocks until at least one write completes (when some are in flight).
+         *  \return The number of completions processed.
+         *
+         *  Short writes are resubmitted and the following frames of the same sink are queued,
+         *  so calling submit() after reap() keeps every session's output flowing.
+        */
+        unsigned reap(bool=false);
+        /** \brief Returns the number of writes submitted and not yet completed. */
+        unsigned writesInFlight() const;
+    };
+
+    /** \class UringSink
+     *  \brief OutputSink submitting frames asynchronously through an UringContext.
+     *
+     *  The put area of the sink is a registered buffer of the context, so frames are encoded
+     *  directly into memory the kernel can write from. Flushing the stream queues the frame,
+     *  which is handed to the kernel by the next UringContext::submit call. Frames of the same
+     *  sink are written in order, one at a time.
+     *
+     *  If the context has no free buffer, the bytes go to a backlog owned by the sink instead
+     *  of waiting for the kernel: the frame is presented without blocking, pending() stays
+     *  `true`, and the backlog is moved to registered buffers as UringContext::reap frees them.
+     *
+     *  \note The sink does not own the file descriptor, which is not closed on destruction.
+     *  \see UringContext
+     *  \see makeAsyncSink
+    */
+    class UringSink final : public OutputSink {
+    private:
+        UringContext& context; /** The context the sink submits through. */
+        int descriptor; /** The file descriptor frames are written to. */
+        int slot; /** Index of the sink in the context. */
+        int current; /** Registered buffer being filled, -1 if none. */
+        std::vector<UringContext::Segment> queue; /** Frames waiting to be written, the first may be in flight. */
+        std::size_t queueHead; /** Index of the first element of queue. */
+        bool writing; /** Whether the first element of queue is in flight. */
+        std::vector<char> backlog; /** Bytes encoded while no buffer was free, the put area may follow them. */
+        std::size_t backlogHead; /** Offset of the first byte of backlog not copied to a buffer yet. */
+        std::size_t backlogUsed; /** Number of bytes of backlog ready to be copied to buffers. */
+        bool spilling; /** Whether the put area is in backlog rather than in a registered buffer. */
+        bool waiting; /** Whether the sink is in the list of sinks waiting for free buffers. */
+
+        void enqueueCurrent();
+        void drainBacklog();
+        void complete(int);
+
+        friend class UringContext;
+
+    protected:
+        int_type overflow(int_type) override;
+        int sync() override;
+
+    public:
+        /** \brief Constructor.
+         *  \param context The context to submit through, which must be available().
+         *  \param fd The file descriptor to write to.
+         *
+         *  \throws `std::invalid_argument` if the context is not available.
+        */
+        UringSink(UringContext&, int);
+        /** \brief Destructor, waits for the queued frames to be written. */
+        ~UringSink();
+
+        bool pending() const override;
+        /** \brief Returns the file descriptor of the sink. */
+        int fileDescriptor() const;
+    };
+#endif
+
+#ifdef SISTA_HAS_IO_URING
+    /** \brief Creates the fastest available sink writing to a file descriptor.
+     *  \param context The UringContext to submit through when io_uring is available.
+     *  \param fd The file descriptor to write to.
+     *  \return An UringSink if the context is available, a FileDescriptorSink otherwise.
+     *
+     *  \see UringSink
+     *  \see FileDescriptorSink
+    */
+    std::unique_ptr<OutputSink> makeAsyncSink(UringContext&, int);
+#endif
+};
@@ -0,0 +1,150 @@
+/** \file overlay.cpp
+ *  \brief Implementation of the PerformanceOverlay class.
+ *
+ *  The overlay keeps the characters it drew and writes only the spans of each line that
+ *  changed since the previous frame, so a steady frame rate costs no output at all.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see PerformanceOverlay
+ *  \copyright GNU General Public License v3.0
+ */
+#include "overlay.hpp"
+#include "output.hpp"
+#include <algorithm> // std::nth_element, std::min
+#include <cstdio> // std::snprintf
+
+namespace sista {
+    // Equal characters between two changed spans are rewritten rather than jumped over
+    // when they are fewer than the bytes of a cursor jump (`ESC [ row ; col H`)
+    static constexpr std::size_t SPAN_GAP = 6;
+
+    PerformanceOverlay::PerformanceOverlay(unsigned short int row_, unsigned short int column_,
+                                           const ANSISettings& settings_, std::size_t samples_):
+        row(row_), column(column_), settings(settings_), enabled(true), samples(std::max<std::size_t>(samples_, 1), 0.0),
+        next(0), count(0), started(false), previous(getStats()), bytes(0), cells(0) {
+        sorted.reserve(samples.size());
+        for (auto& line : drawn)
+            line.fill('\0');
+    }
+
+    void PerformanceOverlay::frame() {
+        auto now = std::chrono::steady_clock::now();
+        RenderStats current = getStats();
+        bytes = current.bytesEmitted - previous.bytesEmitted;
+        cells = current.cellsRedrawn - previous.cellsRedrawn;
+        previous = current;
+        if (started) {
+            samples[next] = std::chrono::duration<double, std::milli>(now - last).count();
+            next = (next + 1) % samples.size();
+            count = std::min(count + 1, samples.size());
+        }
+        last = now;
+        started = true;
+        if (!enabled)
+            return;
+        std::array<std::array<char, WIDTH>, LINES> lines;
+        format(lines);
+        update(lines, true);
+    }
+
+    void PerformanceOverlay::redraw() {
+        for (auto& line : drawn)
+            line.fill('\0');
+        if (!enabled)
+            return;
+        std::array<std::array<char, WIDTH>, LINES> lines;
+        format(lines);
+        update(lines, true);
+    }
+
+    void PerformanceOverlay::setEnabled(bool enabled_) {
+        if (enabled == enabled_)
+            return;
+        enabled = enabled_;
+        if (enabled) {
+            redraw();
+        } else { // Erase what is on screen
+            std::array<std::array<char, WIDTH>, LINES> blank;
+            for (auto& line : blank)
+                line.fill(' ');
+            update(blank, false);
+            for (auto& line : drawn)
+                line.fill('\0');
+        }
+    }
+    void PerformanceOverlay::toggle() {
+        setEnabled(!enabled);
+    }
+    bool PerformanceOverlay::isEnabled() const {
+        return enabled;
+    }
+
+    double PerformanceOverlay::getFramesPerSecond() const {
+        double total = 0;
+        for (std::size_t i = 0; i < count; i++)
+            total += samples[i];
+        return total > 0 ? 1000.0 * count / total : 0;
+    }
+    double PerformanceOverlay::getFrameTime(double percentile) {
+        if (count == 0)
+            return 0;
+        sorted.assign(samples.begin(), samples.begin() + count); // Within the reserved capacity
+        std::size_t rank = static_cast<std::size_t>(std::min(std::max(percentile, 0.0), 100.0) / 100.0 * (count - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        return sorted[rank];
+    }
+    std::uint64_t PerformanceOverlay::getBytesPerFrame() const {
+        return bytes;
+    }
+    std::uint64_t PerformanceOverlay::getDirtyCells() const {
+        return cells;
+    }
+
+    void PerformanceOverlay::format(std::array<std::array<char, WIDTH>, LINES>& lines) {
+        char buffer[LINES][WIDTH + 1];
+        std::snprintf(buffer[0], WIDTH + 1, "FPS   %9.1f", getFramesPerSecond());
+        std::snprintf(buffer[1], WIDTH + 1, "p50   %9.2f ms", getFrameTime(50));
+        std::snprintf(buffer[2], WIDTH + 1, "p99   %9.2f ms", getFrameTime(99));
+        std::snprintf(buffer[3], WIDTH + 1, "bytes %9llu", static_cast<unsigned long long>(bytes));
+        std::snprintf(buffer[4], WIDTH + 1, "dirty %9llu", static_cast<unsigned long long>(cells));
+        for (std::size_t i = 0; i < LINES; i++) {
+            bool ended = false; // Pads with spaces after the terminator
+            for (std::size_t j = 0; j < WIDTH; j++) {
+                ended = ended || buffer[i][j] == '\0';
+                lines[i][j] = ended ? ' ' : buffer[i][j];
+            }
+        }
+    }
+
+    void PerformanceOverlay::update(const std::array<std::array<char, WIDTH>, LINES>& lines, bool apply_settings) {
+        bool styled = false;
+        for (std::size_t i = 0; i < LINES; i++) {
+            std::size_t j = 0;
+            while (j < WIDTH) {
+                if (lines[i][j] == drawn[i][j]) {
+                    j++;
+                    continue;
+                }
+                std::size_t end = j + 1; // One past the last changed character of the span
+                for (std::size_t k = end; k < WIDTH && k < end + SPAN_GAP; k++)
+                    if (lines[i][k] != drawn[i][k])
+                        end = k + 1;
+                if (!styled) {
+                    if (apply_settings)
+                        settings.apply();
+                    else
+                        resetAnsi();
+                    styled = true;
+                }
+                cursor.goTo(row + i, column + j);
+                getOutputStream().write(&lines[i][j], end - j);
+                std::copy(lines[i].begin() + j, lines[i].begin() + end, drawn[i].begin() + j);
+                j = end;
+            }
+        }
+        if (styled) // The style of the overlay mustn't leak into what is printed next, e.g. by Field::rePrintPawn
+            resetAnsi();
+    }
+};
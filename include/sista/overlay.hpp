@@ -0,0 +1,121 @@
+/** \file overlay.hpp
+ *  \brief PerformanceOverlay class header file.
+ *
+ *  This file contains the declaration of the PerformanceOverlay class, a small on-screen
+ *  display showing the frame rate, the frame time percentiles, the bytes emitted per frame
+ *  and the cells redrawn per frame, drawn by the library itself in a corner of the terminal.
+ *
+ *  The overlay is drawn the way Field updates its pawns: it remembers the text it drew and
+ *  only rewrites the characters that changed, jumping there with Cursor::goTo, so a steady
+ *  overlay costs a few bytes per frame.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see PerformanceOverlay
+ *  \see getStats
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include "ansi.hpp"
+#include "cursor.hpp"
+#include "stats.hpp"
+#include <array> // std::array
+#include <vector> // std::vector
+#include <chrono> // std::chrono::steady_clock
+#include <cstddef> // std::size_t
+
+namespace sista {
+    /** \class PerformanceOverlay
+     *  \brief Draws live render statistics over the terminal.
+     *
+     *  Call frame() once per frame, after the frame was presented: it measures the time
+     *  since the previous call, reads the difference of the render statistics and, if the
+     *  overlay is enabled, updates the changed characters of the overlay. The bytes of the
+     *  overlay itself are emitted with the following frame.
+     *
+     *  The bytes per frame are those counted by the output sinks (see Stat::BYTES_EMITTED),
+     *  so they read zero when rendering directly to `std::cout`.
+     *
+     *  \see getStats
+     *  \see Cursor::goTo
+    */
+    class PerformanceOverlay {
+    public:
+        static constexpr std::size_t LINES = 5; /** Number of lines of the overlay. */
+        static constexpr std::size_t WIDTH = 18; /** Number of columns of the overlay. */
+
+    private:
+        unsigned short int row; /** Terminal row of the first line, starting from 1. */
+        unsigned short int column; /** Terminal column of the first character, starting from 1. */
+        ANSISettings settings; /** Style of the overlay. */
+        Cursor cursor; /** Cursor object for terminal operations. */
+        bool enabled; /** Whether the overlay is drawn. */
+
+        std::vector<double> samples; /** Ring buffer of the last frame times, in milliseconds. */
+        std::vector<double> sorted; /** Scratch buffer used to compute the percentiles. */
+        std::size_t next; /** Index of the next sample in the ring buffer. */
+        std::size_t count; /** Number of valid samples in the ring buffer. */
+        std::chrono::steady_clock::time_point last; /** Time of the previous call to frame(). */
+        bool started; /** Whether frame() was already called once. */
+        RenderStats previous; /** Statistics at the previous call to frame(). */
+        std::uint64_t bytes; /** Bytes emitted during the last frame. */
+        std::uint64_t cells; /** Cells redrawn during the last frame. */
+
+        std::array<std::array<char, WIDTH>, LINES> drawn; /** Text currently on screen, '\0' where unknown. */
+
+        /** \brief Formats the current statistics into the overlay lines.
+         *  \param lines The lines to fill, padded with spaces.
+        */
+        void format(std::array<std::array<char, WIDTH>, LINES>&);
+        /** \brief Writes the characters of `lines` that differ from the ones on screen, then resets the style if it wrote any.
+         *  \param lines The text to show.
+         *  \param apply_settings If true, the spans are written with the style of the overlay.
+        */
+        void update(const std::array<std::array<char, WIDTH>, LINES>&, bool);
+
+    public:
+        /** \brief Constructor placing the overlay at a terminal position.
+         *  \param row Terminal row of the first line, starting from 1.
+         *  \param column Terminal column of the first character, starting from 1.
+         *  \param settings Style of the overlay.
+         *  \param samples Number of frames over which the frame rate and percentiles are computed.
+         *
+         *  The overlay starts enabled and allocates its buffers here, so frame() doesn't allocate.
+        */
+        PerformanceOverlay(unsigned short int, unsigned short int, const ANSISettings&, std::size_t=120);
+
+        /** \brief Records a frame and draws the changes of the overlay, if enabled.
+         *
+         *  The first call only starts the clock, since a frame time needs two calls.
+        */
+        void frame();
+        /** \brief Draws the whole overlay again, e.g. after the screen was cleared. */
+        void redraw();
+        /** \brief Enables or disables the overlay.
+         *  \param enabled_ If false, the overlay is erased from the screen.
+         *
+         *  The statistics keep being collected while the overlay is disabled.
+        */
+        void setEnabled(bool);
+        /** \brief Enables the overlay if disabled, disables it otherwise.
+         *  \see setEnabled
+        */
+        void toggle();
+        /** \brief Checks whether the overlay is drawn. */
+        bool isEnabled() const;
+
+        /** \brief Returns the frame rate over the recorded frames, 0 if none. */
+        double getFramesPerSecond() const;
+        /** \brief Returns a percentile of the recorded frame times.
+         *  \param percentile A value between 0 and 100.
+         *  \return The frame time in milliseconds, 0 if no frame was recorded.
+        */
+        double getFrameTime(double);
+        /** \brief Returns the bytes emitted by the output sinks during the last frame. */
+        std::uint64_t getBytesPerFrame() const;
+        /** \brief Returns the Field cells redrawn during the last frame. */
+        std::uint64_t getDirtyCells() const;
+    };
+};
@@ -0,0 +1,256 @@
+/** \file pathfinder.cpp
+ *  \brief Implementation of the PathFinder class.
+ *
+ *  The search is A* over a binary heap with lazy deletion: an improved node is pushed again
+ *  and its stale entries are skipped when popped. Jump Point Search replaces the neighbours
+ *  of a node with the jump points reached walking from it in each direction, with the rules
+ *  of the grids that forbid cutting corners.
+ *
+ *  The nodes live in a thread_local SearchBuffers: indexed by cell for fields up to
+ *  PathFinder::DENSE_NODES cells, hashed by packed Coordinates for larger ones.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see PathFinder
+ *  \copyright GNU General Public License v3.0
+ */
+#include "pathfinder.hpp"
+#include "field.hpp"
+#include "grid.hpp"
+#include <algorithm> // std::push_heap, std::pop_heap, std::reverse, std::min, std::max
+#include <cstdlib> // std::abs
+#include <limits> // std::numeric_limits
+
+namespace sista {
+    /** \brief A cell reached by a search. */
+    struct SearchNode {
+        std::uint32_t generation = 0; /** Query the node belongs to, stale if it is not the current one. */
+        std::uint32_t cost = std::numeric_limits<std::uint32_t>::max(); /** Cost of the best path found from the start. */
+        std::uint32_t parent = 0; /** Packed Coordinates of the previous node of that path. */
+        std::int8_t dy = 0; /** Row direction of the last step into the node. */
+        std::int8_t dx = 0; /** Column direction of the last step into the node. */
+        bool closed = false; /** Whether the node was expanded. */
+    };
+    /** \brief An entry of the open list, ordered by estimated total cost. */
+    struct OpenNode {
+        std::uint32_t priority; /** Cost from the start plus the heuristic. */
+        std::uint32_t cost; /** Cost from the start when pushed, stale if the node improved since. */
+        std::uint32_t cell; /** Packed Coordinates of the node. */
+
+        /** \brief Orders the heap with the lowest priority on top, the deepest node first on ties. */
+        bool operator<(const OpenNode& other) const {
+            return priority != other.priority ? priority > other.priority : cost < other.cost;
+        }
+    };
+
+    /** \brief The nodes and the open list of the searches of a thread, reused by every query. */
+    struct SearchBuffers {
+        std::vector<SearchNode> nodes; /** Nodes indexed by cell, for small fields. */
+        FlatMap<SearchNode> hashed; /** Nodes by packed Coordinates, for large fields. */
+        std::vector<OpenNode> open; /** Binary heap of the open nodes. */
+        std::uint32_t generation = 0; /** Stamp of the current query. */
+        std::size_t width = 0; /** Width of the field of the current query. */
+        bool dense = true; /** Whether the current query indexes `nodes`. */
+
+        /** \brief Starts a query on a field, invalidating the nodes of the previous ones. */
+        void begin(int width_, int height) {
+            width = static_cast<std::size_t>(width_);
+            std::size_t area = width * static_cast<std::size_t>(height);
+            dense = area <= PathFinder::DENSE_NODES;
+            if (dense && nodes.size() < area)
+                nodes.resize(area);
+            if (++generation == 0) { // Wrapped around: the oldest stamps would look current
+                for (SearchNode& node : nodes)
+                    node.generation = 0;
+                generation = 1;
+            }
+            hashed.clear();
+            open.clear();
+        }
+        /** \brief Returns the node of a cell, reset if the current query didn't reach it yet. */
+        SearchNode& node(const Coordinates& cell) {
+            if (!dense) {
+                SearchNode* found = hashed.find(cell.pack());
+                return found != nullptr ? *found : hashed.insert(cell.pack(), SearchNode());
+            }
+            SearchNode& found = nodes[cell.y * width + cell.x];
+            if (found.generation != generation) {
+                found = SearchNode();
+                found.generation = generation;
+            }
+            return found;
+        }
+    };
+    static thread_local SearchBuffers buffers;
+
+    PathFinder::PathFinder(const Field& field_, Connectivity connectivity_, Effect effect):
+        field(&field_), width(field_.getWidth()), height(field_.getHeight()),
+        connectivity(connectivity_), wrap(effect == Effect::PACMAN) {}
+
+    bool PathFinder::step(int& y, int& x, int dy, int dx) const {
+        y += dy;
+        x += dx;
+        if (wrap) { // A single step leaves the field by one cell at most
+            y += y < 0 ? height : (y >= height ? -height : 0);
+            x += x < 0 ? width : (x >= width ? -width : 0);
+            return true;
+        }
+        return static_cast<unsigned int>(y) < static_cast<unsigned int>(height)
+            && static_cast<unsigned int>(x) < static_cast<unsigned int>(width);
+    }
+    bool PathFinder::walkable(int y, int x) const {
+        if ((y == goal.y && x == goal.x) || (y == start.y && x == start.x))
+            return true;
+        return !field->isOccupied(static_cast<unsigned short>(y), static_cast<unsigned short>(x));
+    }
+    bool PathFinder::walkable(int y, int x, int dy, int dx) const {
+        return step(y, x, dy, dx) && walkable(y, x);
+    }
+    std::uint32_t PathFinder::heuristic(int y, int x) const {
+        int dy = std::abs(y - goal.y), dx = std::abs(x - goal.x);
+        if (wrap) { // The shorter way around the torus
+            dy = std::min(dy, height - dy);
+            dx = std::min(dx, width - dx);
+        }
+        if (connectivity == Connectivity::FOUR)
+            return ORTHOGONAL_COST * static_cast<std::uint32_t>(dy + dx);
+        std::uint32_t diagonal = static_cast<std::uint32_t>(std::min(dy, dx)), straight = static_cast<std::uint32_t>(std::max(dy, dx)) - diagonal;
+        return DIAGONAL_COST * diagonal + ORTHOGONAL_COST * straight; // Octile distance
+    }
+
+    std::uint32_t PathFinder::jump(int& y, int& x, int dy, int dx) const {
+        bool diagonal = dy != 0 && dx != 0;
+        for (std::uint32_t steps = 1;; steps++) {
+            if (diagonal && (!walkable(y, x, 0, dx) || !walkable(y, x, dy, 0)))
+                return 0; // No corner cutting
+            if (!step(y, x, dy, dx) || !walkable(y, x))
+                return 0;
+            if ((y == goal.y && x == goal.x) || steps == JUMP_LIMIT)
+                return steps; // Stopping early only adds a jump point, and ends the walks around a torus
+            if (diagonal) { // A jump point if a straight walk from here finds one
+                int row = y, column = x;
+                if (jump(row, column, 0, dx) > 0)
+                    return steps;
+                row = y, column = x;
+                if (jump(row, column, dy, 0) > 0)
+                    return steps;
+            } else if (dx != 0) { // Forced neighbours: a side cell reachable only through this one
+                if ((walkable(y, x, -1, 0) && !walkable(y, x, -1, -dx)) || (walkable(y, x, 1, 0) && !walkable(y, x, 1, -dx)))
+                    return steps;
+            } else {
+                if ((walkable(y, x, 0, -1) && !walkable(y, x, -dy, -1)) || (walkable(y, x, 0, 1) && !walkable(y, x, -dy, 1)))
+                    return steps;
+            }
+        }
+    }
+
+    bool PathFinder::search(PathSearch algorithm) const {
+        static constexpr int directions[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        bool jumping = algorithm == PathSearch::JUMP_POINT && connectivity == Connectivity::EIGHT
+            && (!wrap || (width >= 3 && height >= 3)); // Narrower tori make both sides of a cell the same one
+        int count = connectivity == Connectivity::EIGHT ? 8 : 4;
+        SearchBuffers& search = buffers;
+        search.begin(width, height);
+        search.node(start).cost = 0;
+        search.open.push_back(OpenNode{heuristic(start.y, start.x), 0, start.pack()});
+        while (!search.open.empty()) {
+            std::pop_heap(search.open.begin(), search.open.end());
+            OpenNode top = search.open.back();
+            search.open.pop_back();
+            Coordinates cell = Coordinates::unpack(top.cell);
+            SearchNode& node = search.node(cell);
+            if (node.closed || top.cost != node.cost)
+                continue; // A stale entry of a node improved later
+            if (cell == goal)
+                return true;
+            node.closed = true;
+            int arrivalY = node.dy, arrivalX = node.dx; // Copied, as hashed nodes move when others are added
+
+            int pruned[8][2]; // The directions to walk from the node
+            int walks = 0;
+            if (!jumping || (arrivalY == 0 && arrivalX == 0)) {
+                for (int i = 0; i < count; i++, walks++) {
+                    pruned[walks][0] = directions[i][0];
+                    pruned[walks][1] = directions[i][1];
+                }
+            } else if (arrivalY != 0 && arrivalX != 0) { // Diagonal: its two components and itself
+                int natural[3][2] = {{arrivalY, 0}, {0, arrivalX}, {arrivalY, arrivalX}};
+                for (auto& direction : natural) {
+                    pruned[walks][0] = direction[0];
+                    pruned[walks++][1] = direction[1];
+                }
+            } else { // Straight: ahead, and the sides with their diagonals ahead
+                int sideY = arrivalX, sideX = arrivalY; // Perpendicular to the arrival
+                int natural[5][2] = {{arrivalY, arrivalX}, {sideY, sideX}, {-sideY, -sideX},
+                                     {arrivalY + sideY, arrivalX + sideX}, {arrivalY - sideY, arrivalX - sideX}};
+                for (auto& direction : natural) {
+                    pruned[walks][0] = direction[0];
+                    pruned[walks++][1] = direction[1];
+                }
+            }
+
+            for (int i = 0; i < walks; i++) {
+                int dy = pruned[i][0], dx = pruned[i][1];
+                bool diagonal = dy != 0 && dx != 0;
+                int y = cell.y, x = cell.x;
+                std::uint32_t steps;
+                if (jumping) {
+                    steps = jump(y, x, dy, dx);
+                } else {
+                    if (diagonal && (!walkable(y, x, 0, dx) || !walkable(y, x, dy, 0)))
+                        continue; // No corner cutting
+                    steps = step(y, x, dy, dx) && walkable(y, x) ? 1 : 0;
+                }
+                if (steps == 0)
+                    continue;
+                std::uint32_t cost = top.cost + steps * (diagonal ? DIAGONAL_COST : ORTHOGONAL_COST);
+                Coordinates reached(static_cast<unsigned short>(y), static_cast<unsigned short>(x));
+                SearchNode& next = search.node(reached);
+                if (next.closed || cost >= next.cost)
+                    continue;
+                next.cost = cost;
+                next.parent = top.cell;
+                next.dy = static_cast<std::int8_t>(dy);
+                next.dx = static_cast<std::int8_t>(dx);
+                search.open.push_back(OpenNode{cost + heuristic(y, x), cost, reached.pack()});
+                std::push_heap(search.open.begin(), search.open.end());
+            }
+        }
+        return false;
+    }
+
+    bool PathFinder::findPath(const Coordinates& from, const Coordinates& to, std::vector<Coordinates>& path, PathSearch algorithm) {
+        path.clear();
+        if (field->isOutOfBounds(from) || field->isOutOfBounds(to))
+            return false;
+        if (from == to)
+            return true;
+        start = from;
+        goal = to;
+        if (!search(algorithm))
+            return false;
+        for (Coordinates cell = to; !(cell == from);) { // Back from the goal, a jump at a time
+            const SearchNode& node = buffers.node(cell);
+            Coordinates parent = Coordinates::unpack(node.parent);
+            int dy = node.dy, dx = node.dx;
+            while (!(cell == parent)) { // The straight cells between two jump points
+                path.push_back(cell);
+                int y = cell.y, x = cell.x;
+                step(y, x, -dy, -dx);
+                cell = Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x));
+            }
+        }
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+    std::uint32_t PathFinder::pathCost(const Coordinates& from, const std::vector<Coordinates>& path) const {
+        std::uint32_t cost = 0;
+        Coordinates previous = from;
+        for (const Coordinates& cell : path) {
+            cost += cell.y != previous.y && cell.x != previous.x ? DIAGONAL_COST : ORTHOGONAL_COST;
+            previous = cell;
+        }
+        return cost;
+    }
+};
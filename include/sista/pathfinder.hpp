@@ -0,0 +1,135 @@
+/** \file pathfinder.hpp
+ *  \brief PathFinder class header file.
+ *
+ *  This file contains the PathFinder class, searching the shortest path between two cells of a
+ *  Field with A* or, on 8-connected grids, with Jump Point Search. The free cells are the
+ *  walkable ones, and the PACMAN effect makes the field a torus, where paths may cross the edges.
+ *
+ *  The nodes of the search are kept in per-thread buffers reused by every query: a node is
+ *  reset by bumping a generation stamp instead of clearing the buffers, so a query allocates
+ *  only when it explores more cells than any previous query of the thread.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see PathFinder
+ *  \see Field::findPath
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <vector> // std::vector
+#include "coordinates.hpp"
+#include "effect.hpp"
+
+namespace sista {
+    class Field;
+
+    /** \enum Connectivity
+     *  \brief The moves allowed from a cell to its neighbours.
+     *
+     *  - FOUR: up, down, left and right, each costing one step.
+     *  - EIGHT: also the diagonals, costing about 1.4 steps; a diagonal move is allowed only if
+     *    both cells it cuts the corner of are free.
+     *
+     *  \see PathFinder
+    */
+    enum class Connectivity {
+        FOUR = 4, // Orthogonal moves only
+        EIGHT = 8 // Orthogonal and diagonal moves
+    };
+
+    /** \enum PathSearch
+     *  \brief The algorithm searching a path.
+     *
+     *  - ASTAR: A* expanding every neighbour of a cell.
+     *  - JUMP_POINT: Jump Point Search, which expands only the cells where a path must turn,
+     *    skipping the symmetric paths of uniform grids. It needs Connectivity::EIGHT and falls
+     *    back to ASTAR otherwise, as on tori narrower than three cells.
+     *
+     *  Both find paths of the same length.
+     *
+     *  \see PathFinder
+    */
+    enum class PathSearch {
+        ASTAR = 0, // Expands every neighbour
+        JUMP_POINT = 1 // Expands only the jump points
+    };
+
+    /** \class PathFinder
+     *  \brief Searches shortest paths between the cells of a Field.
+     *
+     *  A PathFinder reads the occupancy of its Field at each query, so it stays valid while the
+     *  Pawns move, and is cheap to construct. The start and the goal of a path may be occupied,
+     *  like a Pawn chasing another one; every other cell of the path is free.
+     *
+     *  The topology of the field is given by an Effect: PACMAN wraps the paths around the edges,
+     *  the other effects stop them at the edges.
+     *
+     *  \see Field::findPath
+     *  \see Connectivity
+     *  \see PathSearch
+    */
+    class PathFinder {
+    public:
+        static constexpr std::uint32_t ORTHOGONAL_COST = 5; /** Cost of an orthogonal step. */
+        static constexpr std::uint32_t DIAGONAL_COST = 7; /** Cost of a diagonal step, about sqrt(2) orthogonal ones. */
+        static constexpr std::size_t DENSE_NODES = 1u << 20; /** Largest field whose nodes are indexed by cell rather than hashed. */
+        static constexpr std::uint32_t JUMP_LIMIT = 64; /** Longest jump, so that open areas of large fields are not walked to their edges. */
+
+    private:
+        const Field* field; /** The field the paths are searched on. */
+        int width; /** Width of the field. */
+        int height; /** Height of the field. */
+        Connectivity connectivity; /** Moves allowed from a cell. */
+        bool wrap; /** Whether the paths wrap around the edges (PACMAN). */
+        Coordinates start; /** Start of the current query, walkable even if occupied. */
+        Coordinates goal; /** Goal of the current query, walkable even if occupied. */
+
+        /** \brief Moves a position by one step, wrapping it or returning false at the edges. */
+        bool step(int& y, int& x, int dy, int dx) const;
+        /** \brief Checks whether a cell can be entered: inside the field, and free, the start or the goal. */
+        bool walkable(int y, int x) const;
+        /** \brief Checks whether the cell one step away can be entered. */
+        bool walkable(int y, int x, int dy, int dx) const;
+        /** \brief Estimates the cost from a cell to the goal, never overestimating it. */
+        std::uint32_t heuristic(int y, int x) const;
+        /** \brief Walks from a cell in a direction until a jump point, the goal or an obstacle.
+         *  \param y The row, set to the jump point.
+         *  \param x The column, set to the jump point.
+         *  \param dy The row direction, -1, 0 or 1.
+         *  \param dx The column direction, -1, 0 or 1.
+         *  \return The number of steps to the jump point, 0 if there is none.
+         *
+         *  A walk of JUMP_LIMIT steps ends at a jump point too: the extra jump points cost a few
+         *  more nodes, but no path is missed.
+        */
+        std::uint32_t jump(int& y, int& x, int dy, int dx) const;
+        /** \brief Runs the search from the start to the goal, filling the parents of the nodes. */
+        bool search(PathSearch algorithm) const;
+
+    public:
+        /** \brief Constructor of a path finder on a field.
+         *  \param field The field, which must outlive the path finder.
+         *  \param connectivity The moves allowed from a cell.
+         *  \param effect The topology of the field: PACMAN wraps around the edges, the other effects don't.
+        */
+        PathFinder(const Field&, Connectivity=Connectivity::FOUR, Effect=Effect::CLAMP);
+
+        /** \brief Searches a shortest path between two cells.
+         *  \param from The start cell, which may be occupied.
+         *  \param to The goal cell, which may be occupied.
+         *  \param path Set to the cells of the path, from the one after `from` to `to`;
+         *              empty if `from` is `to` or there is no path. Its capacity is reused.
+         *  \param algorithm The search algorithm, A* or Jump Point Search.
+         *  \return False if `to` can't be reached or a cell is out of bounds.
+         *
+         *  \see PathSearch
+        */
+        bool findPath(const Coordinates&, const Coordinates&, std::vector<Coordinates>&, PathSearch=PathSearch::ASTAR);
+        /** \brief Returns the cost of a path found by findPath, in ORTHOGONAL_COST per orthogonal step. */
+        std::uint32_t pathCost(const Coordinates&, const std::vector<Coordinates>&) const;
+    };
+};
@@ -12,7 +12,7 @@
  *  \copyright GNU General Public License v3.0
  */
 #include "pawn.hpp"
-#include <iostream>
+#include "output.hpp"
 
 namespace sista {
     Pawn::Pawn(char symbol_, const Coordinates& coordinates_, const ANSISettings& settings_): symbol(symbol_), coordinates(coordinates_), settings(settings_) {}
@@ -46,6 +46,6 @@ namespace sista {
 
     void Pawn::print() const { // Print the pawn
         settings.apply(); // Apply the settings
-        std::cout << symbol; // Print the symbol
+        getOutputStream() << symbol; // Print the symbol
     }
 };
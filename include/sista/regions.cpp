@@ -0,0 +1,286 @@
+/** \file regions.cpp
+ *  \brief Implementation of the Regions class.
+ *
+ *  A labelling reads the runs of set bits of each row, gives each run the provisional label of
+ *  the runs touching it in the row above, joining their labels in a union-find when there are
+ *  several, and then replaces every provisional label with the consecutive label of its root.
+ *
+ *  The edits fill a region span by span: a span is extended left and right along its row, and
+ *  the first cell of each run of the region in the rows above and below is pushed on a stack.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see Regions
+ *  \copyright GNU General Public License v3.0
+ */
+#include "regions.hpp"
+#include <algorithm> // std::fill, std::min, std::max
+
+namespace sista {
+    // The neighbours of a cell, clockwise from above: the even ones are orthogonal, the odd ones diagonal
+    static constexpr int RING[8][2] = {{-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}};
+
+    Regions::Regions(const Field& field_, Connectivity connectivity_):
+        field(&field_), width(field_.getWidth()), height(field_.getHeight()),
+        connectivity(connectivity_), occupied(false),
+        words((static_cast<std::size_t>(field_.getWidth()) + 63) / 64),
+        members(words * field_.getHeight(), 0),
+        labels(static_cast<std::size_t>(field_.getWidth()) * field_.getHeight(), NONE),
+        sizes(1, 0), count(0) {}
+
+    void Regions::loadOccupancy(bool occupied_) {
+        occupied = occupied_;
+        std::fill(members.begin(), members.end(), 0);
+        for (int y = 0; y < height; y++) {
+            std::uint64_t* row = &members[y * words];
+            for (int x = 0; x < width;) { // A word of occupancy at a time
+                unsigned int length;
+                std::uint64_t bits = field->getOccupancy(static_cast<unsigned short>(y), static_cast<unsigned short>(x), length);
+                unsigned int shift = x & 63;
+                row[x >> 6] |= bits << shift;
+                if (shift + length > 64) // The bits read straddle two words of the bitmap
+                    row[(x >> 6) + 1] |= bits >> (64 - shift);
+                x += length;
+            }
+            if (!occupied) {
+                for (std::size_t word = 0; word < words; word++)
+                    row[word] = ~row[word];
+                row[words - 1] &= lowBits(static_cast<unsigned int>(width - 64 * (words - 1))); // Not past the last column
+            }
+        }
+    }
+
+    std::uint32_t Regions::find(std::uint32_t label) {
+        while (parents[label] != label) {
+            parents[label] = parents[parents[label]];
+            label = parents[label];
+        }
+        return label;
+    }
+    void Regions::labelAll() {
+        std::fill(labels.begin(), labels.end(), NONE);
+        parents.assign(1, NONE);
+        int reach = connectivity == Connectivity::EIGHT ? 1 : 0; // Columns touching a run diagonally
+        for (int y = 0; y < height; y++) {
+            const std::uint64_t* row = &members[y * words];
+            auto next = [&](int x, bool set) { // The first column from x whose bit is `set`, or the width
+                while (x < width) {
+                    std::uint64_t word = (set ? row[x >> 6] : ~row[x >> 6]) & ~lowBits(x & 63);
+                    if (word != 0)
+                        return std::min(width, (x & ~63) + static_cast<int>(countTrailingZeros(word)));
+                    x = (x & ~63) + 64;
+                }
+                return width;
+            };
+            for (int start = next(0, true), end; start < width; start = next(end, true)) {
+                end = next(start, false);
+                std::uint32_t provisional = NONE;
+                if (y > 0) { // Joins the labels of the runs above touching this one
+                    std::uint32_t previous = NONE;
+                    for (int x = std::max(0, start - reach); x < std::min(width, end + reach); x++) {
+                        std::uint32_t above = labels[index(y - 1, x)];
+                        if (above == NONE || above == previous)
+                            continue;
+                        previous = above;
+                        if (provisional == NONE) {
+                            provisional = above;
+                            continue;
+                        }
+                        std::uint32_t first = find(provisional), second = find(above);
+                        if (first != second)
+                            parents[std::max(first, second)] = std::min(first, second); // Roots stay below their labels
+                    }
+                }
+                if (provisional == NONE) {
+                    provisional = static_cast<std::uint32_t>(parents.size());
+                    parents.push_back(provisional);
+                }
+                std::fill(labels.begin() + index(y, start), labels.begin() + index(y, end), provisional);
+            }
+        }
+        // A parent is below its label, so it already holds the final label when the label is reached
+        sizes.assign(1, 0);
+        for (std::uint32_t label = 1; label < parents.size(); label++) {
+            if (parents[label] == label) {
+                parents[label] = static_cast<std::uint32_t>(sizes.size());
+                sizes.push_back(0);
+            } else {
+                parents[label] = parents[parents[label]];
+            }
+        }
+        for (std::uint32_t& label : labels) {
+            label = parents[label];
+            sizes[label]++;
+        }
+        sizes[NONE] = 0;
+        count = sizes.size() - 1;
+        unused.clear();
+    }
+
+    void Regions::labelFree() {
+        loadOccupancy(false);
+        labelAll();
+    }
+    void Regions::labelOccupied() {
+        loadOccupancy(true);
+        labelAll();
+    }
+
+    std::uint32_t Regions::allocate() {
+        if (!unused.empty()) {
+            std::uint32_t label = unused.back();
+            unused.pop_back();
+            return label;
+        }
+        sizes.push_back(0);
+        return static_cast<std::uint32_t>(sizes.size() - 1);
+    }
+    std::uint32_t Regions::relabel(int y, int x, std::uint32_t from, std::uint32_t to) {
+        int reach = connectivity == Connectivity::EIGHT ? 1 : 0;
+        std::uint32_t filled = 0;
+        stack.clear();
+        stack.push_back(static_cast<std::uint32_t>(index(y, x)));
+        while (!stack.empty()) {
+            std::uint32_t cell = stack.back();
+            stack.pop_back();
+            if (labels[cell] != from)
+                continue; // Filled since it was pushed
+            int row = static_cast<int>(cell / width), column = static_cast<int>(cell % width);
+            int left = column, right = column;
+            while (left > 0 && labels[index(row, left - 1)] == from)
+                left--;
+            while (right + 1 < width && labels[index(row, right + 1)] == from)
+                right++;
+            std::fill(labels.begin() + index(row, left), labels.begin() + index(row, right) + 1, to);
+            filled += static_cast<std::uint32_t>(right - left + 1);
+            for (int side : {row - 1, row + 1}) { // A seed for each run of the region touching the span
+                if (side < 0 || side >= height)
+                    continue;
+                bool run = false;
+                for (int x_ = std::max(0, left - reach); x_ <= std::min(width - 1, right + reach); x_++) {
+                    bool inside = labels[index(side, x_)] == from;
+                    if (inside && !run)
+                        stack.push_back(static_cast<std::uint32_t>(index(side, x_)));
+                    run = inside;
+                }
+            }
+        }
+        return filled;
+    }
+    bool Regions::mayDisconnect(int y, int x) const {
+        bool eight = connectivity == Connectivity::EIGHT;
+        bool inside[8];
+        int group[8];
+        for (int i = 0; i < 8; i++) {
+            inside[i] = member(y + RING[i][0], x + RING[i][1]);
+            group[i] = i;
+        }
+        auto root = [&](int i) {
+            while (group[i] != i)
+                i = group[i];
+            return i;
+        };
+        for (int i = 0; i < 8; i++) { // Consecutive cells of the ring touch by a side
+            if (inside[i] && inside[(i + 1) % 8])
+                group[root((i + 1) % 8)] = root(i);
+            if (eight && i % 2 == 0 && inside[i] && inside[(i + 2) % 8]) // Orthogonal neighbours touch by a corner
+                group[root((i + 2) % 8)] = root(i);
+        }
+        int first = -1;
+        for (int i = 0; i < 8; i++) {
+            if (!inside[i] || (!eight && i % 2 == 1))
+                continue; // Not a neighbour in the set
+            if (first == -1)
+                first = root(i);
+            else if (root(i) != first)
+                return true;
+        }
+        return false;
+    }
+
+    void Regions::setMember(const Coordinates& coordinates, bool inSet) {
+        int y = coordinates.y, x = coordinates.x;
+        if (y >= height || x >= width || member(y, x) == inSet)
+            return;
+        members[y * words + (x >> 6)] ^= 1ULL << (x & 63);
+        int stride = connectivity == Connectivity::EIGHT ? 1 : 2;
+        std::uint32_t& label = labels[index(y, x)];
+        if (inSet) { // Joins the regions around the cell into the largest one
+            std::uint32_t largest = NONE;
+            for (int i = 0; i < 8; i += stride) {
+                int row = y + RING[i][0], column = x + RING[i][1];
+                if (member(row, column) && sizes[labels[index(row, column)]] > sizes[largest])
+                    largest = labels[index(row, column)];
+            }
+            if (largest == NONE) {
+                largest = allocate();
+                count++;
+            }
+            label = largest;
+            sizes[largest]++;
+            for (int i = 0; i < 8; i += stride) {
+                int row = y + RING[i][0], column = x + RING[i][1];
+                if (!member(row, column) || labels[index(row, column)] == largest)
+                    continue;
+                std::uint32_t joined = labels[index(row, column)];
+                sizes[largest] += relabel(row, column, joined, largest);
+                sizes[joined] = 0;
+                unused.push_back(joined);
+                count--;
+            }
+            return;
+        }
+        std::uint32_t old = label;
+        label = NONE;
+        if (--sizes[old] == 0) {
+            unused.push_back(old);
+            count--;
+            return;
+        }
+        if (!mayDisconnect(y, x))
+            return;
+        // Every part but the last one found gets a new label
+        for (int i = 0; i < 8; i += stride) {
+            int row = y + RING[i][0], column = x + RING[i][1];
+            if (!member(row, column) || labels[index(row, column)] != old)
+                continue;
+            bool others = false;
+            for (int j = i + stride; j < 8 && !others; j += stride)
+                others = member(y + RING[j][0], x + RING[j][1]) && labels[index(y + RING[j][0], x + RING[j][1])] == old;
+            if (!others)
+                break;
+            std::uint32_t part = allocate();
+            sizes[part] = relabel(row, column, old, part);
+            sizes[old] -= sizes[part];
+            count++;
+        }
+        if (sizes[old] == 0) { // The parts were joined elsewhere, and the first fill took the whole region
+            unused.push_back(old);
+            count--;
+        }
+    }
+    void Regions::update(const Coordinates& coordinates) {
+        if (coordinates.y < height && coordinates.x < width)
+            setMember(coordinates, field->isOccupied(coordinates) == occupied);
+    }
+
+    std::uint32_t Regions::getLabel(const Coordinates& coordinates) const {
+        if (coordinates.y >= height || coordinates.x >= width)
+            return NONE;
+        return labels[index(coordinates.y, coordinates.x)];
+    }
+    const std::vector<std::uint32_t>& Regions::getLabels() const {
+        return labels;
+    }
+    std::size_t Regions::getRegionSize(std::uint32_t label) const {
+        return label < sizes.size() ? sizes[label] : 0;
+    }
+    std::size_t Regions::getRegionCount() const {
+        return count;
+    }
+    bool Regions::connected(const Coordinates& first, const Coordinates& second) const {
+        std::uint32_t label = getLabel(first);
+        return label != NONE && label == getLabel(second);
+    }
+};
@@ -0,0 +1,130 @@
+/** \file regions.hpp
+ *  \brief Regions class header file.
+ *
+ *  This file contains the Regions class, labelling the connected components of a set of cells
+ *  of a Field: the free cells, the occupied ones, or those satisfying a predicate. The whole
+ *  field is labelled with a two-pass union-find over the runs of each row, read from a bitmap
+ *  a word at a time; the single edits then relabel only the cells of the regions they join or
+ *  split, with scanline flood fills.
+ *
+ *  The labels are kept in a buffer of the Regions, reused by every labelling and edit.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see Regions
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <algorithm> // std::fill
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <vector> // std::vector
+#include "field.hpp"
+
+namespace sista {
+    /** \class Regions
+     *  \brief The connected components of a set of cells of a Field.
+     *
+     *  Each cell of the set gets the label of its region, and the other cells get NONE. Two
+     *  cells of the set are in the same region if a walk through the set joins them, with the
+     *  moves of a Connectivity; with EIGHT, two cells touching by a corner are always joined.
+     *  The regions stop at the edges of the field, whatever its Effect.
+     *
+     *  The labels are consecutive from 1 after a labelling, and may have gaps after the edits.
+     *  The field must keep its dimensions and outlive the Regions.
+     *
+     *  \see Field::getOccupancy
+    */
+    class Regions {
+    public:
+        static constexpr std::uint32_t NONE = 0; /** Label of the cells out of the set. */
+
+    private:
+        const Field* field; /** The field the regions are labelled on. */
+        int width; /** Width of the field. */
+        int height; /** Height of the field. */
+        Connectivity connectivity; /** Moves joining two cells. */
+        bool occupied; /** Whether update reads the occupied cells as the set, rather than the free ones. */
+        std::size_t words; /** Words of a row of the bitmap. */
+        std::vector<std::uint64_t> members; /** A bit per cell, set for the cells of the set. */
+        std::vector<std::uint32_t> labels; /** Label of each cell, row by row. */
+        std::vector<std::uint32_t> sizes; /** Number of cells of each label, 0 for the unused ones. */
+        std::vector<std::uint32_t> unused; /** Labels freed by the edits, reused before new ones. */
+        std::vector<std::uint32_t> parents; /** Scratch union-find of the provisional labels of a labelling. */
+        std::vector<std::uint32_t> stack; /** Scratch stack of the flood fills, as cell indices. */
+        std::size_t count; /** Number of regions. */
+
+        /** \brief Returns the index of a cell in the row-major storage. */
+        std::size_t index(int y, int x) const {
+            return static_cast<std::size_t>(y) * width + x;
+        }
+        /** \brief Checks whether a cell is in the set, false if it is out of bounds. */
+        bool member(int y, int x) const {
+            return static_cast<unsigned int>(y) < static_cast<unsigned int>(height)
+                && static_cast<unsigned int>(x) < static_cast<unsigned int>(width)
+                && (members[y * words + (x >> 6)] >> (x & 63) & 1);
+        }
+        /** \brief Loads the set from the occupancy of the field, the occupied or the free cells. */
+        void loadOccupancy(bool);
+        /** \brief Returns the root of a provisional label, halving the path to it. */
+        std::uint32_t find(std::uint32_t);
+        /** \brief Labels every cell of the set, with a union-find over the runs of each row. */
+        void labelAll();
+        /** \brief Returns an unused label, with no cells. */
+        std::uint32_t allocate();
+        /** \brief Gives the label `to` to the cells labelled `from` joined to a cell, with a scanline flood fill.
+         *  \return The number of cells relabelled.
+        */
+        std::uint32_t relabel(int y, int x, std::uint32_t from, std::uint32_t to);
+        /** \brief Checks whether the neighbours of a cell in the set may be disconnected without it. */
+        bool mayDisconnect(int y, int x) const;
+
+    public:
+        /** \brief Constructor of the regions of a field, with no cell in the set.
+         *  \param field The field, which must outlive the Regions.
+         *  \param connectivity The moves joining two cells.
+        */
+        Regions(const Field&, Connectivity=Connectivity::FOUR);
+
+        /** \brief Labels the regions of the free cells, like the rooms of a map. */
+        void labelFree();
+        /** \brief Labels the regions of the occupied cells, like the groups of touching Pawns. */
+        void labelOccupied();
+        /** \brief Labels the regions of the cells satisfying a predicate.
+         *  \param inSet A predicate called with the Coordinates of each cell, like the cells owned by a player.
+        */
+        template <typename Predicate>
+        void label(Predicate inSet) {
+            std::fill(members.begin(), members.end(), 0);
+            for (int y = 0; y < height; y++)
+                for (int x = 0; x < width; x++)
+                    if (inSet(Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x))))
+                        members[y * words + (x >> 6)] |= 1ULL << (x & 63);
+            labelAll();
+        }
+
+        /** \brief Adds a cell to the set or removes it, relabelling only the regions it joins or splits.
+         *  \param coordinates The cell; the cells out of bounds are ignored.
+         *  \param inSet Whether the cell is in the set.
+         *
+         *  Joining regions relabels all but the largest one; splitting a region relabels all but one of its
+         *  parts, after a check of the neighbours of the cell skips most of the removals that split nothing.
+        */
+        void setMember(const Coordinates&, bool);
+        /** \brief Reads the occupancy of a cell after it changed, like setMember, for the sets of labelFree and labelOccupied. */
+        void update(const Coordinates&);
+
+        /** \brief Returns the label of the region of a cell, NONE if it is out of the set or out of bounds. */
+        std::uint32_t getLabel(const Coordinates&) const;
+        /** \brief Returns the labels of every cell, row by row, width times height of them. */
+        const std::vector<std::uint32_t>& getLabels() const;
+        /** \brief Returns the number of cells of the region with a label, 0 if there is none. */
+        std::size_t getRegionSize(std::uint32_t) const;
+        /** \brief Returns the number of regions. */
+        std::size_t getRegionCount() const;
+        /** \brief Checks whether two cells are in the same region. */
+        bool connected(const Coordinates&, const Coordinates&) const;
+    };
+};
@@ -0,0 +1,437 @@
+/** \file server.cpp
+ *  \brief Implementation of the WorkerPool and of the SessionServer.
+ *
+ *  The WorkerPool hands out the iterations of a loop through an atomic counter, so
+ *  sessions are rendered by whichever thread is free. The SessionServer uses `epoll`
+ *  in level-triggered mode on non-blocking sockets.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see SessionServer
+ *  \copyright GNU General Public License v3.0
+ */
+#include "server.hpp"
+#include "trace.hpp"
+#include <stdexcept>
+#include <system_error>
+
+#ifdef SISTA_HAS_SESSION_SERVER
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#endif
+
+namespace sista {
+    WorkerPool::WorkerPool(unsigned threadCount): task(nullptr), count(0), next(0), busy(0), generation(0), stopping(false) {
+        for (unsigned i = 0; i < threadCount; i++)
+            threads.emplace_back(&WorkerPool::work, this);
+    }
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    unsigned WorkerPool::size() const {
+        return threads.size();
+    }
+
+    void WorkerPool::runIterations() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            try {
+                (*task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+
+    void WorkerPool::work() {
+        unsigned long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            lock.unlock();
+            runIterations();
+            lock.lock();
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+
+    void WorkerPool::run(std::size_t count_, const std::function<void(std::size_t)>& task_) {
+        if (count_ == 0)
+            return;
+        bool parallel = !threads.empty() && count_ > 1; // A single iteration runs on the calling thread
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &task_;
+            count = count_;
+            next = 0;
+            error = nullptr;
+            busy = parallel ? threads.size() : 0;
+            if (parallel)
+                generation++;
+        }
+        if (parallel)
+            wake.notify_all();
+        runIterations(); // The calling thread takes part in the loop
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+        task = nullptr;
+        if (error) {
+            std::exception_ptr thrown = error;
+            error = nullptr;
+            std::rethrow_exception(thrown);
+        }
+    }
+
+#ifdef SISTA_HAS_SESSION_SERVER
+    Session::Session(int descriptor_, unsigned id_, std::unique_ptr<OutputSink> sink_):
+        descriptor(descriptor_), id(id_), sink(std::move(sink_)),
+        writer(dynamic_cast<FileDescriptorSink*>(sink.get())), frames(0),
+        closing(false), writeInterest(false), field(nullptr), userData(nullptr) {}
+
+    unsigned Session::getId() const {
+        return id;
+    }
+    int Session::fileDescriptor() const {
+        return descriptor;
+    }
+    OutputSink& Session::getSink() {
+        return *sink;
+    }
+    unsigned long Session::getFrames() const {
+        return frames;
+    }
+    void Session::setField(Field* field_) {
+        field = field_;
+    }
+    Field* Session::getField() const {
+        return field;
+    }
+    void Session::setUserData(void* userData_) {
+        userData = userData_;
+    }
+    void* Session::getUserData() const {
+        return userData;
+    }
+    void Session::close() {
+        closing = true;
+    }
+    bool Session::isClosing() const {
+        return closing;
+    }
+
+    SessionServer::SessionServer(unsigned workers):
+        inputBuffer(4096), nextId(1), pool(workers > 1 ? workers - 1 : 0) {
+        epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+        if (epollDescriptor < 0)
+            throw std::system_error(errno, std::generic_category(), "epoll_create1");
+        std::signal(SIGPIPE, SIG_IGN);
+    }
+    SessionServer::~SessionServer() {
+        while (!sessions.empty()) {
+            int descriptor = sessions.begin()->first;
+            sessions.erase(sessions.begin()); // The sink writes what it can before the socket is closed
+            ::close(descriptor);
+        }
+        for (const Listener& listener : listeners) {
+            ::close(listener.descriptor);
+            if (!listener.path.empty())
+                unlink(listener.path.c_str());
+        }
+        ::close(epollDescriptor);
+    }
+
+    int SessionServer::addListener(int descriptor, const std::string& path) {
+        if (::listen(descriptor, SOMAXCONN) != 0) {
+            int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), "listen");
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+        if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+            int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), "epoll_ctl");
+        }
+        listeners.push_back({descriptor, path});
+        return descriptor;
+    }
+
+    int SessionServer::listenUnix(const std::string& path) {
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+            throw std::invalid_argument("Invalid Unix socket path");
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        struct stat status;
+        if (stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+            unlink(path.c_str()); // Stale socket of a previous server
+        int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (descriptor < 0)
+            throw std::system_error(errno, std::generic_category(), "socket");
+        if (bind(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), "bind");
+        }
+        return addListener(descriptor, path);
+    }
+
+    unsigned short SessionServer::listenTCP(unsigned short port, const std::string& host) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1)
+            throw std::invalid_argument("Invalid IPv4 address");
+        int descriptor = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (descriptor < 0)
+            throw std::system_error(errno, std::generic_category(), "socket");
+        int enable = 1;
+        setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        socklen_t length = sizeof(address);
+        if (bind(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+                || getsockname(descriptor, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), "bind");
+        }
+        addListener(descriptor, "");
+        return ntohs(address.sin_port);
+    }
+
+    bool SessionServer::enableAsyncOutput(unsigned bufferCount, std::size_t bufferSize) {
+#ifdef SISTA_HAS_IO_URING
+        if (uring != nullptr) // Sinks already submit through it
+            return uring->available();
+        std::unique_ptr<UringContext> context(new UringContext(bufferCount, bufferSize));
+        if (context->available()) { // Completions wake poll() like the sockets do
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = context->fileDescriptor();
+            if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, context->fileDescriptor(), &event) != 0)
+                return false;
+        }
+        uring = std::move(context);
+        return uring->available();
+#else
+        (void)bufferCount;
+        (void)bufferSize;
+        return false;
+#endif
+    }
+    bool SessionServer::hasAsyncOutput() const {
+#ifdef SISTA_HAS_IO_URING
+        return uring != nullptr && uring->available();
+#else
+        return false;
+#endif
+    }
+    void SessionServer::submit() {
+#ifdef SISTA_HAS_IO_URING
+        if (uring != nullptr) {
+            uring->reap(); // Completions queue the next writes of their sinks
+            uring->submit(); // A single system call for every session
+        }
+#endif
+    }
+
+    void SessionServer::onConnect(Handler handler) {
+        connectHandler = std::move(handler);
+    }
+    void SessionServer::onInput(InputHandler handler) {
+        inputHandler = std::move(handler);
+    }
+    void SessionServer::onDisconnect(Handler handler) {
+        disconnectHandler = std::move(handler);
+    }
+
+    void SessionServer::accept(int listener) {
+        while (true) {
+            int descriptor = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (descriptor < 0) {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                return; // EAGAIN, or out of descriptors until some session closes
+            }
+            int enable = 1; // Frames are written whole, so Nagle's algorithm only adds latency
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = descriptor;
+            if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+                ::close(descriptor);
+                continue;
+            }
+#ifdef SISTA_HAS_IO_URING
+            std::unique_ptr<OutputSink> sink = uring != nullptr ? makeAsyncSink(*uring, descriptor)
+                                                                : std::unique_ptr<OutputSink>(new FileDescriptorSink(descriptor));
+#else
+            std::unique_ptr<OutputSink> sink(new FileDescriptorSink(descriptor));
+#endif
+            Session* session = new Session(descriptor, nextId++, std::move(sink));
+            sessions[descriptor].reset(session);
+            if (connectHandler)
+                connectHandler(*session);
+        }
+    }
+
+    void SessionServer::receive(Session& session) {
+        while (!session.closing) {
+            ssize_t received = read(session.descriptor, inputBuffer.data(), inputBuffer.size());
+            if (received > 0) {
+                if (inputHandler)
+                    inputHandler(session, inputBuffer.data(), received);
+            } else if (received == 0) {
+                session.closing = true; // The peer hung up
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    session.closing = true;
+                return;
+            }
+        }
+    }
+
+    void SessionServer::updateInterest(Session& session) {
+        bool interest = session.writer != nullptr && session.writer->pending(); // io_uring waits for the socket itself
+        if (interest == session.writeInterest)
+            return;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (interest ? EPOLLOUT : 0);
+        event.data.fd = session.descriptor;
+        if (epoll_ctl(epollDescriptor, EPOLL_CTL_MOD, session.descriptor, &event) == 0)
+            session.writeInterest = interest;
+    }
+
+    void SessionServer::closeSessions() {
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            Session& session = *it->second;
+            if (!session.closing) {
+                ++it;
+                continue;
+            }
+            if (disconnectHandler)
+                disconnectHandler(session);
+            epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, session.descriptor, nullptr);
+            int descriptor = session.descriptor;
+            it = sessions.erase(it); // The sink writes what it can before the socket is closed
+            ::close(descriptor);
+        }
+    }
+
+    std::size_t SessionServer::poll(int timeout) {
+        submit();
+        for (auto& entry : sessions) { // Frames may have been enqueued outside render(), e.g. by a BroadcastChannel
+            if (entry.second->sink->hasFailed())
+                entry.second->closing = true;
+            else
+                updateInterest(*entry.second);
+        }
+        closeSessions();
+        epoll_event events[64];
+        int ready = epoll_wait(epollDescriptor, events, 64, timeout);
+        if (ready < 0) {
+            if (errno == EINTR)
+                return 0;
+            throw std::system_error(errno, std::generic_category(), "epoll_wait");
+        }
+        for (int i = 0; i < ready; i++) {
+            int descriptor = events[i].data.fd;
+#ifdef SISTA_HAS_IO_URING
+            if (uring != nullptr && descriptor == uring->fileDescriptor()) {
+                submit(); // Some writes completed
+                continue;
+            }
+#endif
+            auto found = sessions.find(descriptor);
+            if (found == sessions.end()) {
+                accept(descriptor); // Not a session, hence a listener
+                continue;
+            }
+            Session& session = *found->second;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                receive(session);
+            if ((events[i].events & EPOLLOUT) && session.writer != nullptr) {
+                session.writer->flush();
+                if (session.writer->hasFailed())
+                    session.closing = true;
+                else
+                    updateInterest(session);
+            }
+        }
+        closeSessions();
+        return ready;
+    }
+
+    void SessionServer::render(const Handler& handler) {
+        nextTraceFrame();
+        SISTA_TRACE_SCOPE("SessionServer::render");
+        order.clear();
+        for (auto& entry : sessions)
+            if (!entry.second->closing)
+                order.push_back(entry.second.get());
+        pool.run(order.size(), [&](std::size_t i) {
+            SISTA_TRACE_SCOPE("Session::frame");
+            Session& session = *order[i];
+            {
+                OutputRedirect redirect(session.sink->stream());
+                handler(session);
+            }
+            session.sink->present();
+            session.frames++;
+        });
+        submit();
+        for (Session* session : order) {
+            if (session->sink->hasFailed())
+                session->closing = true;
+            else
+                updateInterest(*session);
+        }
+        closeSessions();
+    }
+
+    void SessionServer::render(char border) {
+        render([border](Session& session) {
+            if (session.field == nullptr)
+                return;
+            clearScreen(session.frames == 0);
+            session.field->print(border);
+        });
+    }
+
+    std::size_t SessionServer::sessionCount() const {
+        return sessions.size();
+    }
+
+    Session* SessionServer::getSession(unsigned id) {
+        for (auto& entry : sessions)
+            if (entry.second->id == id)
+                return entry.second.get();
+        return nullptr;
+    }
+#endif
+};
@@ -0,0 +1,304 @@
+/** \file server.hpp
+ *  \brief Multi-session terminal server of the Sista library.
+ *
+ *  This header declares the WorkerPool, used to encode frames of many sessions in parallel,
+ *  and (on Linux) the SessionServer, which accepts terminal clients over Unix or TCP sockets
+ *  and renders one Field per connection without forking a process per client.
+ *
+ *  Each Session owns its output sink and its encoder state (the frame counter deciding whether
+ *  the next frame must clear the screen), so rendering a session only requires redirecting the
+ *  output stream of the worker thread to the session's sink. The sinks write with `writev`, or
+ *  submit through an io_uring shared by every session once SessionServer::enableAsyncOutput is called.
+ *
+ *  \see WorkerPool
+ *  \see Session
+ *  \see SessionServer
+ *  \see OutputRedirect
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <memory> // std::unique_ptr
+#include <unordered_map> // std::unordered_map
+#include <functional> // std::function
+#include <thread> // std::thread
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include <atomic> // std::atomic
+#include <exception> // std::exception_ptr
+#include "output.hpp"
+#include "field.hpp"
+
+#if defined(__linux__)
+/** \def SISTA_HAS_SESSION_SERVER
+ *  \brief Defined when the SessionServer is compiled in.
+ *
+ *  The SessionServer relies on `epoll`, so it is only available on Linux.
+*/
+#define SISTA_HAS_SESSION_SERVER 1
+#endif
+
+namespace sista {
+    /** \class WorkerPool
+     *  \brief A fixed pool of threads running parallel loops.
+     *
+     *  The calling thread takes part in every loop, so a pool with no threads runs
+     *  the loop sequentially and a pool with `n` threads uses `n + 1` cores.
+     *
+     *  \see SessionServer::render
+    */
+    class WorkerPool {
+    private:
+        std::vector<std::thread> threads; /** Background threads of the pool. */
+        std::mutex mutex; /** Guards the loop state below. */
+        std::condition_variable wake; /** Signals the threads that a loop started. */
+        std::condition_variable done; /** Signals the caller that every thread left the loop. */
+        const std::function<void(std::size_t)>* task; /** Body of the running loop. */
+        std::size_t count; /** Number of iterations of the running loop. */
+        std::atomic<std::size_t> next; /** Next iteration to run. */
+        unsigned busy; /** Threads still working on the running loop. */
+        unsigned long generation; /** Number of loops started so far. */
+        bool stopping; /** Whether the pool is being destroyed. */
+        std::exception_ptr error; /** First exception thrown by the running loop. */
+
+        void work();
+        void runIterations();
+
+    public:
+        /** \brief Constructor.
+         *  \param threads Number of background threads.
+        */
+        explicit WorkerPool(unsigned);
+        /** \brief Destructor, joins the background threads. */
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /** \brief Returns the number of background threads. */
+        unsigned size() const;
+        /** \brief Runs `task(i)` for every `i` in `[0, count)` and waits for completion.
+         *  \param count Number of iterations.
+         *  \param task Body of the loop, called concurrently from different threads.
+         *
+         *  \throws Rethrows the first exception thrown by `task`, after every iteration ended.
+        */
+        void run(std::size_t, const std::function<void(std::size_t)>&);
+    };
+
+#ifdef SISTA_HAS_SESSION_SERVER
+    class SessionServer;
+
+    /** \class Session
+     *  \brief A client connected to a SessionServer.
+     *
+     *  A Session owns the output sink of its connection and the state of its encoder.
+     *  Sessions are created and destroyed by the SessionServer, which hands them to the
+     *  callbacks by reference.
+     *
+     *  \see SessionServer
+    */
+    class Session {
+    private:
+        int descriptor; /** Socket of the connection. */
+        unsigned id; /** Identifier, unique within the server. */
+        std::unique_ptr<OutputSink> sink; /** Output sink writing to the socket. */
+        FileDescriptorSink* writer; /** The sink if it writes with `writev`, `nullptr` if it submits through io_uring. */
+        unsigned long frames; /** Frames rendered so far. */
+        bool closing; /** Whether the session will be closed by the server. */
+        bool writeInterest; /** Whether the server is waiting for the socket to become writable. */
+        Field* field; /** Field rendered by SessionServer::render(char), if any. */
+        void* userData; /** Pointer reserved to the application. */
+
+        Session(int, unsigned, std::unique_ptr<OutputSink>);
+
+        friend class SessionServer;
+
+    public:
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+        /** \brief Returns the identifier of the session. */
+        unsigned getId() const;
+        /** \brief Returns the socket of the session. */
+        int fileDescriptor() const;
+        /** \brief Returns the output sink of the session. */
+        OutputSink& getSink();
+        /** \brief Returns the number of frames rendered so far.
+         *
+         *  The first frame of a session (`getFrames() == 0`) is expected to clear the screen.
+        */
+        unsigned long getFrames() const;
+
+        /** \brief Sets the Field rendered by SessionServer::render(char).
+         *  \param field The Field to render, `nullptr` to render nothing.
+         *
+         *  \note The Field is not owned by the session and must outlive it or be detached.
+        */
+        void setField(Field*);
+        /** \brief Returns the Field rendered by SessionServer::render(char), `nullptr` if none. */
+        Field* getField() const;
+        /** \brief Stores a pointer reserved to the application. */
+        void setUserData(void*);
+        /** \brief Returns the pointer stored with setUserData, `nullptr` by default. */
+        void* getUserData() const;
+
+        /** \brief Asks the server to close the session once the current event or frame is handled. */
+        void close();
+        /** \brief Checks whether the session is going to be closed. */
+        bool isClosing() const;
+    };
+
+    /** \class SessionServer
+     *  \brief Serves many terminal clients over Unix or TCP sockets.
+     *
+     *  The server multiplexes listening and connected sockets with `epoll`. It is driven
+     *  by a single thread, which calls poll() to accept clients and read their input, and
+     *  render() to encode a frame for every session. Frames are encoded in parallel by a
+     *  WorkerPool: each worker redirects its output stream to the sink of the session it
+     *  renders, then presents the frame to the non-blocking socket. Bytes the socket could
+     *  not take are written by the following poll() calls.
+     *
+     *  With enableAsyncOutput, the frames of every session are instead submitted to an
+     *  io_uring with a single system call per render(), and poll() reaps their completions.
+     *
+     *  Callbacks are invoked on the thread calling poll(), except the render callback,
+     *  which is invoked on the workers.
+     *
+     *  \note `SIGPIPE` is ignored once a server is created, so that writing to a closed
+     *        connection closes the session instead of terminating the process.
+     *  \see Session
+     *  \see WorkerPool
+    */
+    class SessionServer {
+    public:
+        /** \brief Callback receiving a session. */
+        using Handler = std::function<void(Session&)>;
+        /** \brief Callback receiving a session and the bytes it sent. */
+        using InputHandler = std::function<void(Session&, const char*, std::size_t)>;
+
+    private:
+        /** \brief A listening socket. */
+        struct Listener {
+            int descriptor; /** The listening socket. */
+            std::string path; /** Path of the Unix socket, empty for TCP. */
+        };
+
+        int epollDescriptor; /** The epoll instance. */
+#ifdef SISTA_HAS_IO_URING
+        std::unique_ptr<UringContext> uring; /** Ring the sinks of the sessions submit through, if enabled. */
+#endif
+        std::vector<Listener> listeners; /** Listening sockets. */
+        std::unordered_map<int, std::unique_ptr<Session>> sessions; /** Sessions by socket. */
+        std::vector<Session*> order; /** Sessions being rendered, reused between frames. */
+        std::vector<char> inputBuffer; /** Buffer receiving the input of the sessions. */
+        unsigned nextId; /** Identifier of the next session. */
+        WorkerPool pool; /** Workers encoding the frames. */
+        Handler connectHandler; /** Called when a client connects. */
+        InputHandler inputHandler; /** Called when a client sends bytes. */
+        Handler disconnectHandler; /** Called before a session is destroyed. */
+
+        int addListener(int, const std::string&);
+        void accept(int);
+        void receive(Session&);
+        void updateInterest(Session&);
+        void closeSessions();
+        void submit();
+
+    public:
+        /** \brief Constructor.
+         *  \param workers Number of threads encoding frames, including the calling thread.
+         *
+         *  \throws `std::system_error` if the epoll instance cannot be created.
+        */
+        explicit SessionServer(unsigned=std::thread::hardware_concurrency());
+        /** \brief Destructor, closes every socket without calling the disconnect callback. */
+        ~SessionServer();
+
+        SessionServer(const SessionServer&) = delete;
+        SessionServer& operator=(const SessionServer&) = delete;
+
+        /** \brief Listens on a Unix domain socket.
+         *  \param path Path of the socket, replaced if a stale socket is found there.
+         *  \return The listening socket.
+         *
+         *  \throws `std::invalid_argument` if the path is too long.
+         *  \throws `std::system_error` if the socket cannot be bound.
+        */
+        int listenUnix(const std::string&);
+        /** \brief Listens on a TCP port.
+         *  \param port The port, `0` to let the system choose one.
+         *  \param address The IPv4 address to bind, loopback by default.
+         *  \return The port the server is listening on.
+         *
+         *  \throws `std::invalid_argument` if the address is not a valid IPv4 address.
+         *  \throws `std::system_error` if the socket cannot be bound.
+        */
+        unsigned short listenTCP(unsigned short, const std::string& ="127.0.0.1");
+
+        /** \brief Makes the sessions connecting from now on submit their frames through io_uring.
+         *  \param bufferCount Number of registered buffers shared by the sessions.
+         *  \param bufferSize Size of each buffer in bytes.
+         *  \return `true` if io_uring is used, `false` if the sessions keep writing with `writev`.
+         *
+         *  The sinks are created with makeAsyncSink, which falls back to `writev` when the
+         *  kernel refuses io_uring. Calling it again keeps the ring of the first call.
+         *
+         *  \see UringContext
+        */
+        bool enableAsyncOutput(unsigned=256, std::size_t=16384);
+        /** \brief Checks whether the sessions connecting from now on submit through io_uring. */
+        bool hasAsyncOutput() const;
+
+        /** \brief Sets the callback invoked when a client connects. */
+        void onConnect(Handler);
+        /** \brief Sets the callback invoked when a client sends bytes. */
+        void onInput(InputHandler);
+        /** \brief Sets the callback invoked before a session is closed. */
+        void onDisconnect(Handler);
+
+        /** \brief Waits for socket events and handles them.
+         *  \param timeout Maximum time to wait in milliseconds, `-1` to wait indefinitely.
+         *  \return The number of events handled.
+         *
+         *  Accepts new clients, reads their input, writes pending output and closes the
+         *  sessions whose peer hung up or that were closed with Session::close. Output
+         *  enqueued to the sinks outside render(), e.g. by a BroadcastChannel, is written
+         *  by the following calls as well.
+        */
+        std::size_t poll(int=0);
+        /** \brief Renders a frame for every session in parallel.
+         *  \param handler Callback printing the frame of a session.
+         *
+         *  The callback runs on a worker whose output stream is the sink of the session,
+         *  so any printing function of the library (Field::print, Cursor::goTo...) writes
+         *  to that session. The frame is presented when the callback returns.
+        */
+        void render(const Handler&);
+        /** \brief Renders the Field attached to every session.
+         *  \param border The border character.
+         *
+         *  The first frame of a session clears the screen, the following ones move the cursor
+         *  to the top-left corner before printing the Field with its border.
+         *
+         *  \see Session::setField
+         *  \see Field::print(char)
+        */
+        void render(char);
+
+        /** \brief Returns the number of connected sessions. */
+        std::size_t sessionCount() const;
+        /** \brief Finds a session by identifier.
+         *  \param id The identifier of the session.
+         *  \return A pointer to the session, `nullptr` if it is not connected.
+        */
+        Session* getSession(unsigned);
+    };
+#endif
+};
@@ -15,7 +15,22 @@
 
 #include "ansi.hpp"
 #include "border.hpp"
+#include "broadcast.hpp"
 #include "coordinates.hpp"
 #include "cursor.hpp"
+#include "effect.hpp"
 #include "field.hpp"
+#include "fieldofview.hpp"
+#include "flowfield.hpp"
+#include "grid.hpp"
+#include "output.hpp"
+#include "overlay.hpp"
+#include "pathfinder.hpp"
 #include "pawn.hpp"
+#include "regions.hpp"
+#include "server.hpp"
+#include "staticfield.hpp"
+#include "stats.hpp"
+#include "terminal.hpp"
+#include "trace.hpp"
+#include "viewport.hpp"
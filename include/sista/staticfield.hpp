@@ -0,0 +1,244 @@
+/** \file staticfield.hpp
+ *  \brief StaticField class template header file.
+ *
+ *  This file contains the StaticField class template, a Field whose dimensions are known at
+ *  compile time. Its cells are a `std::array` inside the object, and bounds checks, indexing and
+ *  the wrap-around of the movement effects are constant expressions of the dimensions: when they
+ *  are powers of two, wrapping compiles to a bitwise and instead of a signed modulo.
+ *
+ *  The template is header-only, as it is instantiated by the games with their own dimensions.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see StaticField
+ *  \see Field
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <array> // std::array
+#include <memory> // std::shared_ptr
+#include <stdexcept> // std::invalid_argument, std::out_of_range, std::range_error
+#include "field.hpp"
+#include "output.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+namespace sista {
+    /** \class StaticField
+     *  \brief A Field with compile-time dimensions and inline storage.
+     *
+     *  StaticField offers the core Field operations (adding, removing, moving and printing Pawns,
+     *  with the same exceptions and the same output) for boards like chess-like games and 80x24
+     *  dashboards. The cells are stored in the object, so large boards should be allocated
+     *  statically or with `std::make_unique` rather than on the stack.
+     *
+     *  \tparam W The width of the field (number of columns).
+     *  \tparam H The height of the field (number of rows).
+     *  \see Field
+     *  \see Effect
+    */
+    template <unsigned short W, unsigned short H>
+    class StaticField {
+        static_assert(W > 0 && H > 0, "StaticField dimensions must be positive");
+
+    public:
+        static constexpr unsigned short width = W; /** Width of the field (number of columns). */
+        static constexpr unsigned short height = H; /** Height of the field (number of rows). */
+
+        /** \brief Checks whether a position is outside of the field, with one comparison per axis.
+         *  \param y The row, negative values are out of bounds.
+         *  \param x The column, negative values are out of bounds.
+        */
+        static constexpr bool isOutOfBounds(int y, int x) {
+            return static_cast<unsigned int>(y) >= H || static_cast<unsigned int>(x) >= W;
+        }
+        /** \brief Wraps a column around the field, like the PACMAN effect.
+         *  \param x Any column, also negative or past the width.
+         *  \return The column in `[0, W)`, computed with a mask if W is a power of two.
+        */
+        static constexpr unsigned short wrapX(int x) {
+            if constexpr ((W & (W - 1)) == 0) {
+                return static_cast<unsigned short>(x & (W - 1));
+            } else {
+                int wrapped = x % W;
+                return static_cast<unsigned short>(wrapped < 0 ? wrapped + W : wrapped);
+            }
+        }
+        /** \brief Wraps a row around the field, like the PACMAN effect.
+         *  \param y Any row, also negative or past the height.
+         *  \return The row in `[0, H)`, computed with a mask if H is a power of two.
+        */
+        static constexpr unsigned short wrapY(int y) {
+            if constexpr ((H & (H - 1)) == 0) {
+                return static_cast<unsigned short>(y & (H - 1));
+            } else {
+                int wrapped = y % H;
+                return static_cast<unsigned short>(wrapped < 0 ? wrapped + H : wrapped);
+            }
+        }
+        /** \brief Returns the index of a cell in the row-major storage. */
+        static constexpr std::size_t index(unsigned short y, unsigned short x) {
+            return static_cast<std::size_t>(y) * W + x;
+        }
+
+    private:
+        std::array<std::shared_ptr<Pawn>, static_cast<std::size_t>(W) * H> pawns; /** The cells, row by row. */
+        Cursor cursor; /** Cursor object for terminal operations. */
+
+        void cleanCoordinates(const Coordinates& coordinates) const {
+            cursor.goTo(coordinates);
+            resetAnsi(); // Reset the settings for that cell
+            getOutputStream() << ' '; // Print a space to clear the cell
+            addStat(Stat::CELLS_REDRAWN);
+        }
+        /** \brief Applies an effect to a position, throwing `Error` when the effect can't bring it back. */
+        template <typename Error>
+        static Coordinates applyEffect(int y, int x, Effect effect) {
+            if (effect == Effect::PACMAN) // Masked when the dimensions are powers of two
+                return Coordinates(wrapY(y), wrapX(x));
+            if (!sista::applyEffect(effect, y, x, H, W))
+                throw Error("Invalid Coordinates, the movement is not possible");
+            return Coordinates(static_cast<unsigned short>(y), static_cast<unsigned short>(x));
+        }
+
+    public:
+        /** \brief Constructor of an empty field. */
+        StaticField() = default;
+
+        StaticField(const StaticField&) = delete;
+        StaticField& operator=(const StaticField&) = delete;
+
+        /** \brief Removes all Pawns from the field. */
+        void clear() {
+            for (std::shared_ptr<Pawn>& pawn : pawns)
+                pawn.reset();
+        }
+
+        /** \brief Returns the Pawn at the coordinates, `nullptr` if the cell is empty or out of bounds. */
+        Pawn* getPawn(const Coordinates& coordinates) const {
+            return getPawn(coordinates.y, coordinates.x);
+        }
+        /** \brief Returns the Pawn at (y, x), `nullptr` if the cell is empty or out of bounds. */
+        Pawn* getPawn(unsigned short y, unsigned short x) const {
+            return isOutOfBounds(y, x) ? nullptr : pawns[index(y, x)].get();
+        }
+        /** \brief Checks whether a cell holds a Pawn. */
+        bool isOccupied(const Coordinates& coordinates) const {
+            return getPawn(coordinates) != nullptr;
+        }
+        /** \brief Checks whether a cell is inside the field and empty. */
+        bool isFree(const Coordinates& coordinates) const {
+            return !isOutOfBounds(coordinates.y, coordinates.x) && pawns[index(coordinates.y, coordinates.x)] == nullptr;
+        }
+
+        /** \brief Adds a Pawn at its coordinates.
+         *  \throws `std::invalid_argument` if the pawn is null or the cell is occupied.
+         *  \throws `std::out_of_range` if the coordinates are out of bounds.
+        */
+        void addPawn(std::shared_ptr<Pawn> pawn) {
+            if (pawn == nullptr)
+                throw std::invalid_argument("Cannot add pawn: pawn is null");
+            Coordinates coordinates = pawn->getCoordinates();
+            if (isOutOfBounds(coordinates.y, coordinates.x))
+                throw std::out_of_range("Cannot add pawn: coordinates are out of bounds");
+            std::shared_ptr<Pawn>& cell = pawns[index(coordinates.y, coordinates.x)];
+            if (cell != nullptr)
+                throw std::invalid_argument("Cannot add pawn: coordinates are already occupied");
+            cell = std::move(pawn);
+        }
+        /** \brief Adds a Pawn at its coordinates and prints it. */
+        void addPrintPawn(std::shared_ptr<Pawn> pawn) {
+            Pawn* added = pawn.get();
+            addPawn(std::move(pawn));
+            rePrintPawn(added);
+        }
+        /** \brief Removes a Pawn from the field, without clearing it on screen. */
+        void removePawn(Pawn* pawn) {
+            if (pawn != nullptr)
+                removePawn(pawn->getCoordinates());
+        }
+        /** \brief Removes the Pawn at the coordinates, without clearing it on screen. */
+        void removePawn(const Coordinates& coordinates) {
+            if (!isOutOfBounds(coordinates.y, coordinates.x))
+                pawns[index(coordinates.y, coordinates.x)].reset();
+        }
+        /** \brief Removes a Pawn from the field and clears its cell on screen. */
+        void erasePawn(Pawn* pawn) {
+            removePawn(pawn);
+            cleanCoordinates(pawn->getCoordinates());
+        }
+
+        /** \brief Prints a Pawn at its coordinates. */
+        void rePrintPawn(Pawn* pawn) {
+            cursor.goTo(pawn->getCoordinates());
+            pawn->print();
+            addStat(Stat::CELLS_REDRAWN);
+        }
+
+        /** \brief Moves a Pawn, updating only its old and new cells on screen.
+         *  \throws `std::invalid_argument` if the destination is occupied by another Pawn.
+         *  \throws `std::out_of_range` if the destination is out of bounds.
+        */
+        void movePawn(Pawn* pawn, const Coordinates& coordinates) {
+            if (isOutOfBounds(coordinates.y, coordinates.x))
+                throw std::out_of_range("Coordinates are out of bounds");
+            Coordinates from = pawn->getCoordinates();
+            if (from == coordinates)
+                return;
+            std::shared_ptr<Pawn>& destination = pawns[index(coordinates.y, coordinates.x)];
+            if (destination != nullptr)
+                throw std::invalid_argument("The coordinates are occupied by another pawn or out of bounds.");
+            cleanCoordinates(from); // Clean the old coordinates
+            cursor.goTo(coordinates);
+            pawn->print(); // Print the pawn
+            addStat(Stat::CELLS_REDRAWN);
+            destination = std::move(pawns[index(from.y, from.x)]); // Moving Pawn ownership away from the old cell
+            pawn->setCoordinates(coordinates);
+        }
+        /** \brief Moves a Pawn by an offset, applying an effect when it leaves the field.
+         *  \throws `std::out_of_range` if the MATRIX effect leaves the field.
+         *  \throws `std::invalid_argument` if the destination is occupied by another Pawn.
+        */
+        void movePawnBy(Pawn* pawn, short int dy, short int dx, Effect effect) {
+            Coordinates from = pawn->getCoordinates();
+            movePawn(pawn, applyEffect<std::out_of_range>(from.y + dy, from.x + dx, effect));
+        }
+        /** \brief Calculates the destination of a move by an offset, without applying it.
+         *  \throws `std::range_error` if the MATRIX effect leaves the field.
+        */
+        Coordinates movingByCoordinates(Pawn* pawn, short int dy, short int dx, Effect effect) const {
+            Coordinates from = pawn->getCoordinates();
+            return applyEffect<std::range_error>(from.y + dy, from.x + dx, effect);
+        }
+
+        /** \brief Prints the whole field, row by row, as Field::print does. */
+        void print() const {
+            SISTA_TRACE_SCOPE("StaticField::print");
+            StatTimer timer(Stat::ENCODE_NANOSECONDS);
+            addStat(Stat::CELLS_REDRAWN, static_cast<std::uint64_t>(W) * H);
+            std::ostream& out = getOutputStream();
+            resetAnsi(); // Reset the settings
+            bool previousPawn = false; // If the previous element was a Pawn
+            for (unsigned short y = 0; y < H; y++) { // For each row
+                for (unsigned short x = 0; x < W; x++) { // For each pawn
+                    const std::shared_ptr<Pawn>& pawn = pawns[index(y, x)];
+                    if (pawn != nullptr) { // If the pawn is not nullptr
+                        pawn->print(); // Print the pawn
+                        previousPawn = true; // Set the previousPawn to true
+                    } else { // If the pawn is nullptr
+                        if (previousPawn) { // If the previous element was a Pawn
+                            resetAnsi(); // Reset the settings
+                            previousPawn = false; // Set the previousPawn to false
+                        }
+                        out << ' ';
+                    }
+                }
+                out << '\n';
+            }
+            resetAnsi(); // Reset the settings
+            out << std::flush; // Flush the output
+        }
+    };
+};
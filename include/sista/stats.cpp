@@ -0,0 +1,120 @@
+/** \file stats.cpp
+ *  \brief Implementation of the runtime render statistics of the Sista library.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see RenderStats
+ *  \copyright GNU General Public License v3.0
+ */
+#include "stats.hpp"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace sista {
+    static constexpr std::size_t STATS = static_cast<std::size_t>(Stat::COUNT);
+
+    /** \brief The counters of one thread, on their own cache lines so that threads never share one.
+     *
+     *  Only the owning thread writes them, with a relaxed load and store rather than a locked
+     *  read-modify-write; the atomics only let getStats read them while the thread runs.
+    */
+    struct alignas(64) CounterBlock {
+        std::atomic<std::uint64_t> values[STATS] = {};
+    };
+
+    /** \brief The blocks of the running threads, and the totals of the threads that exited. */
+    struct CounterRegistry {
+        std::mutex mutex;
+        std::vector<CounterBlock*> blocks;
+        std::uint64_t retired[STATS] = {};
+    };
+    static CounterRegistry& registry() {
+        static CounterRegistry* instance = new CounterRegistry(); // Never destroyed, threads may exit after main
+        return *instance;
+    }
+
+    /** \brief Registers the block of a thread on its first update, and folds it into the totals when the thread exits. */
+    struct LocalCounters {
+        CounterBlock block;
+
+        LocalCounters() {
+            CounterRegistry& counters = registry();
+            std::lock_guard<std::mutex> lock(counters.mutex);
+            counters.blocks.push_back(&block);
+        }
+        ~LocalCounters();
+    };
+    static thread_local CounterBlock* localBlock = nullptr; // nullptr until the first update of the thread
+
+    LocalCounters::~LocalCounters() {
+        CounterRegistry& counters = registry();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        for (std::size_t i = 0; i < STATS; i++)
+            counters.retired[i] += block.values[i].load(std::memory_order_relaxed);
+        counters.blocks.erase(std::remove(counters.blocks.begin(), counters.blocks.end(), &block), counters.blocks.end());
+        localBlock = nullptr;
+    }
+    static CounterBlock* registerThread() {
+        static thread_local LocalCounters local;
+        localBlock = &local.block;
+        return localBlock;
+    }
+
+    RenderStats getStats() {
+        std::uint64_t totals[STATS];
+        {
+            CounterRegistry& counters = registry();
+            std::lock_guard<std::mutex> lock(counters.mutex);
+            for (std::size_t i = 0; i < STATS; i++) {
+                totals[i] = counters.retired[i];
+                for (const CounterBlock* block : counters.blocks)
+                    totals[i] += block->values[i].load(std::memory_order_relaxed);
+            }
+        }
+        auto read = [&](Stat stat) {
+            return totals[static_cast<std::size_t>(stat)];
+        };
+        RenderStats stats;
+        stats.framesPresented = read(Stat::FRAMES_PRESENTED);
+        stats.bytesEmitted = read(Stat::BYTES_EMITTED);
+        stats.styleSequences = read(Stat::STYLE_SEQUENCES);
+        stats.cursorSequences = read(Stat::CURSOR_SEQUENCES);
+        stats.eraseSequences = read(Stat::ERASE_SEQUENCES);
+        stats.modeSequences = read(Stat::MODE_SEQUENCES);
+        stats.cursorJumps = read(Stat::CURSOR_JUMPS);
+        stats.cellsRedrawn = read(Stat::CELLS_REDRAWN);
+        stats.swapsAccepted = read(Stat::SWAPS_ACCEPTED);
+        stats.swapsRejected = read(Stat::SWAPS_REJECTED);
+        stats.encodeNanoseconds = read(Stat::ENCODE_NANOSECONDS);
+        stats.writeNanoseconds = read(Stat::WRITE_NANOSECONDS);
+        return stats;
+    }
+    void resetStats() {
+        CounterRegistry& counters = registry();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        for (std::size_t i = 0; i < STATS; i++) {
+            counters.retired[i] = 0;
+            for (CounterBlock* block : counters.blocks)
+                block->values[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    void addStat(Stat stat, std::uint64_t amount) {
+        CounterBlock* block = localBlock;
+        if (block == nullptr)
+            block = registerThread();
+        std::atomic<std::uint64_t>& value = block->values[static_cast<std::size_t>(stat)];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); // Only this thread writes it
+    }
+
+    StatTimer::StatTimer(Stat stat_): stat(stat_), start(std::chrono::steady_clock::now()) {}
+    StatTimer::~StatTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        addStat(stat, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+        ));
+    }
+};
@@ -0,0 +1,106 @@
+/** \file stats.hpp
+ *  \brief Runtime render statistics of the Sista library.
+ *
+ *  This header declares the counters the library keeps while rendering: frames presented,
+ *  bytes emitted, escape sequences by kind, cursor jumps, cells redrawn, swaps accepted or
+ *  rejected by SwappableField, and the time spent encoding and writing frames.
+ *
+ *  The counters are always enabled and kept per thread, so the workers rendering sessions in
+ *  parallel never share a cache line: updating one costs a plain increment, getStats sums the
+ *  counters of every thread, and the timers read a monotonic clock twice per frame.
+ *
+ *  \see RenderStats
+ *  \see getStats
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <cstdint> // std::uint64_t
+#include <chrono> // std::chrono::steady_clock
+
+namespace sista {
+    /** \struct RenderStats
+     *  \brief A snapshot of the render statistics.
+     *
+     *  \see getStats
+     *  \see resetStats
+    */
+    struct RenderStats {
+        std::uint64_t framesPresented; /** Frames presented or enqueued to an OutputSink. */
+        std::uint64_t bytesEmitted; /** Bytes handed to the operating system by the output sinks. */
+        std::uint64_t styleSequences; /** SGR sequences (colors and attributes). */
+        std::uint64_t cursorSequences; /** Cursor positioning and visibility sequences. */
+        std::uint64_t eraseSequences; /** Screen and line erasure sequences. */
+        std::uint64_t modeSequences; /** Screen mode sequences. */
+        std::uint64_t cursorJumps; /** Absolute cursor movements (Cursor::goTo). */
+        std::uint64_t cellsRedrawn; /** Field cells printed, by full prints or by incremental updates. */
+        std::uint64_t swapsAccepted; /** Moves applied by SwappableField::applySwaps and addPawnToSwap. */
+        std::uint64_t swapsRejected; /** Moves discarded by SwappableField::simulateSwaps because of conflicts. */
+        std::uint64_t encodeNanoseconds; /** Time spent in Field::print, including the flush ending it. */
+        std::uint64_t writeNanoseconds; /** Time spent in the system calls writing frames. */
+    };
+
+    /** \enum Stat
+     *  \brief Identifies a counter of RenderStats, used by the library to update it.
+    */
+    enum class Stat {
+        FRAMES_PRESENTED,
+        BYTES_EMITTED,
+        STYLE_SEQUENCES,
+        CURSOR_SEQUENCES,
+        ERASE_SEQUENCES,
+        MODE_SEQUENCES,
+        CURSOR_JUMPS,
+        CELLS_REDRAWN,
+        SWAPS_ACCEPTED,
+        SWAPS_REJECTED,
+        ENCODE_NANOSECONDS,
+        WRITE_NANOSECONDS,
+        COUNT /** Number of counters, not a counter. */
+    };
+
+    /** \brief Returns a snapshot of the render statistics of the process.
+     *
+     *  The counters of the running threads are summed with those of the threads that exited.
+     *  Each counter is read atomically, but the snapshot as a whole is not: counters
+     *  updated concurrently by other threads may be one frame apart.
+    */
+    RenderStats getStats();
+    /** \brief Sets every render statistic to zero.
+     *
+     *  An update made by another thread while the counters are reset may survive the reset.
+    */
+    void resetStats();
+    /** \brief Adds a value to a counter.
+     *  \param stat The counter.
+     *  \param amount The value to add.
+    */
+    void addStat(Stat, std::uint64_t=1);
+
+    /** \class StatTimer
+     *  \brief Adds the lifetime of the object, in nanoseconds, to a counter.
+     *
+     *  \see Stat::ENCODE_NANOSECONDS
+     *  \see Stat::WRITE_NANOSECONDS
+    */
+    class StatTimer {
+    private:
+        Stat stat; /** The counter receiving the elapsed time. */
+        std::chrono::steady_clock::time_point start; /** Construction time. */
+
+    public:
+        /** \brief Starts the timer.
+         *  \param stat The counter receiving the elapsed time.
+        */
+        explicit StatTimer(Stat);
+        /** \brief Stops the timer and adds the elapsed time to the counter. */
+        ~StatTimer();
+
+        StatTimer(const StatTimer&) = delete;
+        StatTimer& operator=(const StatTimer&) = delete;
+    };
+};
@@ -0,0 +1,512 @@
+/** \file terminal.cpp
+ *  \brief Implementation of the VirtualTerminal class.
+ *
+ *  The parser is a reduced version of the state machine of the DEC VT500 family:
+ *  bytes are consumed one at a time, control sequence parameters are accumulated in
+ *  a fixed array and executed when the final byte arrives, so feeding a frame does
+ *  not allocate memory.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see VirtualTerminal
+ *  \see https://vt100.net/emu/dec_ansi_parser
+ *  \copyright GNU General Public License v3.0
+ */
+#include "terminal.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace sista {
+    Cell::Cell(): symbol(U' '), foreground(DEFAULT_COLOR), background(DEFAULT_COLOR), attributes(0) {}
+
+    bool Cell::operator==(const Cell& other) const {
+        return symbol == other.symbol && foreground == other.foreground
+            && background == other.background && attributes == other.attributes;
+    }
+    bool Cell::operator!=(const Cell& other) const {
+        return !(*this == other);
+    }
+
+    VirtualTerminal::VirtualTerminal(int rows_, int columns_): rows(rows_), columns(columns_), newlineMode(true), bytes(0), sequences(0), outputStream(this) {
+        if (rows <= 0 || columns <= 0)
+            throw std::invalid_argument("VirtualTerminal size must be positive");
+        reset();
+    }
+
+    std::ostream& VirtualTerminal::stream() {
+        return outputStream;
+    }
+
+    void VirtualTerminal::reset() {
+        cells.assign(static_cast<std::size_t>(rows) * columns, Cell());
+        cursorRow = cursorColumn = 0;
+        pendingWrap = false;
+        cursorVisible = true;
+        pen = Cell();
+        lastSymbol = 0;
+        savedRow = savedColumn = 0;
+        savedPen = Cell();
+        scrollTop = 0;
+        scrollBottom = rows - 1;
+        state = State::GROUND;
+        parameterCount = 0;
+        privateMarker = 0;
+        escapeInString = false;
+        codePoint = 0;
+        continuationBytes = 0;
+    }
+    void VirtualTerminal::setNewlineMode(bool newlineMode_) {
+        newlineMode = newlineMode_;
+    }
+
+    VirtualTerminal::int_type VirtualTerminal::overflow(int_type c) {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            consume(static_cast<unsigned char>(traits_type::to_char_type(c)));
+        return traits_type::not_eof(c);
+    }
+    std::streamsize VirtualTerminal::xsputn(const char* s, std::streamsize n) {
+        feed(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+    void VirtualTerminal::feed(const char* data, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++)
+            consume(static_cast<unsigned char>(data[i]));
+    }
+    void VirtualTerminal::feed(const std::string& data) {
+        feed(data.data(), data.size());
+    }
+
+    Cell VirtualTerminal::blank() const {
+        Cell cell; // Erased cells take the current background (BCE), like xterm
+        cell.background = pen.background;
+        return cell;
+    }
+
+    void VirtualTerminal::erase(int row, int from, int to) {
+        std::fill(cells.begin() + row * columns + from, cells.begin() + row * columns + to, blank());
+    }
+
+    void VirtualTerminal::scrollUp(int count) { // Only the rows of the scroll region move
+        auto top = cells.begin() + scrollTop * columns;
+        auto bottom = cells.begin() + (scrollBottom + 1) * columns;
+        count = std::min(count, scrollBottom - scrollTop + 1);
+        std::copy(top + count * columns, bottom, top);
+        std::fill(bottom - count * columns, bottom, blank());
+    }
+    void VirtualTerminal::scrollDown(int count) {
+        auto top = cells.begin() + scrollTop * columns;
+        auto bottom = cells.begin() + (scrollBottom + 1) * columns;
+        count = std::min(count, scrollBottom - scrollTop + 1);
+        std::copy_backward(top, bottom - count * columns, bottom);
+        std::fill(top, top + count * columns, blank());
+    }
+
+    void VirtualTerminal::lineFeed() {
+        if (cursorRow == scrollBottom)
+            scrollUp(1);
+        else if (cursorRow < rows - 1)
+            cursorRow++;
+        if (newlineMode)
+            cursorColumn = 0;
+        pendingWrap = false;
+    }
+
+    void VirtualTerminal::print(char32_t symbol) {
+        if (pendingWrap) { // The previous character filled the last column
+            bool newline = newlineMode;
+            newlineMode = true;
+            lineFeed();
+            newlineMode = newline;
+        }
+        Cell& cell = cells[cursorRow * columns + cursorColumn];
+        cell = pen;
+        cell.symbol = symbol;
+        lastSymbol = symbol;
+        if (cursorColumn == columns - 1)
+            pendingWrap = true;
+        else
+            cursorColumn++;
+    }
+
+    void VirtualTerminal::consume(unsigned char byte) {
+        bytes++;
+        switch (state) {
+        case State::GROUND:
+            if (continuationBytes > 0) {
+                if ((byte & 0xC0) == 0x80) {
+                    codePoint = (codePoint << 6) | (byte & 0x3F);
+                    if (--continuationBytes == 0)
+                        print(codePoint);
+                    return;
+                }
+                continuationBytes = 0; // Truncated sequence
+                print(U'\uFFFD');
+            }
+            if (byte == 0x1B) {
+                state = State::ESCAPE;
+            } else if (byte < 0x20 || byte == 0x7F) {
+                switch (byte) {
+                case '\n': case '\v': case '\f':
+                    lineFeed();
+                    break;
+                case '\r':
+                    cursorColumn = 0;
+                    pendingWrap = false;
+                    break;
+                case '\b':
+                    if (cursorColumn > 0)
+                        cursorColumn--;
+                    pendingWrap = false;
+                    break;
+                case '\t':
+                    cursorColumn = std::min(columns - 1, (cursorColumn / 8 + 1) * 8);
+                    break;
+                default: // BEL, NUL and DEL have no effect on the screen
+                    break;
+                }
+            } else if (byte < 0x80) {
+                print(byte);
+            } else if ((byte & 0xE0) == 0xC0) {
+                codePoint = byte & 0x1F;
+                continuationBytes = 1;
+            } else if ((byte & 0xF0) == 0xE0) {
+                codePoint = byte & 0x0F;
+                continuationBytes = 2;
+            } else if ((byte & 0xF8) == 0xF0) {
+                codePoint = byte & 0x07;
+                continuationBytes = 3;
+            } else {
+                print(U'\uFFFD');
+            }
+            return;
+        case State::ESCAPE:
+            if (byte >= 0x20 && byte <= 0x2F) // Intermediate bytes, e.g. charset designation
+                return;
+            state = State::GROUND;
+            switch (byte) {
+            case '[':
+                state = State::CONTROL_SEQUENCE;
+                parameters[0] = -1;
+                parameterCount = 1;
+                privateMarker = 0;
+                return;
+            case ']': case 'P': case 'X': case '^': case '_':
+                state = State::STRING;
+                escapeInString = false;
+                return;
+            case '7': // DECSC
+                savedRow = cursorRow;
+                savedColumn = cursorColumn;
+                savedPen = pen;
+                break;
+            case '8': // DECRC
+                cursorRow = savedRow;
+                cursorColumn = savedColumn;
+                pen = savedPen;
+                pendingWrap = false;
+                break;
+            case 'c': // RIS
+                reset();
+                break;
+            case 'D': // IND
+                if (cursorRow == scrollBottom)
+                    scrollUp(1);
+                else if (cursorRow < rows - 1)
+                    cursorRow++;
+                break;
+            case 'E': // NEL
+                lineFeed();
+                cursorColumn = 0;
+                break;
+            case 'M': // RI
+                if (cursorRow == scrollTop)
+                    scrollDown(1);
+                else if (cursorRow > 0)
+                    cursorRow--;
+                break;
+            default:
+                break;
+            }
+            sequences++;
+            return;
+        case State::CONTROL_SEQUENCE:
+            if (byte >= '0' && byte <= '9') {
+                int& value = parameters[parameterCount - 1];
+                value = std::min(65535, (value < 0 ? 0 : value) * 10 + (byte - '0'));
+            } else if (byte == ';' || byte == ':') {
+                if (parameterCount < 16)
+                    parameters[parameterCount++] = -1;
+            } else if (byte >= '<' && byte <= '?') {
+                privateMarker = static_cast<char>(byte);
+            } else if (byte >= 0x40 && byte <= 0x7E) {
+                state = State::GROUND;
+                executeControlSequence(static_cast<char>(byte));
+            } else if (byte == 0x1B) {
+                state = State::ESCAPE; // Sequence aborted
+            }
+            return; // Intermediate bytes and C0 controls are ignored
+        case State::STRING:
+            if (byte == 0x07 || (escapeInString && byte == '\\'))
+                state = State::GROUND;
+            escapeInString = (byte == 0x1B);
+            return;
+        }
+    }
+
+    int VirtualTerminal::parameter(int index, int fallback) const {
+        if (index >= parameterCount || parameters[index] < 0)
+            return fallback;
+        return parameters[index];
+    }
+
+    void VirtualTerminal::executeControlSequence(char final) {
+        sequences++;
+        if (privateMarker == '?') {
+            if ((final == 'h' || final == 'l') && parameter(0, 0) == 25)
+                cursorVisible = (final == 'h');
+            return;
+        }
+        if (privateMarker != 0) // Screen modes and other private sequences don't change the cells
+            return;
+        int count = std::max(1, parameter(0, 1));
+        switch (final) {
+        case 'H': case 'f': // CUP, HVP
+            cursorRow = std::min(rows, std::max(1, parameter(0, 1))) - 1;
+            cursorColumn = std::min(columns, std::max(1, parameter(1, 1))) - 1;
+            break;
+        case 'A': // CUU
+            cursorRow = std::max(0, cursorRow - count);
+            break;
+        case 'B': // CUD
+            cursorRow = std::min(rows - 1, cursorRow + count);
+            break;
+        case 'C': // CUF
+            cursorColumn = std::min(columns - 1, cursorColumn + count);
+            break;
+        case 'D': // CUB
+            cursorColumn = std::max(0, cursorColumn - count);
+            break;
+        case 'E': // CNL
+            cursorRow = std::min(rows - 1, cursorRow + count);
+            cursorColumn = 0;
+            break;
+        case 'F': // CPL
+            cursorRow = std::max(0, cursorRow - count);
+            cursorColumn = 0;
+            break;
+        case 'G': case '`': // CHA, HPA
+            cursorColumn = std::min(columns, count) - 1;
+            break;
+        case 'd': // VPA
+            cursorRow = std::min(rows, count) - 1;
+            break;
+        case 'J': // ED
+            switch (parameter(0, 0)) {
+            case 0:
+                erase(cursorRow, cursorColumn, columns);
+                for (int row = cursorRow + 1; row < rows; row++)
+                    erase(row, 0, columns);
+                break;
+            case 1:
+                for (int row = 0; row < cursorRow; row++)
+                    erase(row, 0, columns);
+                erase(cursorRow, 0, cursorColumn + 1);
+                break;
+            case 2:
+                for (int row = 0; row < rows; row++)
+                    erase(row, 0, columns);
+                break;
+            default: // 3 only erases the scrollback buffer, which is not emulated
+                break;
+            }
+            break;
+        case 'K': // EL
+            switch (parameter(0, 0)) {
+            case 0:
+                erase(cursorRow, cursorColumn, columns);
+                break;
+            case 1:
+                erase(cursorRow, 0, cursorColumn + 1);
+                break;
+            case 2:
+                erase(cursorRow, 0, columns);
+                break;
+            default:
+                break;
+            }
+            break;
+        case 'X': // ECH
+            erase(cursorRow, cursorColumn, std::min(columns, cursorColumn + count));
+            break;
+        case '@': { // ICH
+            auto line = cells.begin() + cursorRow * columns;
+            count = std::min(count, columns - cursorColumn);
+            std::copy_backward(line + cursorColumn, line + columns - count, line + columns);
+            erase(cursorRow, cursorColumn, cursorColumn + count);
+            break;
+        }
+        case 'P': { // DCH
+            auto line = cells.begin() + cursorRow * columns;
+            count = std::min(count, columns - cursorColumn);
+            std::copy(line + cursorColumn + count, line + columns, line + cursorColumn);
+            erase(cursorRow, columns - count, columns);
+            break;
+        }
+        case 'S': // SU
+            scrollUp(count);
+            return;
+        case 'T': // SD
+            if (parameterCount > 1) // Mouse highlight tracking, not a scroll
+                return;
+            scrollDown(count);
+            return;
+        case 'r': { // DECSTBM
+            int top = std::max(1, parameter(0, 1));
+            int bottom = parameter(1, 0) > 0 ? std::min(rows, parameter(1, 0)) : rows;
+            if (top >= bottom) // Invalid margins are ignored
+                return;
+            scrollTop = top - 1;
+            scrollBottom = bottom - 1;
+            cursorRow = cursorColumn = 0;
+            break;
+        }
+        case 'b': // REP
+            if (lastSymbol != 0)
+                for (int i = 0; i < count; i++)
+                    print(lastSymbol);
+            return;
+        case 'm': // SGR
+            selectGraphicRendition();
+            return;
+        case 's': // SCOSC
+            savedRow = cursorRow;
+            savedColumn = cursorColumn;
+            return;
+        case 'u': // SCORC
+            cursorRow = savedRow;
+            cursorColumn = savedColumn;
+            break;
+        default:
+            return;
+        }
+        pendingWrap = false;
+    }
+
+    void VirtualTerminal::selectGraphicRendition() {
+        for (int i = 0; i < parameterCount; i++) {
+            int code = parameter(i, 0);
+            if (code == 0) {
+                pen.foreground = pen.background = Cell::DEFAULT_COLOR;
+                pen.attributes = 0;
+            } else if (code >= 1 && code <= 9) {
+                pen.attributes |= 1 << code;
+            } else if (code == 21) { // Sista's resetAttribute(Attribute::BRIGHT)
+                pen.attributes &= ~(1 << 1);
+            } else if (code == 22) {
+                pen.attributes &= ~((1 << 1) | (1 << 2));
+            } else if (code == 25) {
+                pen.attributes &= ~((1 << 5) | (1 << 6));
+            } else if (code >= 23 && code <= 29) {
+                pen.attributes &= ~(1 << (code - 20));
+            } else if (code >= 30 && code <= 37) {
+                pen.foreground = Cell::INDEXED | (code - 30);
+            } else if (code >= 40 && code <= 47) {
+                pen.background = Cell::INDEXED | (code - 40);
+            } else if (code >= 90 && code <= 97) {
+                pen.foreground = Cell::INDEXED | (code - 90 + 8);
+            } else if (code >= 100 && code <= 107) {
+                pen.background = Cell::INDEXED | (code - 100 + 8);
+            } else if (code == 39) {
+                pen.foreground = Cell::DEFAULT_COLOR;
+            } else if (code == 49) {
+                pen.background = Cell::DEFAULT_COLOR;
+            } else if (code == 38 || code == 48) {
+                std::uint32_t& color = (code == 38) ? pen.foreground : pen.background;
+                if (parameter(i + 1, 0) == 5) {
+                    color = Cell::INDEXED | (parameter(i + 2, 0) & 0xFF);
+                    i += 2;
+                } else if (parameter(i + 1, 0) == 2) {
+                    color = Cell::TRUE_COLOR | ((parameter(i + 2, 0) & 0xFF) << 16)
+                        | ((parameter(i + 3, 0) & 0xFF) << 8) | (parameter(i + 4, 0) & 0xFF);
+                    i += 4;
+                }
+            }
+        }
+    }
+
+    int VirtualTerminal::getRows() const {
+        return rows;
+    }
+    int VirtualTerminal::getColumns() const {
+        return columns;
+    }
+    const Cell& VirtualTerminal::at(int row, int column) const {
+        if (row < 0 || row >= rows || column < 0 || column >= columns)
+            throw std::out_of_range("Cell is outside the VirtualTerminal");
+        return cells[row * columns + column];
+    }
+    int VirtualTerminal::getCursorRow() const {
+        return cursorRow;
+    }
+    int VirtualTerminal::getCursorColumn() const {
+        return cursorColumn;
+    }
+    bool VirtualTerminal::isCursorVisible() const {
+        return cursorVisible;
+    }
+
+    std::string VirtualTerminal::line(int row) const {
+        std::string result;
+        int end = columns;
+        while (end > 0 && at(row, end - 1).symbol == U' ')
+            end--;
+        for (int column = 0; column < end; column++) {
+            char32_t symbol = at(row, column).symbol;
+            if (symbol < 0x80) {
+                result += static_cast<char>(symbol);
+            } else if (symbol < 0x800) {
+                result += static_cast<char>(0xC0 | (symbol >> 6));
+                result += static_cast<char>(0x80 | (symbol & 0x3F));
+            } else if (symbol < 0x10000) {
+                result += static_cast<char>(0xE0 | (symbol >> 12));
+                result += static_cast<char>(0x80 | ((symbol >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (symbol & 0x3F));
+            } else {
+                result += static_cast<char>(0xF0 | (symbol >> 18));
+                result += static_cast<char>(0x80 | ((symbol >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((symbol >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (symbol & 0x3F));
+            }
+        }
+        return result;
+    }
+    std::string VirtualTerminal::text() const {
+        std::string result;
+        for (int row = 0; row < rows; row++) {
+            result += line(row);
+            result += '\n';
+        }
+        return result;
+    }
+
+    std::size_t VirtualTerminal::countDifferences(const VirtualTerminal& other) const {
+        if (rows != other.rows || columns != other.columns)
+            return std::max(cells.size(), other.cells.size());
+        std::size_t differences = 0;
+        for (std::size_t i = 0; i < cells.size(); i++)
+            differences += (cells[i] != other.cells[i]);
+        return differences;
+    }
+    bool VirtualTerminal::sameScreen(const VirtualTerminal& other) const {
+        return rows == other.rows && columns == other.columns && cells == other.cells;
+    }
+
+    std::size_t VirtualTerminal::bytesConsumed() const {
+        return bytes;
+    }
+    std::size_t VirtualTerminal::sequencesExecuted() const {
+        return sequences;
+    }
+};
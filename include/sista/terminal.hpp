@@ -0,0 +1,197 @@
+/** \file terminal.hpp
+ *  \brief Headless in-memory terminal emulator.
+ *
+ *  This header declares the VirtualTerminal class, a small VT/ANSI interpreter that
+ *  consumes the bytes emitted by Sista and keeps the resulting screen in a grid of cells.
+ *  It allows testing that two ways of drawing produce the same screen, and measuring the
+ *  bytes and the parsing cost of a frame, without a real terminal.
+ *
+ *  Supported control functions:
+ *  - C0 controls: LF, CR, BS, HT;
+ *  - CUP, HVP, CUU, CUD, CUF, CUB, CNL, CPL, CHA, VPA (cursor movement);
+ *  - ED, EL, ECH (erasure), ICH, DCH (insertion and deletion) and REP (repetition);
+ *  - DECSTBM (scroll margins), SU and SD (scrolling), IND and RI;
+ *  - SGR: attributes, 8/16 colors, 256-color palette and true colors;
+ *  - DECTCEM (cursor visibility), DECSC/DECRC and RIS.
+ *  Other sequences are parsed and ignored.
+ *
+ *  \see VirtualTerminal
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <streambuf> // std::streambuf
+#include <ostream> // std::ostream
+#include <string> // std::string
+#include <vector> // std::vector
+#include <cstdint> // std::uint32_t, std::uint16_t
+#include <cstddef> // std::size_t
+
+namespace sista {
+    /** \struct Cell
+     *  \brief A cell of the VirtualTerminal screen: a symbol and its style.
+     *
+     *  Colors are encoded in 32 bits: `Cell::DEFAULT_COLOR` for the default color,
+     *  `Cell::INDEXED | index` for palette colors (the 8 basic colors are 0-7, the
+     *  bright ones 8-15) and `Cell::TRUE_COLOR | 0xRRGGBB` for 24-bit colors.
+     *
+     *  \see VirtualTerminal
+    */
+    struct Cell {
+        static constexpr std::uint32_t DEFAULT_COLOR = 0; /** Color of a terminal that received no SGR. */
+        static constexpr std::uint32_t INDEXED = 0x01000000; /** Tag of palette colors. */
+        static constexpr std::uint32_t TRUE_COLOR = 0x02000000; /** Tag of 24-bit colors. */
+
+        char32_t symbol; /** Unicode code point displayed in the cell. */
+        std::uint32_t foreground; /** Foreground color. */
+        std::uint32_t background; /** Background color. */
+        std::uint16_t attributes; /** Bit `n` is set when `Attribute(n)` is active. */
+
+        /** \brief Default constructor, a blank cell with default colors. */
+        Cell();
+
+        /** \brief Compares symbol and style of two cells. */
+        bool operator==(const Cell&) const;
+        /** \brief Compares symbol and style of two cells. */
+        bool operator!=(const Cell&) const;
+    };
+
+    /** \class VirtualTerminal
+     *  \brief An in-memory terminal interpreting the escape sequences emitted by Sista.
+     *
+     *  The terminal is a `std::streambuf`: install its stream() with OutputRedirect to render
+     *  a Field into it, or call feed() with captured bytes. By default LF also returns the
+     *  carriage, as a tty with `ONLCR` does for the `'\n'` printed by Field::print.
+     *
+     *  Rows and columns are 0-based in the API, while escape sequences use 1-based positions.
+     *
+     *  \see Cell
+     *  \see OutputRedirect
+    */
+    class VirtualTerminal : public std::streambuf {
+    private:
+        /** \brief States of the escape sequence parser. */
+        enum class State {
+            GROUND, /** Printing characters. */
+            ESCAPE, /** After ESC. */
+            CONTROL_SEQUENCE, /** Inside a control sequence. */
+            STRING /** Inside OSC, DCS and similar strings, ignored until ST or BEL. */
+        };
+
+        int rows; /** Number of rows of the screen. */
+        int columns; /** Number of columns of the screen. */
+        std::vector<Cell> cells; /** The screen, row by row. */
+        int cursorRow; /** Row of the cursor. */
+        int cursorColumn; /** Column of the cursor. */
+        bool pendingWrap; /** Whether the cursor is past the last column (deferred wrap). */
+        bool cursorVisible; /** Whether the cursor is visible (DECTCEM). */
+        bool newlineMode; /** Whether LF also performs CR. */
+        Cell pen; /** Style applied to printed characters. */
+        char32_t lastSymbol; /** Last printed character, repeated by REP. */
+        int savedRow; /** Row saved by DECSC. */
+        int savedColumn; /** Column saved by DECSC. */
+        Cell savedPen; /** Style saved by DECSC. */
+        int scrollTop; /** First row of the scroll region (DECSTBM). */
+        int scrollBottom; /** Last row of the scroll region (DECSTBM). */
+
+        State state; /** State of the parser. */
+        int parameters[16]; /** Parameters of the current control sequence. */
+        int parameterCount; /** Number of parameters of the current control sequence. */
+        char privateMarker; /** Private marker ('?', '=', '>' or '<') of the current control sequence. */
+        bool escapeInString; /** Whether an ESC was found inside a string (maybe ST). */
+        char32_t codePoint; /** UTF-8 code point being decoded. */
+        int continuationBytes; /** UTF-8 continuation bytes still expected. */
+
+        std::size_t bytes; /** Bytes consumed so far. */
+        std::size_t sequences; /** Control sequences executed so far. */
+
+        std::ostream outputStream; /** Stream writing into the terminal. */
+
+        void consume(unsigned char);
+        void print(char32_t);
+        void lineFeed();
+        void scrollUp(int);
+        void scrollDown(int);
+        void erase(int, int, int);
+        void executeControlSequence(char);
+        void selectGraphicRendition();
+        int parameter(int, int) const;
+        Cell blank() const;
+
+    protected:
+        int_type overflow(int_type) override;
+        std::streamsize xsputn(const char*, std::streamsize) override;
+
+    public:
+        /** \brief Constructor.
+         *  \param rows Number of rows of the screen.
+         *  \param columns Number of columns of the screen.
+         *
+         *  \throws `std::invalid_argument` if the size is not positive.
+        */
+        VirtualTerminal(int=24, int=80);
+
+        VirtualTerminal(const VirtualTerminal&) = delete;
+        VirtualTerminal& operator=(const VirtualTerminal&) = delete;
+
+        /** \brief Returns a stream writing into the terminal, to be used with OutputRedirect. */
+        std::ostream& stream();
+        /** \brief Interprets bytes as a terminal would.
+         *  \param data The bytes to interpret.
+         *  \param length The number of bytes.
+        */
+        void feed(const char*, std::size_t);
+        /** \brief Interprets bytes as a terminal would.
+         *  \param data The bytes to interpret.
+        */
+        void feed(const std::string&);
+        /** \brief Clears the screen and resets the cursor, the style and the parser (RIS).
+         *
+         *  The counters of bytes and sequences are not reset.
+        */
+        void reset();
+        /** \brief Sets whether LF also returns the carriage (`true` by default). */
+        void setNewlineMode(bool);
+
+        /** \brief Returns the number of rows. */
+        int getRows() const;
+        /** \brief Returns the number of columns. */
+        int getColumns() const;
+        /** \brief Returns the cell at the given position.
+         *  \param row The 0-based row.
+         *  \param column The 0-based column.
+         *
+         *  \throws `std::out_of_range` if the position is outside the screen.
+        */
+        const Cell& at(int, int) const;
+        /** \brief Returns the row of the cursor (0-based). */
+        int getCursorRow() const;
+        /** \brief Returns the column of the cursor (0-based). */
+        int getCursorColumn() const;
+        /** \brief Checks whether the cursor is visible. */
+        bool isCursorVisible() const;
+
+        /** \brief Returns the symbols of a row encoded in UTF-8, without trailing blanks.
+         *  \param row The 0-based row.
+        */
+        std::string line(int) const;
+        /** \brief Returns the symbols of the screen, one line per row, without trailing blanks. */
+        std::string text() const;
+        /** \brief Counts the cells that differ, in symbol or style, from another terminal.
+         *  \param other A terminal of the same size.
+         *  \return The number of different cells, or the cell count of the larger screen if sizes differ.
+        */
+        std::size_t countDifferences(const VirtualTerminal&) const;
+        /** \brief Checks whether two terminals display the same cells, ignoring the cursor. */
+        bool sameScreen(const VirtualTerminal&) const;
+
+        /** \brief Returns the number of bytes consumed so far. */
+        std::size_t bytesConsumed() const;
+        /** \brief Returns the number of control sequences executed so far. */
+        std::size_t sequencesExecuted() const;
+    };
+};
@@ -0,0 +1,121 @@
+/** \file trace.cpp
+ *  \brief Implementation of the Chrome-trace timeline export of the Sista library.
+ *
+ *  Each event is written as a complete event (`"ph": "X"`) with its start and duration in
+ *  microseconds, relative to startTrace, and the frame number in its arguments.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see TraceScope
+ *  \copyright GNU General Public License v3.0
+ */
+#include "trace.hpp"
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+namespace sista {
+    /** \brief A finished event waiting to be written. */
+    struct TraceEvent {
+        const char* name;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration duration;
+        std::uint64_t frame;
+    };
+
+    static std::mutex traceMutex; // Guards the file and the epoch
+    static std::ofstream traceFile;
+    static bool firstEvent = true;
+    static std::chrono::steady_clock::time_point epoch;
+    static std::atomic<bool> tracing(false);
+    static std::atomic<std::uint64_t> traceFrame(0);
+    static std::atomic<unsigned> nextThreadId(1);
+
+    /** \brief Events of the calling thread, written when its outermost scope ends. */
+    struct ThreadTrace {
+        std::vector<TraceEvent> events;
+        unsigned depth = 0;
+        unsigned id = nextThreadId.fetch_add(1);
+    };
+    static thread_local ThreadTrace threadTrace;
+
+    /** \brief Writes the events of the calling thread, the caller holds traceMutex. */
+    static void writeEvents(ThreadTrace& thread) {
+        if (traceFile.is_open()) {
+            for (const TraceEvent& event : thread.events) {
+                if (event.start < epoch)
+                    continue; // Started before this trace
+                traceFile << (firstEvent ? "\n" : ",\n")
+                          << "{\"name\":\"" << event.name << "\",\"cat\":\"sista\",\"ph\":\"X\""
+                          << ",\"ts\":" << std::chrono::duration<double, std::micro>(event.start - epoch).count()
+                          << ",\"dur\":" << std::chrono::duration<double, std::micro>(event.duration).count()
+                          << ",\"pid\":1,\"tid\":" << thread.id
+                          << ",\"args\":{\"frame\":" << event.frame << "}}";
+                firstEvent = false;
+            }
+        }
+        thread.events.clear();
+    }
+
+    bool isTraceCompiled() {
+#ifdef SISTA_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool startTrace(const std::string& path) {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        if (traceFile.is_open())
+            return false;
+        traceFile.open(path, std::ios::out | std::ios::trunc);
+        if (!traceFile.is_open())
+            return false;
+        traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        firstEvent = true;
+        epoch = std::chrono::steady_clock::now();
+        tracing = true;
+        return true;
+    }
+    void stopTrace() {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        if (!traceFile.is_open())
+            return;
+        tracing = false;
+        writeEvents(threadTrace);
+        traceFile << "\n]}\n";
+        traceFile.close();
+    }
+    bool isTracing() {
+        return tracing.load(std::memory_order_relaxed);
+    }
+    void setTraceFrame(std::uint64_t frame) {
+        traceFrame.store(frame, std::memory_order_relaxed);
+    }
+    std::uint64_t nextTraceFrame() {
+        return traceFrame.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    TraceScope::TraceScope(const char* name_): name(nullptr) {
+        if (!tracing.load(std::memory_order_relaxed))
+            return;
+        name = name_;
+        frame = traceFrame.load(std::memory_order_relaxed);
+        threadTrace.depth++;
+        start = std::chrono::steady_clock::now();
+    }
+    TraceScope::~TraceScope() {
+        if (name == nullptr)
+            return;
+        auto end = std::chrono::steady_clock::now();
+        ThreadTrace& thread = threadTrace;
+        thread.events.push_back(TraceEvent{name, start, end - start, frame});
+        if (--thread.depth == 0) {
+            std::lock_guard<std::mutex> lock(traceMutex);
+            writeEvents(thread);
+        }
+    }
+};
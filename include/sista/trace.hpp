@@ -0,0 +1,103 @@
+/** \file trace.hpp
+ *  \brief Chrome-trace timeline export of the Sista library.
+ *
+ *  When the library is compiled with `SISTA_TRACE` defined (`make TRACE=1`), its hot paths
+ *  (Field::print, SwappableField::simulateSwaps and applySwaps, the sink flushes and the
+ *  SessionServer frames) are wrapped in scoped trace points. Between startTrace and
+ *  stopTrace, every trace point writes a complete event of the Chrome Trace Event format,
+ *  carrying the thread and the current frame number, to a JSON file that can be opened
+ *  by `chrome://tracing` or by the Perfetto UI.
+ *
+ *  Without `SISTA_TRACE` the trace points compile to nothing. The functions of this header
+ *  are always available, so applications can record their own scopes with TraceScope.
+ *
+ *  \see startTrace
+ *  \see TraceScope
+ *  \see SISTA_TRACE_SCOPE
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include <string> // std::string
+#include <chrono> // std::chrono::steady_clock
+#include <cstdint> // std::uint64_t
+
+#ifdef SISTA_TRACE
+/** \def SISTA_TRACE_SCOPE
+ *  \brief Records the enclosing scope as a trace event named `name`.
+ *
+ *  Expands to a TraceScope when `SISTA_TRACE` is defined, to nothing otherwise.
+ *  \param name A string literal, it must outlive the trace.
+*/
+#define SISTA_TRACE_SCOPE(name) ::sista::TraceScope SISTA_TRACE_CONCAT(sistaTraceScope, __LINE__)(name)
+/** \def SISTA_TRACE_CONCAT
+ *  \brief Pastes two tokens after expanding them, used to name the scopes by line.
+*/
+#define SISTA_TRACE_CONCAT(a, b) SISTA_TRACE_CONCAT_EXPANDED(a, b)
+#define SISTA_TRACE_CONCAT_EXPANDED(a, b) a##b
+#else
+#define SISTA_TRACE_SCOPE(name)
+#endif
+
+namespace sista {
+    /** \brief Checks whether the library was compiled with its trace points.
+     *  \return `true` if the library was compiled with `SISTA_TRACE` defined.
+    */
+    bool isTraceCompiled();
+    /** \brief Starts writing trace events to a file.
+     *  \param path Path of the JSON file, truncated if it exists.
+     *  \return `false` if the file cannot be opened or a trace is already running.
+     *
+     *  \see stopTrace
+    */
+    bool startTrace(const std::string&);
+    /** \brief Writes the pending events and closes the trace file.
+     *
+     *  Events still buffered by other threads are written when their outermost scope ends,
+     *  so threads should be idle when the trace is stopped.
+    */
+    void stopTrace();
+    /** \brief Checks whether a trace is running. */
+    bool isTracing();
+    /** \brief Sets the frame number carried by the following events.
+     *  \param frame The frame number.
+     *
+     *  SessionServer::render advances the frame number by itself.
+     *  \see nextTraceFrame
+    */
+    void setTraceFrame(std::uint64_t);
+    /** \brief Advances the frame number carried by the following events.
+     *  \return The new frame number.
+    */
+    std::uint64_t nextTraceFrame();
+
+    /** \class TraceScope
+     *  \brief Records its lifetime as a trace event, if a trace is running.
+     *
+     *  Events are buffered per thread and written to the file when the outermost
+     *  scope of the thread ends, so nested scopes don't take the file lock.
+     *
+     *  \see SISTA_TRACE_SCOPE
+    */
+    class TraceScope {
+    private:
+        const char* name; /** Name of the event, `nullptr` if no trace was running. */
+        std::chrono::steady_clock::time_point start; /** Construction time. */
+        std::uint64_t frame; /** Frame number when the scope started. */
+
+    public:
+        /** \brief Starts the event.
+         *  \param name Name of the event, a string that must outlive the trace.
+        */
+        explicit TraceScope(const char*);
+        /** \brief Ends the event and buffers it. */
+        ~TraceScope();
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+    };
+};
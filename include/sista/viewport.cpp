@@ -0,0 +1,174 @@
+/** \file viewport.cpp
+ *  \brief Implementation of the Viewport class.
+ *
+ *  The Viewport draws its window row by row, jumping to the start of each row with
+ *  Cursor::goTo, and translates the incremental updates of its Field through toScreen.
+ *  With scroll acceleration, a pan shifts the content already on the screen with SU/SD
+ *  inside a DECSTBM region, or with ICH/DCH for each row, and draws only the exposed edge.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see Viewport
+ *  \copyright GNU General Public License v3.0
+ */
+#include "viewport.hpp"
+#include "field.hpp"
+#include "output.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include <algorithm> // std::min, std::max
+#include <cstdlib> // std::abs
+
+namespace sista {
+    Viewport::Viewport(Field& field_, unsigned short int width_, unsigned short int height_,
+                       unsigned short int row_, unsigned short int column_):
+        field(&field_), origin(0, 0), row(row_), column(column_), accelerated(false) {
+        width = static_cast<unsigned short int>(std::min<int>(width_, field->getWidth()));
+        height = static_cast<unsigned short int>(std::min<int>(height_, field->getHeight()));
+        field->setViewport(this);
+    }
+    Viewport::~Viewport() {
+        if (field->getViewport() == this) // Another viewport may have replaced this one
+            field->setViewport(nullptr);
+    }
+
+    Coordinates Viewport::clampOrigin(Coordinates origin_) const {
+        origin_.y = static_cast<unsigned short int>(std::min<int>(origin_.y, field->getHeight() - height));
+        origin_.x = static_cast<unsigned short int>(std::min<int>(origin_.x, field->getWidth() - width));
+        return origin_;
+    }
+
+    void Viewport::printCells(unsigned short int y, unsigned short int from, unsigned short int to) const {
+        addStat(Stat::CELLS_REDRAWN, to - from);
+        std::ostream& out = getOutputStream();
+        cursor.goTo(row + y, column + from);
+        bool previousPawn = false; // If the previous element was a Pawn
+        for (unsigned short int x = from; x < to; x++) { // For each cell of the span
+            Pawn* pawn = field->getPawn(Coordinates(origin.y + y, origin.x + x));
+            if (pawn != nullptr) { // If the pawn is not nullptr
+                pawn->print(); // Print the pawn
+                previousPawn = true; // Set the previousPawn to true
+            } else { // If the pawn is nullptr
+                if (previousPawn) { // If the previous element was a Pawn
+                    resetAnsi(); // Reset the settings
+                    previousPawn = false; // Set the previousPawn to false
+                }
+                out << ' ';
+            }
+        }
+        if (previousPawn) // The next span may start with an empty cell
+            resetAnsi();
+    }
+
+    void Viewport::print() const {
+        SISTA_TRACE_SCOPE("Viewport::print");
+        StatTimer timer(Stat::ENCODE_NANOSECONDS);
+        resetAnsi(); // Reset the settings
+        for (unsigned short int y = 0; y < height; y++) // For each row of the window
+            printCells(y, 0, width);
+        getOutputStream() << std::flush; // Flush the output
+    }
+
+    void Viewport::shift(int dy, int dx) const {
+        SISTA_TRACE_SCOPE("Viewport::shift");
+        StatTimer timer(Stat::ENCODE_NANOSECONDS);
+        resetAnsi(); // The blanks shifted in take the current background
+        if (dy != 0) {
+            cursor.setScrollRegion(row, row + height - 1);
+            cursor.scroll(dy > 0 ? ScrollScreen::UP : ScrollScreen::DOWN, static_cast<unsigned short int>(std::abs(dy)));
+            cursor.resetScrollRegion();
+        }
+        // The rows still showing their previous content, now at their new position
+        int keptFrom = dy < 0 ? -dy : 0;
+        int keptTo = dy > 0 ? height - dy : height;
+        if (dx != 0) {
+            for (int y = keptFrom; y < keptTo; y++) {
+                unsigned short int screenRow = static_cast<unsigned short int>(row + y);
+                // Deleting and inserting the same count leaves the cells right of the window in place
+                unsigned short int count = static_cast<unsigned short int>(std::abs(dx));
+                if (dx > 0) { // The content moves left, the right edge is exposed
+                    cursor.goTo(screenRow, column);
+                    cursor.editLine(EditLine::DELETE_CHARACTERS, count);
+                    cursor.goTo(screenRow, column + width - count);
+                    cursor.editLine(EditLine::INSERT_CHARACTERS, count);
+                    printCells(static_cast<unsigned short int>(y), width - count, width);
+                } else { // The content moves right, the left edge is exposed
+                    cursor.goTo(screenRow, column + width - count);
+                    cursor.editLine(EditLine::DELETE_CHARACTERS, count);
+                    cursor.goTo(screenRow, column);
+                    cursor.editLine(EditLine::INSERT_CHARACTERS, count);
+                    printCells(static_cast<unsigned short int>(y), 0, count);
+                }
+            }
+        }
+        for (int y = 0; y < height; y++) // The exposed rows
+            if (y < keptFrom || y >= keptTo)
+                printCells(static_cast<unsigned short int>(y), 0, width);
+        getOutputStream() << std::flush; // Flush the output
+    }
+
+    bool Viewport::scrollTo(const Coordinates& origin_) {
+        Coordinates target = clampOrigin(origin_);
+        if (target == origin)
+            return false;
+        int dy = target.y - origin.y;
+        int dx = target.x - origin.x;
+        origin = target;
+        if (accelerated && std::abs(dy) < height && std::abs(dx) < width)
+            shift(dy, dx);
+        else // Nothing on the screen can be reused
+            print();
+        return true;
+    }
+    bool Viewport::scrollBy(short int dy, short int dx) {
+        int y = std::max(0, origin.y + dy); // Clamped to the field by scrollTo
+        int x = std::max(0, origin.x + dx);
+        return scrollTo(Coordinates(static_cast<unsigned short int>(y), static_cast<unsigned short int>(x)));
+    }
+    bool Viewport::follow(const Coordinates& target, unsigned short int margin) {
+        // The margin can't exceed half of the window, or the target could never be inside it
+        int marginY = std::min<int>(margin, (height - 1) / 2);
+        int marginX = std::min<int>(margin, (width - 1) / 2);
+        int y = origin.y, x = origin.x;
+        if (target.y < y + marginY)
+            y = target.y - marginY;
+        else if (target.y > y + height - 1 - marginY)
+            y = target.y - (height - 1 - marginY);
+        if (target.x < x + marginX)
+            x = target.x - marginX;
+        else if (target.x > x + width - 1 - marginX)
+            x = target.x - (width - 1 - marginX);
+        return scrollTo(Coordinates(static_cast<unsigned short int>(std::max(0, y)),
+                                    static_cast<unsigned short int>(std::max(0, x))));
+    }
+
+    bool Viewport::isVisible(const Coordinates& coordinates) const {
+        return coordinates.y >= origin.y && coordinates.y < origin.y + height
+            && coordinates.x >= origin.x && coordinates.x < origin.x + width;
+    }
+    bool Viewport::toScreen(const Coordinates& coordinates, unsigned short int& row_, unsigned short int& column_) const {
+        if (!isVisible(coordinates))
+            return false;
+        row_ = static_cast<unsigned short int>(row + (coordinates.y - origin.y));
+        column_ = static_cast<unsigned short int>(column + (coordinates.x - origin.x));
+        return true;
+    }
+
+    void Viewport::setScrollAcceleration(bool accelerated_) {
+        accelerated = accelerated_;
+    }
+    bool Viewport::isScrollAccelerated() const {
+        return accelerated;
+    }
+
+    Coordinates Viewport::getOrigin() const {
+        return origin;
+    }
+    unsigned short int Viewport::getWidth() const {
+        return width;
+    }
+    unsigned short int Viewport::getHeight() const {
+        return height;
+    }
+};
@@ -0,0 +1,125 @@
+/** \file viewport.hpp
+ *  \brief Viewport class header file.
+ *
+ *  This file contains the declaration of the Viewport class, a camera showing a rectangular
+ *  window of a Field at a position of the terminal, for fields larger than the screen.
+ *
+ *  While a Viewport is attached to a Field, the incremental updates of the Field (movePawn,
+ *  rePrintPawn, applySwaps...) are translated to the screen position of the window, and the
+ *  ones outside of the window are not rendered at all.
+ *
+ *  \author FLAK-ZOSO
+ *  \date 2025
+ *  \version 3.0.0
+ *  \see Viewport
+ *  \see Field
+ *  \copyright GNU General Public License v3.0
+ */
+#pragma once
+
+#include "coordinates.hpp"
+#include "cursor.hpp"
+
+namespace sista {
+    class Field;
+
+    /** \class Viewport
+     *  \brief Renders a window of a Field at a screen position, and scrolls it.
+     *
+     *  The window is `width` columns by `height` rows of the Field, starting from its origin,
+     *  and it is drawn with its top-left cell at the given terminal row and column. The window
+     *  never extends past the Field: a window larger than the Field is reduced to the Field.
+     *
+     *  A Field renders through at most one Viewport, the last one constructed on it. The Viewport
+     *  must not outlive the Field, and detaches itself from the Field when destroyed.
+     *
+     *  \see Field
+    */
+    class Viewport {
+    private:
+        Field* field; /** The Field shown, not owned. */
+        Cursor cursor; /** Cursor object for terminal operations. */
+        Coordinates origin; /** Field coordinates of the top-left cell of the window. */
+        unsigned short int width; /** Columns of the window. */
+        unsigned short int height; /** Rows of the window. */
+        unsigned short int row; /** Terminal row of the top-left cell, starting from 1. */
+        unsigned short int column; /** Terminal column of the top-left cell, starting from 1. */
+        bool accelerated; /** Whether scrolling shifts the content on the screen instead of redrawing it. */
+
+        /** \brief Returns the origin moved so that the window lies inside the Field. */
+        Coordinates clampOrigin(Coordinates) const;
+        /** \brief Draws the cells of a row of the window, from column `from` to column `to` excluded. */
+        void printCells(unsigned short int, unsigned short int, unsigned short int) const;
+        /** \brief Shifts the content on the screen by the rows and columns the window moved, and draws the exposed edge. */
+        void shift(int, int) const;
+
+    public:
+        /** \brief Constructor attaching the viewport to a Field.
+         *  \param field The Field to show.
+         *  \param width Columns of the window.
+         *  \param height Rows of the window.
+         *  \param row Terminal row of the top-left cell, starting from 1.
+         *  \param column Terminal column of the top-left cell, starting from 1.
+         *
+         *  The window starts at the origin of the Field. Nothing is drawn until print().
+        */
+        Viewport(Field&, unsigned short int, unsigned short int, unsigned short int=1, unsigned short int=1);
+        /** \brief Destructor detaching the viewport from its Field. */
+        ~Viewport();
+
+        Viewport(const Viewport&) = delete;
+        Viewport& operator=(const Viewport&) = delete;
+
+        /** \brief Draws every cell of the window. */
+        void print() const;
+
+        /** \brief Moves the window and redraws it.
+         *  \param origin Field coordinates of the new top-left cell, clamped inside the Field.
+         *  \return `true` if the window moved.
+        */
+        bool scrollTo(const Coordinates&);
+        /** \brief Moves the window by an offset and redraws it.
+         *  \param dy Rows to scroll, negative to scroll up.
+         *  \param dx Columns to scroll, negative to scroll left.
+         *  \return `true` if the window moved.
+        */
+        bool scrollBy(short int, short int);
+        /** \brief Scrolls the window just enough to keep a cell inside it, away from its edges.
+         *  \param target The cell to keep visible, usually the player.
+         *  \param margin Cells to keep between the target and the edges of the window.
+         *  \return `true` if the window moved.
+        */
+        bool follow(const Coordinates&, unsigned short int=0);
+
+        /** \brief Sets whether scrolling reuses the content already on the screen.
+         *  \param accelerated If `true`, a scroll shifts the screen with SU/SD inside a DECSTBM
+         *  scroll region, or with ICH/DCH on each row, and draws only the exposed rows and columns.
+         *
+         *  Horizontal shifts leave the rest of the terminal untouched, but vertical shifts move whole
+         *  terminal rows: enable it only if nothing else is drawn on the rows of the window, on
+         *  either side of it. Disabled by default.
+        */
+        void setScrollAcceleration(bool);
+        /** \brief Returns whether scrolling reuses the content already on the screen. */
+        bool isScrollAccelerated() const;
+
+        /** \brief Checks whether a cell of the Field is inside the window.
+         *  \param coordinates The Field coordinates of the cell.
+        */
+        bool isVisible(const Coordinates&) const;
+        /** \brief Finds the terminal position of a cell of the Field.
+         *  \param coordinates The Field coordinates of the cell.
+         *  \param row_ Set to the terminal row of the cell, starting from 1.
+         *  \param column_ Set to the terminal column of the cell, starting from 1.
+         *  \return `false` if the cell is outside the window, leaving `row_` and `column_` unchanged.
+        */
+        bool toScreen(const Coordinates&, unsigned short int&, unsigned short int&) const;
+
+        /** \brief Returns the Field coordinates of the top-left cell of the window. */
+        Coordinates getOrigin() const;
+        /** \brief Returns the columns of the window. */
+        unsigned short int getWidth() const;
+        /** \brief Returns the rows of the window. */
+        unsigned short int getHeight() const;
+    };
+};
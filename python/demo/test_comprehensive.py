@@ -277,6 +277,25 @@ def test_version():
     except Exception as e:
         print(f"Error retrieving version: {e}")
 
+def test_stats():
+    """Test the render statistics"""
+    print("=== Testing Render Statistics ===")
+
+    sista.reset_stats()
+    field = sista.SwappableField(width=6, height=3)
+    settings = sista.create_ansi_settings(sista.F_GREEN, sista.B_BLACK, sista.A_BRIGHT)
+    pawn = field.create_pawn("S", settings, sista.create_coordinates(0, 0))
+    field.add_pawn_to_swap(pawn, sista.create_coordinates(0, 1))
+    field.apply_swaps()
+
+    stats = sista.get_stats()
+    print(f"Statistics: {stats}")
+    assert stats["swaps_accepted"] == 1, "apply_swaps should count one accepted move"
+    assert stats["cursor_jumps"] >= 2, "apply_swaps should move the cursor"
+    assert stats["cells_redrawn"] >= 2, "apply_swaps should redraw two cells"
+    sista.reset_stats()
+    assert sista.get_stats()["swaps_accepted"] == 0, "reset_stats should zero the counters"
+
 def main():
     """Run all tests"""
     print("Running comprehensive tests for sista Python C extension...")
@@ -294,6 +313,7 @@ def main():
         test_enum_exposure,
         test_cursor_functions,
         test_version,
+        test_stats,
     ]
 
     try:
@@ -44,6 +44,15 @@ DIRECTION_LEFT: int
 BEGINNING_OF_NEXT_LINE: int
 BEGINNING_OF_PREVIOUS_LINE: int
 
+E_PACMAN: int
+E_MATRIX: int
+E_CLAMP: int
+E_BOUNCE: int
+CONNECTIVITY_FOUR: int
+CONNECTIVITY_EIGHT: int
+PATH_ASTAR: int
+PATH_JUMP_POINT: int
+
 def set_foreground_color(color: int) -> None:
     """
     Set the terminal foreground color using one of the F_* constants.
@@ -178,6 +187,22 @@ class Field:
         :param border: Capsule for the Border to draw around the field.
         """
         ...
+    def find_path(self, from_y: int, from_x: int, to_y: int, to_x: int, connectivity: int = ..., effect: int = ...,
+                  search: int = ...) -> list[tuple[int, int]] | None:
+        """
+        Search a shortest path between two cells, through the free cells.
+
+        :param from_y: Row of the start cell, which may be occupied.
+        :param from_x: Column of the start cell.
+        :param to_y: Row of the goal cell, which may be occupied.
+        :param to_x: Column of the goal cell.
+        :param connectivity: CONNECTIVITY_FOUR (default) or CONNECTIVITY_EIGHT.
+        :param effect: E_PACMAN wraps the path around the edges, the other E_* constants (default E_CLAMP) don't.
+        :param search: PATH_ASTAR (default), or PATH_JUMP_POINT with CONNECTIVITY_EIGHT.
+        :return: The (y, x) cells from the one after the start to the goal, or None if there is no path.
+        :raises IndexError: If a cell is out of bounds.
+        """
+        ...
 
 class SwappableField:
     """
@@ -222,6 +247,22 @@ class SwappableField:
         :param border: Capsule for the Border to draw around the field.
         """
         ...
+    def find_path(self, from_y: int, from_x: int, to_y: int, to_x: int, connectivity: int = ..., effect: int = ...,
+                  search: int = ...) -> list[tuple[int, int]] | None:
+        """
+        Search a shortest path between two cells of this SwappableField, like Field.find_path.
+
+        :param from_y: Row of the start cell, which may be occupied.
+        :param from_x: Column of the start cell.
+        :param to_y: Row of the goal cell, which may be occupied.
+        :param to_x: Column of the goal cell.
+        :param connectivity: CONNECTIVITY_FOUR (default) or CONNECTIVITY_EIGHT.
+        :param effect: E_PACMAN wraps the path around the edges, the other E_* constants (default E_CLAMP) don't.
+        :param search: PATH_ASTAR (default), or PATH_JUMP_POINT with CONNECTIVITY_EIGHT.
+        :return: The (y, x) cells from the one after the start to the goal, or None if there is no path.
+        :raises IndexError: If a cell is out of bounds.
+        """
+        ...
     def add_pawn_to_swap(self, pawn: Pawn, coords: Capsule) -> None:
         """
         Schedule a pawn to be moved (swapped) later in this SwappableField.
@@ -269,6 +310,23 @@ def create_coordinates(y: int, x: int) -> Capsule:
     :return: Capsule wrapping a Coordinates struct.
     """
     ...
+
+def get_stats() -> dict[str, int]:
+    """
+    Return the render statistics of the process.
+
+    Keys: frames_presented, bytes_emitted, style_sequences, cursor_sequences,
+    erase_sequences, mode_sequences, cursor_jumps, cells_redrawn,
+    swaps_accepted, swaps_rejected, encode_ns, write_ns.
+
+    :return: A dict mapping each statistic to its value.
+    """
+    ...
+def reset_stats() -> None:
+    """
+    Set every render statistic to zero.
+    """
+    ...
 class Cursor:
     """
     Class representing a terminal cursor for movement operations.
@@ -35,6 +35,9 @@ py_sista_raise_from_status(int status_code, const char* fallback_message) {
         case SISTA_ERR_NULL_BORDER:
         case SISTA_ERR_NULL_CURSOR:
         case SISTA_ERR_NULL_COLOR:
+        case SISTA_ERR_NULL_STATS:
+        case SISTA_ERR_NULL_ARENA:
+        case SISTA_ERR_NULL_PATH:
             exc_type = PyExc_ValueError;
             break;
         case SISTA_ERR_OUT_OF_BOUNDS:
@@ -192,6 +195,21 @@ PyDoc_STRVAR(py_Field_print_with_border_doc,
 "- `border` (Capsule): Capsule for the Border to draw around the field.\n"
 );
 
+PyDoc_STRVAR(py_Field_find_path_doc,
+"find_path(self, from_y: int, from_x: int, to_y: int, to_x: int, connectivity=CONNECTIVITY_FOUR, effect=E_CLAMP, search=PATH_ASTAR) -> list[tuple[int, int]] | None\n\n"
+"Search a shortest path between two cells, through the free cells.\n\n"
+"### Parameters\n\n"
+"- `from_y`, `from_x` (int): Start cell, which may be occupied.\n"
+"- `to_y`, `to_x` (int): Goal cell, which may be occupied.\n"
+"- `connectivity` (int): `CONNECTIVITY_FOUR` or `CONNECTIVITY_EIGHT`.\n"
+"- `effect` (int): `E_PACMAN` wraps the path around the edges, the other `E_*` constants don't.\n"
+"- `search` (int): `PATH_ASTAR`, or `PATH_JUMP_POINT` with `CONNECTIVITY_EIGHT`.\n\n"
+"### Returns\n\n"
+"- The `(y, x)` cells of the path, from the one after the start to the goal, or `None` if there is no path.\n\n"
+"### Raises\n\n"
+"- `IndexError`: a cell is out of bounds.\n"
+);
+
 PyDoc_STRVAR(py_SwappableField_create_pawn_doc,
 "create_pawn(self, symbol: str, ansi_settings: Capsule, coords: Capsule) -> Pawn\n\n"
 "Create a Pawn inside this SwappableField and return a Pawn object.\n\n"
@@ -228,6 +246,11 @@ PyDoc_STRVAR(py_SwappableField_print_with_border_doc,
 "- `border` (Capsule): Capsule for the Border to draw around the field.\n"
 );
 
+PyDoc_STRVAR(py_SwappableField_find_path_doc,
+"find_path(self, from_y: int, from_x: int, to_y: int, to_x: int, connectivity=CONNECTIVITY_FOUR, effect=E_CLAMP, search=PATH_ASTAR) -> list[tuple[int, int]] | None\n\n"
+"Search a shortest path between two cells of this SwappableField, like `Field.find_path`.\n"
+);
+
 PyDoc_STRVAR(py_Cursor_go_to_doc,
 "Move the cursor to the absolute `(y, x)` position.\n\n"
 "### Parameters\n\n"
@@ -477,6 +500,56 @@ py_sista_destroy_border_capsule_destructor(PyObject* capsule) {
     }
 }
 
+PyDoc_STRVAR(py_sista_get_stats_doc,
+"Return the render statistics of the process as a dict.\n\n"
+"```py\n"
+"get_stats() -> dict[str, int]\n"
+"```\n\n"
+"### Keys\n\n"
+"- `frames_presented`, `bytes_emitted`: frames and bytes delivered by the output sinks.\n"
+"- `style_sequences`, `cursor_sequences`, `erase_sequences`, `mode_sequences`: escape sequences by kind.\n"
+"- `cursor_jumps`, `cells_redrawn`: absolute cursor movements and field cells printed.\n"
+"- `swaps_accepted`, `swaps_rejected`: moves applied or discarded by `SwappableField.apply_swaps`.\n"
+"- `encode_ns`, `write_ns`: time spent printing fields and writing frames, in nanoseconds.\n"
+);
+
+PyDoc_STRVAR(py_sista_reset_stats_doc,
+"Set every render statistic to zero.\n"
+);
+
+/** \brief Returns the render statistics as a dict.
+ */
+static PyObject*
+py_sista_get_stats(PyObject* self, PyObject* Py_UNUSED(ignored)) {
+    struct sista_Stats stats;
+    if (py_sista_raise_from_status(sista_getStats(&stats), "Failed to read the statistics") < 0) {
+        return NULL;
+    }
+    return Py_BuildValue(
+        "{s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K}",
+        "frames_presented", stats.framesPresented,
+        "bytes_emitted", stats.bytesEmitted,
+        "style_sequences", stats.styleSequences,
+        "cursor_sequences", stats.cursorSequences,
+        "erase_sequences", stats.eraseSequences,
+        "mode_sequences", stats.modeSequences,
+        "cursor_jumps", stats.cursorJumps,
+        "cells_redrawn", stats.cellsRedrawn,
+        "swaps_accepted", stats.swapsAccepted,
+        "swaps_rejected", stats.swapsRejected,
+        "encode_ns", stats.encodeNanoseconds,
+        "write_ns", stats.writeNanoseconds
+    );
+}
+
+/** \brief Resets the render statistics.
+ */
+static PyObject*
+py_sista_reset_stats(PyObject* self, PyObject* Py_UNUSED(ignored)) {
+    sista_resetStats();
+    Py_RETURN_NONE;
+}
+
 static void
 py_sista_destroy_coordinates_capsule_destructor(PyObject*);
 
@@ -870,6 +943,92 @@ SwappableField_apply_swaps(PyObject *self, PyObject *Py_UNUSED(ignored))
     Py_RETURN_NONE;
 }
 
+/** \brief Searches a path on a Field or a SwappableField, for their `find_path` methods.
+ *  \param field The Field, or NULL to search `swappable`.
+ *  \param swappable The SwappableField, used if `field` is NULL.
+ *  \return A list of `(y, x)` tuples, `None` if there is no path, or NULL with an exception set.
+ */
+static PyObject*
+py_sista_find_path(FieldHandler_t field, SwappableFieldHandler_t swappable, PyObject *args, PyObject *kwds)
+{
+    static char *keywords[] = {"from_y", "from_x", "to_y", "to_x", "connectivity", "effect", "search", NULL};
+    Py_ssize_t from_y, from_x, to_y, to_x;
+    int connectivity = CONNECTIVITY_FOUR, effect = E_CLAMP, search = PATH_ASTAR;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "nnnn|iii", keywords, &from_y, &from_x, &to_y, &to_x,
+                                     &connectivity, &effect, &search)) {
+        return NULL;
+    }
+    if (from_y < 0 || from_x < 0 || to_y < 0 || to_x < 0
+        || from_y > 65535 || from_x > 65535 || to_y > 65535 || to_x > 65535) {
+        PyErr_SetString(PyExc_IndexError, "path coordinates are out of bounds");
+        return NULL;
+    }
+    if (connectivity != CONNECTIVITY_FOUR && connectivity != CONNECTIVITY_EIGHT) {
+        PyErr_SetString(PyExc_ValueError, "connectivity must be CONNECTIVITY_FOUR or CONNECTIVITY_EIGHT");
+        return NULL;
+    }
+    if (effect < E_PACMAN || effect > E_BOUNCE || (search != PATH_ASTAR && search != PATH_JUMP_POINT)) {
+        PyErr_SetString(PyExc_ValueError, "effect must be an E_* constant and search a PATH_* constant");
+        return NULL;
+    }
+
+    struct sista_Coordinates from = {.y = (unsigned short)from_y, .x = (unsigned short)from_x};
+    struct sista_Coordinates to = {.y = (unsigned short)to_y, .x = (unsigned short)to_x};
+    size_t capacity = 64, length = 0;
+    struct sista_Coordinates *path = PyMem_New(struct sista_Coordinates, capacity);
+    int status;
+    for (;;) { /* Searched again only if the path doesn't fit */
+        if (path == NULL) {
+            return PyErr_NoMemory();
+        }
+        if (field != NULL) {
+            status = sista_findPath(field, from, to, (enum sista_Connectivity)connectivity, (enum sista_Effect)effect,
+                                    (enum sista_PathSearch)search, path, capacity, &length);
+        } else {
+            status = sista_findSwappableFieldPath(swappable, from, to, (enum sista_Connectivity)connectivity, (enum sista_Effect)effect,
+                                                  (enum sista_PathSearch)search, path, capacity, &length);
+        }
+        if (status != SISTA_OK || length <= capacity) {
+            break;
+        }
+        PyMem_Free(path);
+        capacity = length;
+        path = PyMem_New(struct sista_Coordinates, capacity);
+    }
+    if (status == SISTA_ERR_NO_PATH) {
+        PyMem_Free(path);
+        Py_RETURN_NONE;
+    }
+    if (py_sista_raise_from_status(status, "Failed to find a path") < 0) {
+        PyMem_Free(path);
+        return NULL;
+    }
+
+    PyObject *cells = PyList_New((Py_ssize_t)length);
+    for (size_t i = 0; cells != NULL && i < length; i++) {
+        PyObject *cell = Py_BuildValue("(HH)", path[i].y, path[i].x);
+        if (cell == NULL) {
+            Py_CLEAR(cells);
+            break;
+        }
+        PyList_SET_ITEM(cells, (Py_ssize_t)i, cell);
+    }
+    PyMem_Free(path);
+    return cells;
+}
+
+/* SwappableField.find_path(self, from_y, from_x, to_y, to_x, connectivity, effect, search) */
+static PyObject*
+SwappableField_find_path(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    SwappableFieldHandler_t field = ((SwappableFieldObject*)self)->field;
+    if (field == NULL) {
+        PyErr_SetString(PyExc_ValueError, "SwappableField object already destroyed");
+        return NULL;
+    }
+    return py_sista_find_path(NULL, field, args, kwds);
+}
+
 /* SwappableField.print_with_border(self, border_capsule) */
 static PyObject*
 SwappableField_print_with_border(PyObject *self, PyObject *args)
@@ -907,6 +1066,7 @@ static PyMethodDef SwappableField_methods[] = {
     {"add_pawn_to_swap", (PyCFunction)SwappableField_add_pawn_to_swap, METH_VARARGS, py_SwappableField_add_pawn_to_swap_doc},
     {"apply_swaps", (PyCFunction)SwappableField_apply_swaps, METH_NOARGS, py_SwappableField_apply_swaps_doc},
     {"print_with_border", (PyCFunction)SwappableField_print_with_border, METH_VARARGS, py_SwappableField_print_with_border_doc},
+    {"find_path", (PyCFunction)(void(*)(void))SwappableField_find_path, METH_VARARGS | METH_KEYWORDS, py_SwappableField_find_path_doc},
     {NULL, NULL, 0, NULL}
 };
 
@@ -1058,6 +1218,18 @@ Field_move_pawn(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* Field.find_path(self, from_y, from_x, to_y, to_x, connectivity, effect, search) */
+static PyObject*
+Field_find_path(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    FieldHandler_t field = ((FieldObject*)self)->field;
+    if (field == NULL) {
+        PyErr_SetString(PyExc_ValueError, "Field object already destroyed");
+        return NULL;
+    }
+    return py_sista_find_path(field, NULL, args, kwds);
+}
+
 /* Field.print_with_border(self, border_capsule) */
 static PyObject*
 Field_print_with_border(PyObject *self, PyObject *args)
@@ -1094,6 +1266,7 @@ static PyMethodDef Field_methods[] = {
     {"create_pawn", (PyCFunction)Field_create_pawn, METH_VARARGS, py_Field_create_pawn_doc},
     {"move_pawn", (PyCFunction)Field_move_pawn, METH_VARARGS, py_Field_move_pawn_doc},
     {"print_with_border", (PyCFunction)Field_print_with_border, METH_VARARGS, py_Field_print_with_border_doc},
+    {"find_path", (PyCFunction)(void(*)(void))Field_find_path, METH_VARARGS | METH_KEYWORDS, py_Field_find_path_doc},
     {NULL, NULL, 0, NULL}
 };
 
@@ -1194,6 +1367,15 @@ sista_module_exec(PyObject* module)
     PyModule_AddIntConstant(module, "BEGINNING_OF_NEXT_LINE", BEGINNING_OF_NEXT_LINE);
     PyModule_AddIntConstant(module, "BEGINNING_OF_PREVIOUS_LINE", BEGINNING_OF_PREVIOUS_LINE);
 
+    PyModule_AddIntConstant(module, "E_PACMAN", E_PACMAN);
+    PyModule_AddIntConstant(module, "E_MATRIX", E_MATRIX);
+    PyModule_AddIntConstant(module, "E_CLAMP", E_CLAMP);
+    PyModule_AddIntConstant(module, "E_BOUNCE", E_BOUNCE);
+    PyModule_AddIntConstant(module, "CONNECTIVITY_FOUR", CONNECTIVITY_FOUR);
+    PyModule_AddIntConstant(module, "CONNECTIVITY_EIGHT", CONNECTIVITY_EIGHT);
+    PyModule_AddIntConstant(module, "PATH_ASTAR", PATH_ASTAR);
+    PyModule_AddIntConstant(module, "PATH_JUMP_POINT", PATH_JUMP_POINT);
+
     if (PyType_Ready(&PawnType) < 0) return -1;
     Py_INCREF(&PawnType);
     if (PyModule_AddObject(module, "Pawn", (PyObject*)&PawnType) < 0) {
@@ -1260,6 +1442,11 @@ static PyMethodDef sista_module_methods[] = {
     {"create_coordinates", (PyCFunction)py_sista_create_coordinates, METH_VARARGS,
      py_sista_create_coordinates_doc},
 
+    {"get_stats", (PyCFunction)py_sista_get_stats, METH_NOARGS,
+     py_sista_get_stats_doc},
+    {"reset_stats", (PyCFunction)py_sista_reset_stats, METH_NOARGS,
+     py_sista_reset_stats_doc},
+
     {NULL, NULL, 0, NULL}  // Sentinel
 };
 